@@ -10,6 +10,7 @@
 
 
 #include <pyclustering/cluster/bsas_data.hpp>
+#include <pyclustering/cluster/representative_matrix.hpp>
 
 #include <pyclustering/utils/metric.hpp>
 
@@ -101,6 +102,8 @@ protected:
 
     distance_metric<point>          m_metric;   /**< Metric for distance calculation between points. */
 
+    representative_matrix   m_representatives;  /**< Representatives of clusters that are used during processing, they are copied to the result at the end. */
+
 public:
     /*!
 
@@ -154,6 +157,32 @@ protected:
 
     */
     void update_representative(const std::size_t p_index, const point & p_point);
+
+    /*!
+
+    @brief    Creates the first cluster and storage of representatives for the specified data.
+
+    @param[in] p_data: input data for cluster analysis.
+
+    */
+    void initialize(const dataset & p_data);
+
+    /*!
+
+    @brief    Adds new cluster that consists of the specified point.
+
+    @param[in] p_index_point: index of point in the input data.
+    @param[in] p_point: point that becomes representative of the cluster.
+
+    */
+    void allocate_cluster(const std::size_t p_index_point, const point & p_point);
+
+    /*!
+
+    @brief    Copies representatives to the clustering result and releases the storage.
+
+    */
+    void finalize();
 };
 
 
@@ -0,0 +1,167 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+#include <pyclustering/cluster/bsas_data.hpp>
+#include <pyclustering/cluster/representative_matrix.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+
+using namespace pyclustering::utils::metric;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@brief    Binary state (checkpoint) of BSAS stream.
+
+*/
+using bsas_stream_state = std::vector<char>;
+
+
+/*!
+
+@class    bsas_stream bsas_stream.hpp pyclustering/cluster/bsas_stream.hpp
+
+@brief    Online (streaming) version of BSAS algorithm for unbounded input.
+@details  Points are processed one by one or by batches and label (index of cluster) of each point is returned
+           immediately. Only representatives of clusters and amount of points in each cluster are stored, so memory
+           usage does not depend on amount of processed points. Representatives are updated in line with size of
+           clusters:
+\f[
+\vec{m}_{C_{k}}^{new}=\frac{ \left ( n_{C_{k}^{new}} - 1 \right )\vec{m}_{C_{k}}^{old} + \vec{x} }{n_{C_{k}^{new}}}
+\f]
+
+State of the stream can be saved to a binary blob and restored later (for example, after restart of a service):
+@code
+    bsas_stream stream(amount_clusters, threshold);
+    for (const auto & p : incoming_points) {
+        const std::size_t label = stream.push(p);
+    }
+
+    bsas_stream_state state;
+    stream.save(state);
+
+    bsas_stream restored(amount_clusters, threshold);
+    restored.load(state);
+@endcode
+
+The blob contains parameters of the algorithm (except metric function, only its type is checked), representatives
+and sizes of clusters. Values are stored using byte order of the machine.
+
+*/
+class bsas_stream {
+private:
+    const static char           STATE_SIGNATURE[4];
+    const static std::uint32_t  STATE_VERSION;
+
+private:
+    std::size_t                 m_amount        = 0;
+    double                      m_threshold     = 0.0;
+    distance_metric<point>      m_metric;
+
+    representative_matrix       m_representatives;
+    std::vector<std::size_t>    m_sizes         = { };
+
+public:
+    /*!
+
+    @brief    Creates BSAS stream using specified parameters.
+
+    @param[in] p_amount: maximum amount of clusters that can be allocated.
+    @param[in] p_threshold: threshold of dissimilarity (maximum distance) between points.
+    @param[in] p_metric: metric for distance calculation between points.
+
+    */
+    bsas_stream(const std::size_t p_amount,
+                const double p_threshold,
+                const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean());
+
+public:
+    /*!
+
+    @brief    Processes the next point of the stream.
+
+    @param[in] p_point: point that should be clustered.
+
+    @return   Label (index of cluster) of the point.
+
+    */
+    std::size_t push(const point & p_point);
+
+    /*!
+
+    @brief    Processes points of the stream in the specified order.
+
+    @param[in]  p_points: points that should be clustered.
+    @param[out] p_labels: label (index of cluster) of each point.
+
+    */
+    void push_batch(const dataset & p_points, index_sequence & p_labels);
+
+    /*!
+
+    @brief    Returns amount of allocated clusters.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief    Returns amount of points in each cluster.
+
+    */
+    const std::vector<std::size_t> & cluster_sizes() const;
+
+    /*!
+
+    @brief    Returns representatives of allocated clusters.
+
+    @param[out] p_representatives: representatives of clusters.
+
+    */
+    void get_representatives(representative_sequence & p_representatives) const;
+
+    /*!
+
+    @brief    Saves state of the stream to the binary blob.
+
+    @param[out] p_state: binary blob where state is stored.
+
+    */
+    void save(bsas_stream_state & p_state) const;
+
+    /*!
+
+    @brief    Restores state of the stream from the binary blob.
+    @details  Exception `std::invalid_argument` is thrown if the blob is corrupted or it has been created by the stream
+               with another type of metric.
+
+    @param[in] p_state: binary blob that has been created by `save` method.
+
+    */
+    void load(const bsas_stream_state & p_state);
+
+private:
+    void update_representative(const std::size_t p_index, const point & p_point);
+};
+
+
+}
+
+}
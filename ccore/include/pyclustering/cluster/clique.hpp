@@ -10,6 +10,7 @@
 
 #include <pyclustering/cluster/clique_data.hpp>
 
+#include <cstdint>
 #include <list>
 #include <unordered_map>
 
@@ -70,6 +71,17 @@ public:
 };
 
 
+/*!
+
+@brief  Defines where CLIQUE algorithm searches for clusters.
+
+*/
+enum class clique_mode {
+    FULL_SPACE = 0,     /**< Clusters are searched in the grid of the full data space. */
+    SUBSPACES = 1,      /**< Dense units are searched bottom-up from 1-D subspaces (Apriori) and clusters are formed in each subspace where dense units are found. */
+};
+
+
 /*!
 
 @class      clique clique.hpp pyclustering/cluster/clique.hpp
@@ -160,8 +172,32 @@ Two clusters are allocated, but in this case some points in cluster-"circle" are
 because CLIQUE operates with blocks, not with points:
 @image html clique_clustering_with_noise.png "Fig. 2. Noise allocation by CLIQUE."
 
+In subspace search mode (`clique_mode::SUBSPACES`) dense units (blocks that contain more points than the threshold)
+are searched from 1-D subspaces up to k-D: candidate k-D units are formed by joining (k-1)-D dense units of the same
+prefix and each candidate whose (k-1)-D projection is not dense is pruned. Clusters (connected dense units) of each
+subspace are returned by `clique_data::subspace_clusters()`, they might overlap. `clique_data::clusters()` is a partition
+that is formed from clusters of subspaces with the maximum dimensionality: each point is assigned to the biggest of them
+that contains the point and the rest points are considered as noise:
+@code
+    clique_data result;
+    clique(intervals, threshold, clique_mode::SUBSPACES).process(data, result);
+
+    for (const auto & subspace_cluster : result.subspace_clusters()) {
+        // subspace_cluster.dimensions - columns that form subspace, subspace_cluster.points - cluster itself
+    }
+@endcode
+
+Each point is placed to its block in one pass over the data using integer coordinates of the block. When the grid
+consists of more than `MAXIMUM_DENSE_GRID_SIZE` blocks (for example, in case of data with many dimensions) then the grid
+is sparse: only blocks that contain points are created and returned by `clique_data::blocks()`, neighbors are searched
+only among them. Each block is identified by 64-bit number, therefore `intervals^dimensions` should not exceed
+2^64 blocks.
+
 */
 class clique {
+public:
+    const static std::size_t MAXIMUM_DENSE_GRID_SIZE;     /**< Maximum amount of blocks in the grid when all of them (including empty) are created. */
+
 private:
     struct data_info {
         point m_min_corner;
@@ -170,16 +206,30 @@ private:
     };
 
 private:
-    using block_map = std::unordered_map<std::string, clique_block *>;
+    using block_id  = std::uint64_t;
+    using block_map = std::unordered_map<block_id, std::size_t>;
+
+    using point_bitmap = std::vector<std::uint64_t>;
+
+    struct dense_unit {
+        std::vector<std::size_t>    m_dimensions;   /* sorted dimensions of the subspace */
+        std::vector<std::size_t>    m_intervals;    /* interval in each dimension of the subspace */
+        point_bitmap                m_points;       /* points that are located in the unit */
+    };
+
+    using dense_unit_sequence = std::vector<dense_unit>;
 
 private:
     std::size_t     m_intervals         = 0;
     std::size_t     m_density_threshold = 0;
+    clique_mode     m_mode              = clique_mode::FULL_SPACE;
 
     const dataset * m_data_ptr      = nullptr;
     clique_data *   m_result_ptr    = nullptr;
 
-    block_map       m_cells_map;
+    bool                    m_sparse    = false;
+    std::vector<block_id>   m_strides;      /* difference between identifiers of neighbor blocks for each dimension */
+    block_map               m_cells_map;    /* block position by its identifier (only for sparse grid) */
 
 public:
     /*!
@@ -188,9 +238,10 @@ public:
 
     @param[in] p_intervals: amount of intervals in each dimension that defines amount of CLIQUE blocks as \f[N_{ blocks } = intervals^{ dimensions }\f].
     @param[in] p_threshold: minimum number of points that should be contained by CLIQUE block to consider its points as non-outliers.
+    @param[in] p_mode: defines where clusters are searched - in the full data space or in its subspaces.
 
     */
-    clique(const std::size_t p_intervals, const std::size_t p_threshold);
+    clique(const std::size_t p_intervals, const std::size_t p_threshold, const clique_mode p_mode = clique_mode::FULL_SPACE);
 
 public:
     /*!
@@ -204,17 +255,41 @@ public:
     void process(const dataset & p_data, clique_data & p_result);
 
 private:
+    void process_subspaces();
+
+    void find_dense_units(const clique::data_info & p_info, dense_unit_sequence & p_units) const;
+
+    void generate_dense_units(const dense_unit_sequence & p_units, dense_unit_sequence & p_candidates) const;
+
+    void allocate_subspace_clusters(const dense_unit_sequence & p_units) const;
+
+    static std::size_t get_bitmap_size(const std::size_t p_amount_points);
+
+    static void set_bitmap_bit(point_bitmap & p_bitmap, const std::size_t p_index_point);
+
+    static std::vector<std::size_t> get_unit_key(const std::vector<std::size_t> & p_dimensions, const std::vector<std::size_t> & p_intervals, const std::size_t p_length);
+
     void create_grid();
 
+    block_id initialize_strides();
+
+    void calculate_block_ids(const clique::data_info & p_info, std::vector<block_id> & p_ids) const;
+
+    std::size_t get_interval(const double p_coordinate, const std::size_t p_dimension, const clique::data_info & p_info) const;
+
     void expand_cluster(clique_block & p_block);
 
     void get_neighbors(const clique_block & p_block, std::list<clique_block *> & p_neighbors) const;
 
+    clique_block * find_block(const block_id p_id) const;
+
+    block_id location_to_id(const clique_block_location & p_location) const;
+
+    clique_block_location id_to_location(const block_id p_id) const;
+
     void get_spatial_location(const clique_block_location & p_location, const clique::data_info & p_info, clique_spatial_block & p_block) const;
 
     void get_data_info(clique::data_info & p_info) const;
-
-    static std::string location_to_key(const clique_block_location & p_location);
 };
 
 }
@@ -202,6 +202,15 @@ public:
     */
     void capture_points(const dataset & p_data, std::vector<bool> & p_availability);
 
+    /*!
+
+    @brief  Adds point to the block without checking whether it is located in the block.
+
+    @param[in] p_index_point: index of point in the input data.
+
+    */
+    void add_point(const std::size_t p_index_point);
+
     /*!
     
     @brief  Forms list of logical location of each neighbor for this particular CLIQUE block.
@@ -26,6 +26,28 @@ namespace clst {
 using clique_block_sequence = std::vector<clique_block>;
 
 
+/*!
+
+@class   clique_subspace_cluster clique_data.hpp pyclustering/cluster/clique_data.hpp
+
+@brief   Cluster that is found by CLIQUE algorithm in a subspace of the data space.
+
+*/
+struct clique_subspace_cluster {
+public:
+    std::vector<std::size_t>    dimensions;     /**< Dimensions (columns of the data) that form the subspace, they are sorted in ascending order. */
+    cluster                     points;         /**< Indexes of points that belong to the cluster. */
+};
+
+
+/*!
+
+@brief  Sequence container where clusters that are found in subspaces are stored.
+
+*/
+using clique_subspace_cluster_sequence = std::vector<clique_subspace_cluster>;
+
+
 /*!
 
 @class  clique_data clique_data.hpp pyclustering/cluster/clique_data.hpp
@@ -37,6 +59,7 @@ class clique_data : public cluster_data {
 private:
     clique_block_sequence   m_blocks;
     clst::noise             m_noise;
+    clique_subspace_cluster_sequence    m_subspace_clusters;
 
 public:
     /*!
@@ -66,6 +89,20 @@ public:
 
     */
     clst::noise & noise() { return m_noise; }
+
+    /*!
+
+    @brief  Returns constant reference to clusters that are found in subspaces (only for subspace search mode).
+
+    */
+    const clique_subspace_cluster_sequence & subspace_clusters() const { return m_subspace_clusters; }
+
+    /*!
+
+    @brief  Returns reference to clusters that are found in subspaces (only for subspace search mode).
+
+    */
+    clique_subspace_cluster_sequence & subspace_clusters() { return m_subspace_clusters; }
 };
 
 
@@ -9,6 +9,8 @@
 #pragma once
 
 
+#include <algorithm>
+
 #include <pyclustering/cluster/elbow_data.hpp>
 #include <pyclustering/cluster/kmeans.hpp>
 #include <pyclustering/cluster/kmeans_plus_plus.hpp>
@@ -143,6 +145,16 @@ using argument 'initializer':
     elbow<random_center_initializer>(kmin, kmax).process(data, result);
 @endcode
 
+Initial centers might be calculated only once for K max and reused for each K as a prefix (K-Means++ and random
+initializers choose centers sequentially, therefore the first K centers for K max are the same as centers for K):
+@code
+    elbow<> elbow_instance = elbow<>(kmin, kmax, 1, 1000);
+    elbow_instance.set_shared_initialization(true);
+
+    elbow_data result;
+    elbow_instance.process(data, result);
+@endcode
+
 @image html elbow_example_simple_03.png "Elbows analysis with further K-Means clustering."
 
 Implementation based on paper @cite article::cluster::elbow::1.
@@ -157,10 +169,13 @@ private:
     std::size_t   m_kamount      = 0;
     long long     m_random_state = RANDOM_STATE_CURRENT_TIME;
 
+    bool          m_shared_initialization = false;
+
     std::vector<double> m_elbow  = { };
 
     const dataset * m_data       = nullptr;
     elbow_data    * m_result     = nullptr;      /* temporary pointer to output result   */
+    dataset       m_initial_centers = { };       /* temporary initial centers for K max  */
 
 public:
     /*!
@@ -256,14 +271,37 @@ public:
 
         m_result->get_wce().resize(m_kamount);
 
-        parallel_for(m_kmin, m_kmax + 1, m_kstep, [this](const std::size_t p_index){
-            calculate_wce(p_index);
+        if (m_shared_initialization) {
+            prepare_centers(m_kmax, *m_data, m_random_state, m_initial_centers);
+        }
+
+        /* K values are interleaved between threads to balance load, because bigger K requires more computations */
+        const std::size_t lanes = std::min(AMOUNT_THREADS + 1, m_kamount);
+        parallel_for(std::size_t(0), lanes, [this, lanes](const std::size_t p_lane) {
+            for (std::size_t index = p_lane; index < m_kamount; index += lanes) {
+                calculate_wce(m_kmin + index * m_kstep);
+            }
         });
 
+        m_initial_centers.clear();
+
         calculate_elbows();
         m_result->set_amount(find_optimal_kvalue());
     }
 
+    /*!
+
+    @brief    Defines whether initial centers should be calculated once for K max and reused for each K.
+    @details  K-Means++ and random center initializers calculate centers sequentially, therefore the first K centers
+               that are calculated for K max are the same as centers that are calculated for K.
+
+    @param[in] p_enable: if `true` then initial centers are calculated only once (by default is `false`).
+
+    */
+    void set_shared_initialization(const bool p_enable) {
+        m_shared_initialization = p_enable;
+    }
+
 private:
     template<class CenterInitializer = TypeInitializer>
     typename std::enable_if<std::is_same<CenterInitializer, kmeans_plus_plus>::value, void>::type
@@ -279,7 +317,12 @@ private:
 
     void calculate_wce(const std::size_t p_kvalue) {
         dataset initial_centers;
-        prepare_centers(p_kvalue, *m_data, m_random_state, initial_centers);
+        if (m_initial_centers.empty()) {
+            prepare_centers(p_kvalue, *m_data, m_random_state, initial_centers);
+        }
+        else {
+            initial_centers.assign(m_initial_centers.begin(), m_initial_centers.begin() + p_kvalue);
+        }
 
         kmeans_data result;
         kmeans instance(initial_centers, kmeans::DEFAULT_TOLERANCE);
@@ -107,6 +107,8 @@ private:
 
     double          m_degree                = 0.0;
 
+    bool            m_square_degree         = false;    /* degree is equal to 2.0 (hyper-parameter is 2.0) - 'pow' is not required */
+
     fcm_data        * m_ptr_result          = nullptr;      /* temporary pointer to output result */
 
     const dataset   * m_ptr_data            = nullptr;      /* used only during processing */
@@ -156,13 +158,18 @@ public:
 private:
     void verify() const;
 
-    double update_centers();
+    /*!
+
+    @brief    Updates membership of each point and centers of clusters during one pass over the data.
+    @details  Distances from a point to centers are calculated once and weighted sums of points for each center are
+               accumulated by each block of points separately and then merged.
 
-    double update_center(const std::size_t p_index);
+    @return   Maximum change of centers.
 
-    void update_membership();
+    */
+    double update_membership_and_centers();
 
-    void update_point_membership(const std::size_t p_index);
+    void update_point_membership(const std::size_t p_index, std::vector<double> & p_distances);
 
     void extract_clusters(cluster_sequence & p_clusters);
 };
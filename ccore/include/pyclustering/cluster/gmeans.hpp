@@ -101,6 +101,8 @@ public:
 
     const static std::size_t        DEFAULT_CANDIDATES;         /**< Default value of amount of candidates to consider by K-Means++ to initialize initial centers for K-Means on each iteration. */
 
+    const static std::size_t        MAXIMUM_TEST_SAMPLE;        /**< Maximum size of projection that is used by Anderson-Darling test, quantile sketch of this size is used for bigger clusters. */
+
 private:
     std::size_t             m_amount                = DEFAULT_AMOUNT_CENTERS;
 
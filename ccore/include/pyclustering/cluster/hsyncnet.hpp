@@ -14,6 +14,8 @@
 #include <pyclustering/definitions.hpp>
 #include <pyclustering/cluster/syncnet.hpp>
 
+#include <pyclustering/container/kdtree_balanced.hpp>
+
 
 namespace pyclustering {
 
@@ -35,15 +37,25 @@ typedef syncnet_analyser                    hsyncnet_analyser;
 
 */
 class hsyncnet: public syncnet {
+private:
+    using neighbor_description = std::pair<double, std::size_t>;    /* square distance to the neighbor and its index */
+
 private:
     std::size_t m_number_clusters;
     std::size_t m_initial_neighbors;
     double m_increase_persent;
     double m_time;
 
+    container::kdtree_balanced                          m_tree;
+    std::vector<std::vector<neighbor_description>>      m_neighbors;            /* neighbors of each oscillator sorted by distance */
+    std::vector<double>                                 m_neighbors_coverage;   /* all oscillators in this square distance are in the list of neighbors */
+    std::vector<std::size_t>                            m_neighbors_connected;  /* amount of the nearest neighbors that are already connected */
+
 private:
     const static double         DEFAULT_TIME_STEP;
     const static std::size_t    DEFAULT_INCREASE_STEP;
+    const static double         DEFAULT_SYNC_TOLERANCE;
+    const static double         NEIGHBORS_COVERAGE_FACTOR;
 
 public:
     /*!
@@ -99,7 +111,52 @@ public:
 private:
     void store_state(sync_network_state & state, hsyncnet_analyser & analyser);
 
-    double calculate_radius(const double radius, const std::size_t amount_neighbors) const;
+    double calculate_radius(const double radius, const std::size_t amount_neighbors);
+
+    /*!
+
+    @brief   Creates KD-tree, empty lists of neighbors and clusters where each oscillator is a cluster.
+
+    */
+    void initialize_neighbors();
+
+    /*!
+
+    @brief   Updates the sorted list of neighbors of the oscillator if it does not contain the specified amount of
+              the nearest neighbors or all neighbors in the specified square distance.
+
+    @param[in] p_index: index of the oscillator.
+    @param[in] p_amount_neighbors: amount of the nearest neighbors that should be in the list.
+    @param[in] p_radius_square: square distance where all neighbors should be in the list.
+
+    */
+    void update_neighbors(const std::size_t p_index, const std::size_t p_amount_neighbors, const double p_radius_square);
+
+    /*!
+
+    @brief   Finds square distances to the nearest neighbors of the oscillator in KD-tree.
+
+    @param[in] p_node: node of KD-tree from which search is performed.
+    @param[in] p_index: index of the oscillator.
+    @param[in] p_amount_neighbors: amount of the nearest neighbors.
+    @param[in,out] p_heap: max-heap of square distances to the nearest neighbors.
+
+    */
+    void find_nearest_distances(const container::kdnode::ptr & p_node, const std::size_t p_index, const std::size_t p_amount_neighbors, std::vector<double> & p_heap) const;
+
+    /*!
+
+    @brief   Calculates average distance to the specified amount of the nearest neighbors using sorted lists of neighbors.
+
+    */
+    double average_neighbor_distance(const std::size_t p_amount_neighbors);
+
+    /*!
+
+    @brief   Connects oscillators in line with the radius, only neighbors that were not connected on previous levels are appended.
+
+    */
+    void append_connections(const double p_radius);
 };
 
 
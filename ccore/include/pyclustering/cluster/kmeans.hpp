@@ -118,6 +118,17 @@ private:
 
     void assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_centers, index_sequence & p_clusters);
 
+    std::size_t find_nearest_center(const std::size_t p_index_point, const dataset & p_centers) const;
+
+    /*!
+
+    @brief    Returns buffer of the current thread that is used to store winners of a region (defined by indexes).
+    @details  The buffer is sized by the region instead of the whole data and it is reused between iterations
+               and between regions that are processed by the same thread.
+
+    */
+    static index_sequence & get_region_buffer();
+
     /*!
     
     @brief    Calculate new center for specified cluster.
@@ -132,7 +143,7 @@ private:
 
     /*!
     
-    @brief    Calculates total within-cluster errors that is based on distance metric.
+    @brief    Calculates total within-cluster errors and errors of each cluster that are based on distance metric.
     
     */
     void calculate_total_wce();
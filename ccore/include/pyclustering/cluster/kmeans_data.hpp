@@ -38,6 +38,8 @@ private:
 
     double        m_wce       = 0.0;
 
+    std::vector<double> m_cluster_wce                   = { };
+
     std::vector<dataset> m_evolution_centers            = { };
     std::vector<cluster_sequence> m_evolution_clusters  = { };
 
@@ -120,6 +122,20 @@ public:
     */
     const double & wce() const { return m_wce; }
 
+    /*!
+
+    @brief    Returns reference to within-cluster errors of each cluster.
+
+    */
+    std::vector<double> & cluster_wce() { return m_cluster_wce; }
+
+    /*!
+
+    @brief    Returns constant reference to within-cluster errors of each cluster.
+
+    */
+    const std::vector<double> & cluster_wce() const { return m_cluster_wce; }
+
     /*!
     
     @brief    Returns reference to evolution of centers.
@@ -78,6 +78,7 @@ private:
 
     mutable index_set       m_free_indexes;
     mutable index_sequence  m_allocated_indexes;
+    mutable std::vector<double> m_shortest_distances;
 
 public:
     /**
@@ -246,21 +247,14 @@ private:
     /**
     *
     * @brief    Calculates distances from each point to closest center.
+    * @details  The shortest distances are updated incrementally using only the last allocated center,
+    *            thus initialization of K centers requires K passes over the data instead of K * K / 2.
     *
     * @param[out] p_distances: the shortest distances from each point to center.
     *
     */
     void calculate_shortest_distances(std::vector<double> & p_distances) const;
 
-    /**
-    *
-    * @brief    Calculates distance from the specified point to the closest center.
-    *
-    * @param[in]  p_point: point for that the shortest distance is calculated.
-    *
-    */
-    double get_shortest_distance(const point & p_point) const;
-
     /**
     *
     * @brief    Calculates center probability for each point using distances to closest centers.
@@ -52,6 +52,8 @@ private:
 
     distance_metric<point>  m_metric;
 
+    index_sequence          m_labels            = { };       /* cluster label of each point, reused between iterations */
+
 public:
     /**
     *
@@ -108,34 +110,48 @@ private:
 
     /**
     *
-    * @brief    Assign point to cluster by marking corresponding index in container 'p_lables'.
+    * @brief    Finds the nearest median to the specified point.
     *
-    * @param[in] p_index_point: index of point that should be assigned to cluster.
+    * @param[in] p_index_point: index of point for that the nearest median should be found.
     * @param[in] p_medians: medians that corresponds to clusters.
-    * @param[out] p_lables: cluster labels for each point (cluster labels has the same size as an input data).
+    *
+    * @return   Index of the nearest median.
     *
     */
-    void assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_medians, index_sequence & p_lables);
+    std::size_t find_nearest_median(const std::size_t p_index_point, const dataset & p_medians) const;
 
     /**
     *
     * @brief    Updates medians in line with current clusters.
     *
-    * @param[in,out] clusters: clusters that are sorted and used for updating medians.
+    * @param[in] clusters: clusters that are used for updating medians.
     * @param[out] medians: updated medians in line with the specified clusters.
     *
+    * @return   Maximum change of medians.
+    *
     */
     double update_medians(cluster_sequence & clusters, dataset & medians);
 
     /**
     *
-    * @brief    Calculate median for particular cluster.
+    * @brief    Calculates median of the specified cluster for one dimension.
+    * @details  Coordinates are gathered into the buffer of the current thread and the median is selected without
+    *            sorting (by 'std::nth_element').
+    *
+    * @param[in] p_cluster: cluster whose median is calculated.
+    * @param[in] p_dimension: dimension (coordinate) of the median that should be calculated.
+    *
+    * @return   Median coordinate of the cluster.
+    *
+    */
+    double calculate_median(const cluster & p_cluster, const std::size_t p_dimension) const;
+
+    /**
     *
-    * @param[in,out] current_cluster: cluster that is sorted and used for updating medians.
-    * @param[out] median: calculate median for particular cluster.
+    * @brief    Returns buffer of the current thread that is used to gather coordinates of a cluster.
     *
     */
-    void calculate_median(cluster & current_cluster, point & median);
+    static std::vector<double> & get_coordinate_buffer();
 
     /**
     *
@@ -34,6 +34,9 @@ namespace clst {
 
 */
 class mbsas : public bsas {
+private:
+    bool m_parallel_assignment = false;
+
 public:
     /*!
 
@@ -65,6 +68,19 @@ public:
     
     */
     void process(const dataset & p_data, mbsas_data & p_result);
+
+    /*!
+
+    @brief    Enables parallel assignment of points that have not formed clusters during the first pass.
+    @details  In this mode the nearest cluster for each such point is searched in parallel using representatives
+               that are obtained after the first pass. After that points are appended to clusters and representatives
+               are updated in the order of points. By default (sequential mode) each representative is updated before
+               processing of the next point, so the results of modes might be slightly different.
+
+    @param[in] p_enable: if `true` then points are assigned in parallel.
+
+    */
+    void set_parallel_assignment(const bool p_enable);
 };
 
 
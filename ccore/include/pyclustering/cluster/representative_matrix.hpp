@@ -0,0 +1,157 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#pragma once
+
+
+#include <vector>
+
+#include <pyclustering/cluster/bsas_data.hpp>
+
+#include <pyclustering/utils/metric.hpp>
+
+
+using namespace pyclustering::utils::metric;
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+/*!
+
+@class    representative_matrix representative_matrix.hpp pyclustering/cluster/representative_matrix.hpp
+
+@brief    Contiguous storage of cluster representatives that is used by sequential algorithms (BSAS family).
+@details  Coordinates are stored dimension by dimension (structure of arrays), so distances from a point to all
+           representatives are calculated by simple loops over contiguous memory that are vectorized by compiler.
+           Such bulk calculation is used for Euclidean, square Euclidean, Manhattan and Chebyshev metrics, other
+           metrics are calculated by the metric function. The storage grows in place (capacity is doubled).
+
+*/
+class representative_matrix {
+private:
+    std::size_t             m_dimension     = 0;
+    std::size_t             m_size          = 0;
+    std::size_t             m_capacity      = 0;
+    std::vector<double>     m_coordinates   = { };    /* coordinate 'd' of representative 'k' is located by index 'd * m_capacity + k' */
+
+    distance_metric<point>  m_metric;
+
+public:
+    /*!
+
+    @brief    Default constructor of the storage.
+
+    */
+    representative_matrix() = default;
+
+    /*!
+
+    @brief    Creates empty storage of representatives.
+
+    @param[in] p_dimension: dimension of representatives.
+    @param[in] p_metric: metric for distance calculation between points and representatives.
+
+    */
+    representative_matrix(const std::size_t p_dimension, const distance_metric<point> & p_metric);
+
+public:
+    /*!
+
+    @brief    Returns amount of representatives.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief    Returns dimension of representatives.
+
+    */
+    std::size_t dimension() const;
+
+    /*!
+
+    @brief    Returns `true` if there are no representatives.
+
+    */
+    bool empty() const;
+
+    /*!
+
+    @brief    Adds new representative to the end of the storage.
+
+    @param[in] p_representative: new representative.
+
+    */
+    void append(const point & p_representative);
+
+    /*!
+
+    @brief    Returns coordinate of the specified representative.
+
+    @param[in] p_index: index of representative.
+    @param[in] p_dimension: index of dimension.
+
+    */
+    double & at(const std::size_t p_index, const std::size_t p_dimension);
+
+    /*!
+
+    @brief    Returns constant coordinate of the specified representative.
+
+    @param[in] p_index: index of representative.
+    @param[in] p_dimension: index of dimension.
+
+    */
+    double at(const std::size_t p_index, const std::size_t p_dimension) const;
+
+    /*!
+
+    @brief    Copies the specified representative to the point.
+
+    @param[in] p_index: index of representative.
+    @param[out] p_representative: coordinates of representative.
+
+    */
+    void get(const std::size_t p_index, point & p_representative) const;
+
+    /*!
+
+    @brief    Finds the nearest representative to the specified point.
+    @details  This method can be called from several threads simultaneously.
+
+    @param[in] p_point: point for which the nearest representative is searched.
+    @param[out] p_distance: distance between the point and the nearest representative.
+
+    @return   Index of the nearest representative or `(std::size_t) -1` if the storage is empty.
+
+    */
+    std::size_t find_nearest(const point & p_point, double & p_distance) const;
+
+    /*!
+
+    @brief    Copies representatives to the sequence of points.
+
+    @param[out] p_representatives: representatives that are stored as points.
+
+    */
+    void extract(representative_sequence & p_representatives) const;
+
+private:
+    void reserve(const std::size_t p_capacity);
+
+    void calculate_distances(const point & p_point, std::vector<double> & p_distances) const;
+};
+
+
+}
+
+}
@@ -71,6 +71,51 @@ public:
 
     */
     virtual void allocate(const std::size_t p_amount, const dataset & p_data, const long long p_random_state, cluster_sequence & p_clusters) = 0;
+
+    /*!
+
+    @brief Performs cluster analysis using clusters that have been allocated for smaller amount of clusters as a starting point.
+    @details The worst cluster (with the biggest within-cluster error) of the previous result is split into two parts to
+              obtain required amount of initial clusters. Default implementation ignores previous result and performs
+              cluster analysis from scratch.
+
+    @param[in]  p_amount: amount of clusters that should be allocated.
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_previous: clusters that have been allocated for smaller amount of clusters.
+    @param[in]  p_random_state: seed for random state (value `RANDOM_STATE_CURRENT_TIME` means the current system time is going to used as a seed).
+    @param[out] p_clusters: container where result (allocated clusters) is placed.
+
+    */
+    virtual void allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters);
+
+protected:
+    /*!
+
+    @brief Calculates initial centers using previous clusters where the worst cluster is split into two parts.
+
+    @param[in]  p_amount: amount of centers that should be calculated.
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_previous: clusters that have been allocated for smaller amount of clusters.
+    @param[out] p_centers: initial centers (the last one is the farthest point of the worst cluster).
+
+    @return `true` if initial centers have been calculated, otherwise `false` (previous result does not fit the amount).
+
+    */
+    static bool split_worst_cluster(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, dataset & p_centers);
+
+    /*!
+
+    @brief Calculates initial medoids using previous clusters where the worst cluster is split into two parts.
+
+    @param[in]  p_amount: amount of medoids that should be calculated.
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_previous: clusters that have been allocated for smaller amount of clusters.
+    @param[out] p_medoids: initial medoids (the last one is the farthest point of the worst cluster).
+
+    @return `true` if initial medoids have been calculated, otherwise `false` (previous result does not fit the amount).
+
+    */
+    static bool split_worst_cluster(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, index_sequence & p_medoids);
 };
 
 
@@ -105,6 +150,19 @@ public:
 
     */
     virtual void allocate(const std::size_t p_amount, const dataset & p_data, const long long p_random_state, cluster_sequence & p_clusters) override;
+
+    /*!
+
+    @brief Performs cluster analysis using K-Means algorithm where previous clusters are used as a starting point.
+
+    @param[in]  p_amount: amount of clusters that should be allocated.
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_previous: clusters that have been allocated for smaller amount of clusters.
+    @param[in]  p_random_state: seed for random state that is used if previous clusters cannot be used.
+    @param[out] p_clusters: container where result (allocated clusters) is placed.
+
+    */
+    virtual void allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) override;
 };
 
 
@@ -139,6 +197,19 @@ public:
 
     */
     virtual void allocate(const std::size_t p_amount, const dataset & p_data, const long long p_random_state, cluster_sequence & p_clusters) override;
+
+    /*!
+
+    @brief Performs cluster analysis using K-Medians algorithm where previous clusters are used as a starting point.
+
+    @param[in]  p_amount: amount of clusters that should be allocated.
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_previous: clusters that have been allocated for smaller amount of clusters.
+    @param[in]  p_random_state: seed for random state that is used if previous clusters cannot be used.
+    @param[out] p_clusters: container where result (allocated clusters) is placed.
+
+    */
+    virtual void allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) override;
 };
 
 
@@ -173,6 +244,19 @@ public:
 
     */
     virtual void allocate(const std::size_t p_amount, const dataset & p_data, const long long p_random_state, cluster_sequence & p_clusters) override;
+
+    /*!
+
+    @brief Performs cluster analysis using K-Medoids algorithm where previous clusters are used as a starting point.
+
+    @param[in]  p_amount: amount of clusters that should be allocated.
+    @param[in]  p_data: input data for cluster analysis.
+    @param[in]  p_previous: clusters that have been allocated for smaller amount of clusters.
+    @param[in]  p_random_state: seed for random state that is used if previous clusters cannot be used.
+    @param[out] p_clusters: container where result (allocated clusters) is placed.
+
+    */
+    virtual void allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) override;
 };
 
 
@@ -182,6 +266,14 @@ public:
 @class    silhouette_ksearch silhouette_ksearch.hpp pyclustering/cluster/silhouette_ksearch.hpp
 
 @brief    Defines algorithms that is used to find optimal number of cluster using Silhouette method.
+@details  K values are processed in parallel by default, nested parallel loops of allocators are executed by the same
+           threads. Following options might be used to reduce amount of computations:
+           1. Warm start (`set_warm_start`) - clustering for K + 1 is initialized by clustering for K where the worst
+              cluster is split, in this case K values are processed sequentially.
+           2. Distance cache (`set_distance_cache`) - distance matrix is calculated once and shared by all K values,
+              requires memory for N * N values where N is amount of points.
+           3. Early stop (`set_early_stop`) - analysis is stopped when the score has not been improved for specified
+              amount of K values after the best one, scores are provided only for processed K values in this case.
 
 */
 class silhouette_ksearch {
@@ -191,6 +283,12 @@ private:
     silhouette_ksearch_allocator::ptr m_allocator = std::make_shared<kmeans_allocator>();
     long long m_random_state;
 
+    bool        m_warm_start        = false;
+    bool        m_distance_cache    = false;
+    std::size_t m_patience          = 0;
+
+    dataset     m_distances         = { };      /* temporary distance matrix, exists during processing */
+
 public:
     /*!
 
@@ -242,6 +340,44 @@ public:
 
     */
     void process(const dataset & p_data, silhouette_ksearch_data & p_result);
+
+    /*!
+
+    @brief    Enables or disables warm start where clustering for K + 1 is initialized by clustering for K.
+
+    @param[in] p_enable: if `true` then warm start is used (by default is `false`).
+
+    */
+    void set_warm_start(const bool p_enable);
+
+    /*!
+
+    @brief    Enables or disables distance matrix that is calculated once and shared by all K values.
+
+    @param[in] p_enable: if `true` then distance matrix is used (by default is `false`).
+
+    */
+    void set_distance_cache(const bool p_enable);
+
+    /*!
+
+    @brief    Defines amount of K values without improvement after the best one when analysis is stopped.
+
+    @param[in] p_patience: amount of K values without improvement, `0` means that early stop is not used (by default is `0`).
+
+    */
+    void set_early_stop(const std::size_t p_patience);
+
+private:
+    double calculate_score(const dataset & p_data, const cluster_sequence & p_clusters, const std::size_t p_amount) const;
+
+    void calculate_distances(const dataset & p_data);
+
+    void process_sequentially(const dataset & p_data, silhouette_score_sequence & p_scores) const;
+
+    void process_parallel(const dataset & p_data, silhouette_score_sequence & p_scores) const;
+
+    bool is_peak_passed(const silhouette_score_sequence & p_scores) const;
 };
 
 }
@@ -77,7 +77,10 @@ public:
 class syncnet: public sync_network {
 protected:
     std::vector<std::vector<double> >    * oscillator_locations;    /**< Spatial location of each oscillator. */
-    std::vector<std::vector<double> >    * distance_conn_weights;   /**< Weight of each connection in the network. */
+
+    std::vector<std::size_t>    m_conn_offsets;     /**< Connections in CSR representation: neighbors of oscillator 'i' are in range [m_conn_offsets[i], m_conn_offsets[i + 1]). */
+    std::vector<std::size_t>    m_conn_indexes;     /**< Indexes of neighbors of each oscillator in ascending order. */
+    std::vector<double>         m_conn_weights;     /**< Weight of each connection in the network (empty if weights are not used). */
 
 public:
     /*!
@@ -137,6 +140,15 @@ public:
 
     virtual void phase_kuramoto_equation(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) const override;
 
+    /*!
+    
+    @brief   Calculates level of local (partial) synchronization in the network using CSR representation of connections.
+    
+    @return  Return level of local (partial) synchronization in the network.
+    
+    */
+    virtual double sync_local_order() const override;
+
 public:
     /*!
     
@@ -151,7 +163,8 @@ protected:
     /*!
     
     @brief   Create connections between oscillators in line with input radius of connectivity.
-    
+    @details Neighbors of each oscillator are found by radius search in KD-tree in parallel, connections are
+              stored in CSR representation, so only real neighbors are considered during simulation.
     
     @param[in] connectivity_radius: connectivity radius between oscillators.
     @param[in] enable_conn_weight: if True - enable mode when strength between oscillators 
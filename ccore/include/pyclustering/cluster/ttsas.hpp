@@ -80,6 +80,8 @@ private:
     std::vector<bool>   m_skipped_objects = { };
     std::size_t         m_start;
 
+    bool                m_parallel_classification = false;
+
 public:
     /*!
     
@@ -114,11 +116,28 @@ public:
     */
     virtual void process(const dataset & p_data, ttsas_data & p_result) override;
 
+    /*!
+
+    @brief    Enables parallel classification of skipped (pending) points during each pass.
+    @details  In this mode the nearest cluster for all pending points is found in parallel using representatives that
+               are at the beginning of the pass. After that points are processed in their order and each of them is
+               additionally compared with clusters that have been created during the pass, so only cluster creation is
+               a sequential part of the pass and results are reproducible. Representatives that are
+               changed during the pass are not taken into account until the next pass, therefore results might be
+               slightly different from the default sequential mode.
+
+    @param[in] p_enable: if `true` then pending points are classified in parallel.
+
+    */
+    void set_parallel_classification(const bool p_enable);
+
 private:
     void process_objects(const std::size_t p_changes);
 
     void process_skipped_object(const std::size_t p_index_point);
 
+    void process_skipped_objects_parallel();
+
     void append_to_cluster(const std::size_t p_index_cluster, const std::size_t p_index_point, const point & p_point);
 
     void allocate_cluster(const std::size_t p_index_point, const point & p_point);
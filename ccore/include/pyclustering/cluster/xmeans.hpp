@@ -147,19 +147,19 @@ public:
     void set_mndl_beta_bound(const double p_beta);
 
 private:
-    void improve_structure();
+    void improve_structure(const std::vector<double> & p_errors);
 
-    void improve_region_structure(const cluster & p_cluster, const point & p_center, dataset & p_allocated_centers) const;
+    void improve_region_structure(const cluster & p_cluster, const point & p_center, const double p_error, dataset & p_allocated_centers) const;
 
-    double search_optimal_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, const index_sequence & available_indexes) const;
+    double search_optimal_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, std::vector<double> & improved_errors, const index_sequence & available_indexes) const;
 
-    double improve_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, const index_sequence & available_indexes) const;
+    double improve_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, std::vector<double> & improved_errors, const index_sequence & available_indexes) const;
 
-    double splitting_criterion(const cluster_sequence & analysed_clusters, const dataset & analysed_centers) const;
+    double splitting_criterion(const std::vector<std::size_t> & p_sizes, const std::vector<double> & p_errors) const;
 
-    double bayesian_information_criterion(const cluster_sequence & analysed_clusters, const dataset & analysed_centers) const;
+    double bayesian_information_criterion(const std::vector<std::size_t> & p_sizes, const std::vector<double> & p_errors) const;
 
-    double minimum_noiseless_description_length(const cluster_sequence & clusters, const dataset & centers) const;
+    double minimum_noiseless_description_length(const std::vector<std::size_t> & p_sizes, const std::vector<double> & p_errors) const;
 };
 
 
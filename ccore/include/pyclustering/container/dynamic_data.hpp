@@ -11,6 +11,8 @@
 
 #include <vector>
 
+#include <pyclustering/container/dynamic_sink.hpp>
+
 
 namespace pyclustering {
 
@@ -27,6 +29,9 @@ class dynamic_data : public std::vector<DynamicType> {
 public:
     std::size_t   m_oscillators = 0;
 
+private:
+    dynamic_sink::ptr   m_sink = nullptr;
+
 public:
     dynamic_data() = default;
 
@@ -71,6 +76,22 @@ public:
         return m_oscillators;
     }
 
+    /**
+     *
+     * @brief   Attaches sink that receives collected network states instead of the collection, in this case
+     *          only the last state is kept in the collection.
+     *
+     * @param[in] p_sink: sink that receives network states, 'nullptr' to keep states in the collection.
+     *
+     */
+    void set_sink(const dynamic_sink::ptr & p_sink) {
+        m_sink = p_sink;
+    }
+
+    const dynamic_sink::ptr & get_sink() const {
+        return m_sink;
+    }
+
 private:
     void check_set_oscillators(const DynamicType & p_value) {
         if (std::vector<DynamicType>::empty()) {
@@ -0,0 +1,347 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#pragma once
+
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pyclustering/utils/mapped_file.hpp>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+/*!
+
+@brief   Describes a group of values that are stored by a dynamic sink on each simulation step, for example,
+          output of each oscillator of the network.
+
+*/
+struct dynamic_channel {
+    std::string     m_name;         /**< Name of the channel that is used to find it in a recorded file. */
+    std::size_t     m_size = 0;     /**< Amount of values (neurons) in the channel. */
+
+    bool operator==(const dynamic_channel & p_other) const {
+        return (m_name == p_other.m_name) && (m_size == p_other.m_size);
+    }
+
+    bool operator!=(const dynamic_channel & p_other) const {
+        return !(*this == p_other);
+    }
+};
+
+
+/*!
+
+@brief   Channels that are stored on each simulation step.
+
+*/
+using dynamic_layout = std::vector<dynamic_channel>;
+
+
+/*!
+
+@class   dynamic_sink dynamic_sink.hpp pyclustering/container/dynamic_sink.hpp
+
+@brief   Interface of a receiver of the output dynamic of an oscillatory network.
+@details When a sink is attached to the output dynamic then the network passes each collected simulation
+          step to the sink instead of keeping it in memory.
+
+*/
+class dynamic_sink {
+public:
+    /*!
+
+    @brief   Defines shared pointer to the dynamic sink.
+
+    */
+    using ptr = std::shared_ptr<dynamic_sink>;
+
+public:
+    virtual ~dynamic_sink() = default;
+
+public:
+    /*!
+
+    @brief   Prepares the sink to receive steps with the specified layout.
+    @details Opening of the already opened sink with the same layout has no effect, so several simulations
+              can be recorded one after another.
+
+    @param[in] p_layout: channels that are stored on each step.
+
+    */
+    virtual void open(const dynamic_layout & p_layout) = 0;
+
+    /*!
+
+    @brief   Appends new simulation step to the sink.
+
+    @param[in] p_time: time of the simulation step.
+
+    @return  Pointer to the row where values of all channels should be placed one after another, the row is
+              valid until the next call of 'append' or 'close'.
+
+    */
+    virtual float * append(const double p_time) = 0;
+
+    /*!
+
+    @brief   Flushes all appended steps and releases resources of the sink.
+
+    */
+    virtual void close() = 0;
+};
+
+
+/*!
+
+@brief   Compression of values of a channel in a dynamic file.
+
+*/
+enum class dynamic_compression {
+    NONE = 0,   /**< Values are stored as is. */
+    DELTA = 1,  /**< Each value is XOR-ed with the previous value of the neuron, bytes are shuffled and runs of zero bytes are encoded. */
+};
+
+
+/*!
+
+@class   dynamic_file_sink dynamic_sink.hpp pyclustering/container/dynamic_sink.hpp
+
+@brief   Dynamic sink that writes simulation steps to a binary columnar file.
+@details Steps are collected into chunks of fixed amount of steps. Filled chunk is passed to the background
+          thread that encodes and writes it, so simulation is not stopped by the disk. Inside of a chunk
+          values of each neuron are stored contiguously to read the evolution of a neuron quickly.
+          Values are stored in native byte order as single precision numbers, time is stored in double
+          precision. The file is read by 'dynamic_file_reader'.
+
+@see dynamic_file_reader
+
+*/
+class dynamic_file_sink : public dynamic_sink {
+public:
+    const static char           FILE_SIGNATURE[4];      /**< Signature in the beginning of the dynamic file. */
+
+    const static std::uint32_t  FILE_VERSION;           /**< Version of the dynamic file format. */
+
+    const static std::size_t    DEFAULT_CHUNK_BYTES;    /**< Size of a chunk when amount of steps per chunk is not specified. */
+
+    const static std::size_t    MAXIMUM_QUEUE_SIZE;     /**< Amount of filled chunks that may wait for the writer before simulation is paused. */
+
+private:
+    struct dynamic_chunk {
+        std::vector<double>     m_time;
+        std::vector<float>      m_values;
+    };
+
+private:
+    std::string                 m_filename;
+    dynamic_compression         m_compression   = dynamic_compression::NONE;
+    std::size_t                 m_chunk_steps   = 0;
+
+    dynamic_layout              m_layout        = { };
+    std::size_t                 m_width         = 0;
+    std::size_t                 m_capacity      = 0;
+    bool                        m_open          = false;
+
+    dynamic_chunk               m_chunk         = { };      /* chunk that is filled by 'append' */
+    std::deque<dynamic_chunk>   m_queue         = { };      /* filled chunks that are waiting for the writer */
+    std::vector<dynamic_chunk>  m_spare         = { };      /* written chunks whose memory is reused */
+
+    std::ofstream               m_stream;
+    std::thread                 m_writer;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_event;
+    bool                        m_stop          = false;
+    std::exception_ptr          m_error         = nullptr;
+
+    std::vector<std::uint32_t>  m_words         = { };      /* buffers of the writer thread */
+    std::vector<char>           m_shuffle       = { };
+    std::vector<std::uint32_t>  m_encodings     = { };
+    std::vector<std::vector<char>>  m_payloads  = { };
+
+public:
+    /*!
+
+    @brief   Creates sink that writes dynamic to the specified file.
+
+    @param[in] p_filename: path to the file, the file is created (or truncated) by 'open'.
+    @param[in] p_compression: compression of values of channels.
+    @param[in] p_chunk_steps: amount of steps in one chunk, if it is 0 then it is defined by 'DEFAULT_CHUNK_BYTES'.
+
+    */
+    explicit dynamic_file_sink(const std::string & p_filename, const dynamic_compression p_compression = dynamic_compression::NONE, const std::size_t p_chunk_steps = 0);
+
+    dynamic_file_sink(const dynamic_file_sink & p_other) = delete;
+
+    /*!
+
+    @brief   Closes the sink, errors of writing are ignored, call 'close' explicitly to get them.
+
+    */
+    virtual ~dynamic_file_sink();
+
+public:
+    /*!
+
+    @copydoc dynamic_sink::open
+
+    */
+    virtual void open(const dynamic_layout & p_layout) override;
+
+    /*!
+
+    @copydoc dynamic_sink::append
+
+    */
+    virtual float * append(const double p_time) override;
+
+    /*!
+
+    @copydoc dynamic_sink::close
+
+    */
+    virtual void close() override;
+
+    dynamic_file_sink & operator=(const dynamic_file_sink & p_other) = delete;
+
+private:
+    void submit_chunk();
+
+    void run_writer();
+
+    void write_chunk(const dynamic_chunk & p_chunk);
+
+    void rethrow_error();
+};
+
+
+/*!
+
+@class   dynamic_file_reader dynamic_sink.hpp pyclustering/container/dynamic_sink.hpp
+
+@brief   Reader of the dynamic that is recorded by 'dynamic_file_sink'.
+@details The file is mapped to memory, only chunks that contain requested steps are decoded. Chunk that
+          was not completely written (for example, simulation was interrupted) is ignored.
+
+@see dynamic_file_sink
+
+*/
+class dynamic_file_reader {
+private:
+    struct chunk_channel {
+        std::uint32_t   m_encoding  = 0;
+        std::size_t     m_position  = 0;
+        std::size_t     m_bytes     = 0;
+    };
+
+    struct chunk_index {
+        std::size_t                 m_steps     = 0;
+        std::size_t                 m_time      = 0;
+        std::vector<chunk_channel>  m_channels  = { };
+    };
+
+private:
+    utils::mapped_file          m_file;
+    dynamic_layout              m_layout        = { };
+    std::size_t                 m_size          = 0;
+    std::vector<chunk_index>    m_chunks        = { };
+
+public:
+    /*!
+
+    @brief   Maps the dynamic file and indexes its chunks.
+
+    @param[in] p_filename: path to the file that is written by 'dynamic_file_sink'.
+
+    */
+    explicit dynamic_file_reader(const std::string & p_filename);
+
+    dynamic_file_reader(const dynamic_file_reader & p_other) = delete;
+
+    ~dynamic_file_reader() = default;
+
+public:
+    /*!
+
+    @brief   Returns channels that are stored on each step.
+
+    */
+    const dynamic_layout & layout() const;
+
+    /*!
+
+    @brief   Returns amount of stored simulation steps.
+
+    */
+    std::size_t size() const;
+
+    /*!
+
+    @brief   Reads time of each stored simulation step.
+
+    @param[out] p_time: time of each step.
+
+    */
+    void read_time(std::vector<double> & p_time) const;
+
+    /*!
+
+    @brief   Reads values of a range of neurons of the channel on steps whose time is in the specified range.
+
+    @param[in]  p_channel: name of the channel.
+    @param[in]  p_time_from: the first time (inclusive) of the range.
+    @param[in]  p_time_to: the last time (inclusive) of the range.
+    @param[in]  p_begin: index of the first neuron of the range.
+    @param[in]  p_end: index of the neuron after the last neuron of the range.
+    @param[out] p_time: time of each read step.
+    @param[out] p_values: values of neurons [p_begin, p_end) on each read step.
+
+    */
+    void read(const std::string & p_channel, const double p_time_from, const double p_time_to, const std::size_t p_begin, const std::size_t p_end,
+              std::vector<double> & p_time, std::vector<std::vector<double>> & p_values) const;
+
+    /*!
+
+    @brief   Reads values of the neuron of the channel on all stored steps.
+
+    @param[in]  p_channel: name of the channel.
+    @param[in]  p_neuron: index of the neuron in the channel.
+    @param[out] p_time: time of each step.
+    @param[out] p_values: values of the neuron on each step.
+
+    */
+    void read_neuron(const std::string & p_channel, const std::size_t p_neuron, std::vector<double> & p_time, std::vector<double> & p_values) const;
+
+    dynamic_file_reader & operator=(const dynamic_file_reader & p_other) = delete;
+
+private:
+    std::size_t find_channel(const std::string & p_channel) const;
+
+    void read_chunk_time(const chunk_index & p_chunk, std::vector<double> & p_time) const;
+
+    const char * decode_channel(const chunk_index & p_chunk, const std::size_t p_channel, std::vector<char> & p_buffer) const;
+};
+
+
+}
+
+}
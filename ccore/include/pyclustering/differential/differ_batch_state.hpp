@@ -0,0 +1,131 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace pyclustering {
+
+namespace differential {
+
+
+/*!
+
+@brief   States of a batch of independent differential systems (for example, neurons of a network) that
+          are described by the same equation.
+@details Variables are stored in structure-of-arrays layout: values of the same variable of all systems
+          are placed contiguously, so stage arithmetic of the batched solvers is performed by simple loops
+          over neurons that are vectorized by compiler. Systems are processed by blocks of 'BLOCK_SIZE'
+          systems, blocks are processed in parallel.
+
+*/
+template <class state_type>
+class differ_batch_state {
+public:
+    typedef state_type                      value_type;
+
+public:
+    static constexpr std::size_t BLOCK_SIZE = 64;   /**< Amount of systems that are integrated together by one thread. */
+
+private:
+    std::size_t                 m_size          = 0;
+    std::size_t                 m_variables     = 0;
+    std::vector<value_type>     m_values        = { };
+
+public:
+    differ_batch_state() = default;
+
+    /*!
+
+    @brief   Creates states for the batch of systems.
+
+    @param[in] p_variables: amount of variables of each system.
+    @param[in] p_size: amount of systems in the batch.
+    @param[in] p_value: initial value of each variable.
+
+    */
+    differ_batch_state(const std::size_t p_variables, const std::size_t p_size, const value_type p_value = value_type()) :
+        m_size(p_size),
+        m_variables(p_variables),
+        m_values(p_variables * p_size, p_value)
+    { }
+
+    differ_batch_state(const differ_batch_state & p_other) = default;
+
+    differ_batch_state(differ_batch_state && p_other) = default;
+
+    ~differ_batch_state() = default;
+
+public:
+    /*!
+
+    @brief   Returns amount of systems in the batch.
+
+    */
+    std::size_t size() const { return m_size; }
+
+    /*!
+
+    @brief   Returns amount of variables of each system.
+
+    */
+    std::size_t variables() const { return m_variables; }
+
+    /*!
+
+    @brief   Returns amount of blocks that are processed independently by the batched solvers.
+
+    */
+    std::size_t blocks() const { return (m_size + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+    /*!
+
+    @brief   Changes amount of variables and systems, values are not preserved.
+
+    */
+    void resize(const std::size_t p_variables, const std::size_t p_size) {
+        m_size = p_size;
+        m_variables = p_variables;
+        m_values.resize(p_variables * p_size);
+    }
+
+    void fill(const value_type p_value) { std::fill(m_values.begin(), m_values.end(), p_value); }
+
+    /*!
+
+    @brief   Returns pointer to values of the specified variable of all systems.
+
+    */
+    value_type * operator[](const std::size_t p_variable) { return m_values.data() + p_variable * m_size; }
+
+    const value_type * operator[](const std::size_t p_variable) const { return m_values.data() + p_variable * m_size; }
+
+    value_type & operator()(const std::size_t p_variable, const std::size_t p_index) { return m_values[p_variable * m_size + p_index]; }
+
+    const value_type & operator()(const std::size_t p_variable, const std::size_t p_index) const { return m_values[p_variable * m_size + p_index]; }
+
+    differ_batch_state & operator=(const differ_batch_state & p_other) = default;
+
+    differ_batch_state & operator=(differ_batch_state && p_other) = default;
+
+    bool operator==(const differ_batch_state & p_other) const {
+        return (m_size == p_other.m_size) && (m_variables == p_other.m_variables) && (m_values == p_other.m_values);
+    }
+
+    bool operator!=(const differ_batch_state & p_other) const { return !(*this == p_other); }
+};
+
+
+}
+
+}
@@ -0,0 +1,133 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+
+
+namespace pyclustering {
+
+namespace differential {
+
+
+/*!
+
+@brief   State of a differential equation whose number of variables is known at compile time.
+@details The state is placed on the stack, therefore arithmetic between states does not allocate memory
+          and loops over variables are unrolled by compiler. It is used by solvers that take equation
+          as a template parameter for small systems (for example, neurons with 1-4 state variables)
+          that are integrated millions of times.
+
+*/
+template <class state_type, std::size_t SIZE>
+class differ_fixed_state {
+public:
+    typedef state_type                          value_type;
+    typedef std::array<value_type, SIZE>        differ_variables;
+
+    typedef typename differ_variables::iterator                 iterator;
+    typedef typename differ_variables::const_iterator           const_iterator;
+
+public:
+    differ_fixed_state() : m_variable_state() { }
+
+    explicit differ_fixed_state(const state_type value) { m_variable_state.fill(value); }
+
+    differ_fixed_state(const std::initializer_list<state_type> & value) {
+        if (value.size() != SIZE) {
+            throw std::runtime_error("Differetial states should consist of the same number of variables");
+        }
+
+        std::copy(value.begin(), value.end(), m_variable_state.begin());
+    }
+
+    differ_fixed_state(const differ_fixed_state & instance) = default;
+
+    ~differ_fixed_state() = default;
+
+public:
+    iterator begin() { return m_variable_state.begin(); }
+
+    iterator end() { return m_variable_state.end(); }
+
+    const_iterator cbegin() const { return m_variable_state.cbegin(); }
+
+    const_iterator cend() const { return m_variable_state.cend(); }
+
+    void fill(const value_type & value) { m_variable_state.fill(value); }
+
+    static constexpr std::size_t size() { return SIZE; }
+
+public:
+    value_type & operator[](std::size_t index) { return m_variable_state[index]; }
+
+    const value_type & operator[](std::size_t index) const { return m_variable_state[index]; }
+
+    /* Comparison */
+    bool operator==(const differ_fixed_state & rhs) const { return m_variable_state == rhs.m_variable_state; }
+
+    bool operator!=(const differ_fixed_state & rhs) const { return !(*this == rhs); }
+
+    differ_fixed_state & operator=(const differ_fixed_state & rhs) = default;
+
+    differ_fixed_state & operator+=(const differ_fixed_state & rhs) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            m_variable_state[i] += rhs[i];
+        }
+
+        return *this;
+    }
+
+    differ_fixed_state & operator-=(const differ_fixed_state & rhs) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            m_variable_state[i] -= rhs[i];
+        }
+
+        return *this;
+    }
+
+    differ_fixed_state & operator*=(const double rhs) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            m_variable_state[i] *= rhs;
+        }
+
+        return *this;
+    }
+
+    differ_fixed_state & operator/=(const double rhs) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            m_variable_state[i] /= rhs;
+        }
+
+        return *this;
+    }
+
+    /* Arithmetic */
+    friend differ_fixed_state operator+(differ_fixed_state lhs, const differ_fixed_state & rhs) { return lhs += rhs; }
+
+    friend differ_fixed_state operator-(differ_fixed_state lhs, const differ_fixed_state & rhs) { return lhs -= rhs; }
+
+    friend differ_fixed_state operator*(differ_fixed_state lhs, const double rhs) { return lhs *= rhs; }
+
+    friend differ_fixed_state operator*(const double lhs, differ_fixed_state rhs) { return rhs *= lhs; }
+
+    friend differ_fixed_state operator/(differ_fixed_state lhs, const double rhs) { return lhs /= rhs; }
+
+private:
+    differ_variables m_variable_state;
+};
+
+
+}
+
+}
@@ -9,8 +9,12 @@
 #pragma once
 
 
+#include <pyclustering/differential/differ_batch_state.hpp>
+#include <pyclustering/differential/differ_fixed_state.hpp>
 #include <pyclustering/differential/differ_state.hpp>
 #include <pyclustering/differential/equation.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
 #include <pyclustering/differential/solve_type.hpp>
 
 #include <functional>
@@ -76,6 +80,150 @@ void runge_kutta_4(const equation<state_type, extra_type> & func,
 }
 
 
+/*!
+
+@brief   Integrates the equation with state of fixed size by Runge-Kutta 4 method.
+@details The equation is a template parameter with signature 'void (double t, const differ_fixed_state & state,
+          differ_fixed_state & derivative)', so it is inlined into the solver, stage values are calculated
+          in-place on the stack. The result is the same as in case of the solver for 'differ_state'.
+
+@param[in] func: equation that should be integrated.
+@param[in,out] state: initial state that is replaced by the state at the end of the integration.
+@param[in] time_start: start time of the integration.
+@param[in] time_end: end time of the integration.
+@param[in] steps: amount of integration steps.
+
+*/
+template <class equation_type, class state_type, std::size_t SIZE>
+void runge_kutta_4(const equation_type &                        func,
+                   differ_fixed_state<state_type, SIZE> &       state,
+                   const double                                 time_start,
+                   const double                                 time_end,
+                   const std::size_t                            steps) {
+
+    const double step = (time_end - time_start) / (double) steps;
+
+    double time = time_start;
+    differ_fixed_state<state_type, SIZE> fp, k1, k2, k3, stage;
+
+    for (std::size_t i = 0; i < steps; i++) {
+        func(time, state, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k1[j] = fp[j] * step;
+            stage[j] = state[j] + k1[j] / 2.0;
+        }
+
+        func(time + step / 2.0, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k2[j] = fp[j] * step;
+            stage[j] = state[j] + k2[j] / 2.0;
+        }
+
+        func(time + step / 2.0, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k3[j] = fp[j] * step;
+            stage[j] = state[j] + k3[j];
+        }
+
+        func(time + step, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            const state_type k4 = fp[j] * step;
+            state[j] += (k1[j] + 2.0 * k2[j] + 2.0 * k3[j] + k4) / 6.0;
+        }
+
+        time += step;
+    }
+}
+
+
+/*!
+
+@brief   Integrates batch of independent systems by Runge-Kutta 4 method.
+@details The equation evaluates derivatives of systems in range [begin, end) at once, its signature is
+          'void (const std::vector<double> & times, const differ_batch_state & states, std::size_t begin,
+          std::size_t end, differ_batch_state & derivatives)', where 'times[i]' is time of the i-th system.
+          Blocks of systems are integrated in parallel, therefore the equation should not change shared
+          data. Each system is integrated with the same arithmetic as by the solver for 'differ_state'.
+
+@param[in] func: equation that should be integrated.
+@param[in,out] states: initial states that are replaced by states at the end of the integration.
+@param[in] time_start: start time of the integration.
+@param[in] time_end: end time of the integration.
+@param[in] steps: amount of integration steps.
+
+*/
+template <class equation_type, class state_type>
+void runge_kutta_4(const equation_type &                    func,
+                   differ_batch_state<state_type> &         states,
+                   const double                             time_start,
+                   const double                             time_end,
+                   const std::size_t                        steps) {
+
+    const double step = (time_end - time_start) / (double) steps;
+
+    const std::size_t size = states.size();
+    const std::size_t variables = states.variables();
+    const std::size_t block_size = differ_batch_state<state_type>::BLOCK_SIZE;
+
+    differ_batch_state<state_type> fp(variables, size), k1(variables, size), k2(variables, size), k3(variables, size), stage(variables, size);
+    std::vector<double> times(size, time_start);
+
+    parallel::parallel_for(std::size_t(0), states.blocks(), [&](const std::size_t p_block) {
+        const std::size_t begin = p_block * block_size;
+        const std::size_t end = std::min(begin + block_size, size);
+
+        double time = time_start;
+
+        for (std::size_t i = 0; i < steps; i++) {
+            std::fill(times.begin() + begin, times.begin() + end, time);
+            func(times, states, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v];
+                state_type * d1 = k1[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d1[j] = f[j] * step;
+                    y[j] = s[j] + d1[j] / 2.0;
+                }
+            }
+
+            std::fill(times.begin() + begin, times.begin() + end, time + step / 2.0);
+            func(times, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v];
+                state_type * d2 = k2[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d2[j] = f[j] * step;
+                    y[j] = s[j] + d2[j] / 2.0;
+                }
+            }
+
+            func(times, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v];
+                state_type * d3 = k3[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d3[j] = f[j] * step;
+                    y[j] = s[j] + d3[j];
+                }
+            }
+
+            std::fill(times.begin() + begin, times.begin() + end, time + step);
+            func(times, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * f = fp[v], * d1 = k1[v], * d2 = k2[v], * d3 = k3[v];
+                state_type * s = states[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    const state_type d4 = f[j] * step;
+                    s[j] += (d1[j] + 2.0 * d2[j] + 2.0 * d3[j] + d4) / 6.0;
+                }
+            }
+
+            time += step;
+        }
+    });
+}
+
+
 }
 
 }
\ No newline at end of file
@@ -12,11 +12,15 @@
 
 #include <cmath>
 
+#include <pyclustering/differential/differ_batch_state.hpp>
 #include <pyclustering/differential/differ_factor.hpp>
+#include <pyclustering/differential/differ_fixed_state.hpp>
 #include <pyclustering/differential/differ_state.hpp>
 #include <pyclustering/differential/equation.hpp>
 #include <pyclustering/differential/solve_type.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
 
 namespace pyclustering {
 
@@ -141,6 +145,308 @@ void runge_kutta_fehlberg_45(
 }
 
 
+/*!
+
+@brief   Integrates the equation with state of fixed size by Runge-Kutta-Fehlberg 4(5) method.
+@details The equation is a template parameter with signature 'void (double t, const differ_fixed_state & state,
+          differ_fixed_state & derivative)', so it is inlined into the solver, stage values are calculated
+          in-place on the stack. Step control is the same as in case of the solver for 'differ_state'.
+
+@param[in] func: equation that should be integrated.
+@param[in,out] state: initial state that is replaced by the last accepted state of the integration.
+@param[in] time_start: start time of the integration.
+@param[in] time_end: end time of the integration.
+@param[in] tolerance: maximum local error of the integration step.
+
+*/
+template <typename equation_type, typename state_type, std::size_t SIZE>
+void runge_kutta_fehlberg_45(
+                   const equation_type &                    func,
+                   differ_fixed_state<state_type, SIZE> &   state,
+                   const double                             time_start,
+                   const double                             time_end,
+                   const double                             tolerance) {
+
+    double time = time_start;
+
+    double h = (time_end - time_start) / 10.0;      /* default number of steps  */
+    const double hmin = h / 1000.0; /* default multiplier for maximum step size */
+    const double hmax = 1000.0 * h; /* default multiplier for minimum step size */
+
+    const double br = time_end - 0.00001 * (double) std::abs(time_end);
+    const unsigned int iteration_limit = 300;
+
+    unsigned int iteration_counter = 0;
+
+    differ_fixed_state<state_type, SIZE> fp, k1, k2, k3, k4, k5, stage;
+
+    while (time < time_end) {
+        const double current_time = time;
+
+        if ( (current_time + h) > br ) {
+            h = time_end - time;
+        }
+
+        func(current_time, state, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k1[j] = h * fp[j];
+            stage[j] = state[j] + factor::B2 * k1[j];
+        }
+
+        func(current_time + factor::A2 * h, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k2[j] = h * fp[j];
+            stage[j] = state[j] + factor::B3 * k1[j] + factor::C3 * k2[j];
+        }
+
+        func(current_time + factor::A3 * h, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k3[j] = h * fp[j];
+            stage[j] = state[j] + factor::B4 * k1[j] + factor::C4 * k2[j] + factor::D4 * k3[j];
+        }
+
+        func(current_time + factor::A4 * h, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k4[j] = h * fp[j];
+            stage[j] = state[j] + factor::B5 * k1[j] + factor::C5 * k2[j] + factor::D5 * k3[j] + factor::E5 * k4[j];
+        }
+
+        func(current_time + factor::A5 * h, stage, fp);
+        for (std::size_t j = 0; j < SIZE; j++) {
+            k5[j] = h * fp[j];
+            stage[j] = state[j] + factor::B6 * k1[j] + factor::C6 * k2[j] + factor::D6 * k3[j] + factor::E6 * k4[j] + factor::F6 * k5[j];
+        }
+
+        func(current_time + factor::A6 * h, stage, fp);
+
+        /* Calculate error (difference between Runge-Kutta 4 and Runge-Kutta 5). */
+        double err = 0.0;
+        for (std::size_t j = 0; j < SIZE; j++) {
+            const state_type k6 = h * fp[j];
+            const double current_error = std::abs(factor::R1 * k1[j] + factor::R3 * k3[j] + factor::R4 * k4[j] + factor::R5 * k5[j] + factor::R6 * k6);
+            if (current_error > err) {
+                err = current_error;
+            }
+        }
+
+        if ( (err < tolerance) || (h < 2.0 * hmin) ) {
+            /* Calculate new value. */
+            for (std::size_t j = 0; j < SIZE; j++) {
+                state[j] = state[j] + factor::N1 * k1[j] + factor::N3 * k3[j] + factor::N4 * k4[j] + factor::N5 * k5[j];
+            }
+
+            if (current_time + h > br) {
+                time = time_end;
+            }
+            else {
+                time = current_time + h;
+            }
+
+            iteration_counter++;
+        }
+
+        double s = 0.0;
+        if (err != 0.0) {
+            s = 0.84 * std::pow( (tolerance * h / err), 0.25 );
+        }
+
+        if ( (s < 0.75) && (h > 2.0 * hmin) ) {
+            h = h / 2.0;
+        }
+
+        if ( (s > 1.5) && (h * 2.0 < hmax) ) {
+            h = 2.0 * h;
+        }
+
+        if (iteration_counter >= iteration_limit) {
+            break;
+        }
+    }
+}
+
+
+/*!
+
+@brief   Integrates batch of independent systems by Runge-Kutta-Fehlberg 4(5) method.
+@details The equation evaluates derivatives of systems in range [begin, end) at once, its signature is
+          'void (const std::vector<double> & times, const differ_batch_state & states, std::size_t begin,
+          std::size_t end, differ_batch_state & derivatives)', where 'times[i]' is time of the i-th system.
+          Each system has its own step size and time, the step control is the same as in case of the solver
+          for 'differ_state'. Systems that have finished integration are masked: the equation might be
+          evaluated for them while there are active systems around them in the block, but their states
+          are not changed anymore. Blocks of systems are integrated in parallel, therefore the equation
+          should not change shared data.
+
+@param[in] func: equation that should be integrated.
+@param[in,out] states: initial states that are replaced by the last accepted states of the integration.
+@param[in] time_start: start time of the integration.
+@param[in] time_end: end time of the integration.
+@param[in] tolerance: maximum local error of the integration step.
+
+*/
+template <typename equation_type, typename state_type>
+void runge_kutta_fehlberg_45(
+                   const equation_type &                    func,
+                   differ_batch_state<state_type> &         states,
+                   const double                             time_start,
+                   const double                             time_end,
+                   const double                             tolerance) {
+
+    const double h_initial = (time_end - time_start) / 10.0;      /* default number of steps  */
+    const double hmin = h_initial / 1000.0; /* default multiplier for maximum step size */
+    const double hmax = 1000.0 * h_initial; /* default multiplier for minimum step size */
+
+    const double br = time_end - 0.00001 * (double) std::abs(time_end);
+    const unsigned int iteration_limit = 300;
+
+    const std::size_t size = states.size();
+    const std::size_t variables = states.variables();
+    const std::size_t block_size = differ_batch_state<state_type>::BLOCK_SIZE;
+
+    differ_batch_state<state_type> fp(variables, size), k1(variables, size), k2(variables, size),
+        k3(variables, size), k4(variables, size), k5(variables, size), stage(variables, size);
+
+    std::vector<double> current_time(size, time_start), time(size, time_start), h(size, h_initial), err(size, 0.0);
+    std::vector<double> stage_time(size, time_start);
+    std::vector<unsigned int> iteration_counter(size, 0);
+
+    parallel::parallel_for(std::size_t(0), states.blocks(), [&](const std::size_t p_block) {
+        const std::size_t block_begin = p_block * block_size;
+        const std::size_t block_end = std::min(block_begin + block_size, size);
+
+        const auto is_active = [&time, &iteration_counter, time_end, iteration_limit](const std::size_t p_index) {
+            return (time[p_index] < time_end) && (iteration_counter[p_index] < iteration_limit);
+        };
+
+        std::size_t begin = block_begin, end = block_end;
+
+        while (true) {
+            /* narrow the block to the range of systems that are still integrated */
+            while ((begin < end) && !is_active(begin)) { begin++; }
+            while ((begin < end) && !is_active(end - 1)) { end--; }
+
+            if (begin == end) {
+                break;
+            }
+
+            for (std::size_t j = begin; j < end; j++) {
+                if (is_active(j)) {
+                    current_time[j] = time[j];
+                    if ( (current_time[j] + h[j]) > br ) {
+                        h[j] = time_end - time[j];
+                    }
+                }
+            }
+
+            func(current_time, states, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v];
+                state_type * d1 = k1[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d1[j] = h[j] * f[j];
+                    y[j] = s[j] + factor::B2 * d1[j];
+                }
+            }
+
+            for (std::size_t j = begin; j < end; j++) { stage_time[j] = current_time[j] + factor::A2 * h[j]; }
+            func(stage_time, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v], * d1 = k1[v];
+                state_type * d2 = k2[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d2[j] = h[j] * f[j];
+                    y[j] = s[j] + factor::B3 * d1[j] + factor::C3 * d2[j];
+                }
+            }
+
+            for (std::size_t j = begin; j < end; j++) { stage_time[j] = current_time[j] + factor::A3 * h[j]; }
+            func(stage_time, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v], * d1 = k1[v], * d2 = k2[v];
+                state_type * d3 = k3[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d3[j] = h[j] * f[j];
+                    y[j] = s[j] + factor::B4 * d1[j] + factor::C4 * d2[j] + factor::D4 * d3[j];
+                }
+            }
+
+            for (std::size_t j = begin; j < end; j++) { stage_time[j] = current_time[j] + factor::A4 * h[j]; }
+            func(stage_time, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v], * d1 = k1[v], * d2 = k2[v], * d3 = k3[v];
+                state_type * d4 = k4[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d4[j] = h[j] * f[j];
+                    y[j] = s[j] + factor::B5 * d1[j] + factor::C5 * d2[j] + factor::D5 * d3[j] + factor::E5 * d4[j];
+                }
+            }
+
+            for (std::size_t j = begin; j < end; j++) { stage_time[j] = current_time[j] + factor::A5 * h[j]; }
+            func(stage_time, stage, begin, end, fp);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * s = states[v], * f = fp[v], * d1 = k1[v], * d2 = k2[v], * d3 = k3[v], * d4 = k4[v];
+                state_type * d5 = k5[v], * y = stage[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    d5[j] = h[j] * f[j];
+                    y[j] = s[j] + factor::B6 * d1[j] + factor::C6 * d2[j] + factor::D6 * d3[j] + factor::E6 * d4[j] + factor::F6 * d5[j];
+                }
+            }
+
+            for (std::size_t j = begin; j < end; j++) { stage_time[j] = current_time[j] + factor::A6 * h[j]; }
+            func(stage_time, stage, begin, end, fp);
+
+            /* Calculate error (difference between Runge-Kutta 4 and Runge-Kutta 5). */
+            std::fill(err.begin() + begin, err.begin() + end, 0.0);
+            for (std::size_t v = 0; v < variables; v++) {
+                const state_type * f = fp[v], * d1 = k1[v], * d3 = k3[v], * d4 = k4[v], * d5 = k5[v];
+                for (std::size_t j = begin; j < end; j++) {
+                    const state_type d6 = h[j] * f[j];
+                    const double current_error = std::abs(factor::R1 * d1[j] + factor::R3 * d3[j] + factor::R4 * d4[j] + factor::R5 * d5[j] + factor::R6 * d6);
+                    if (current_error > err[j]) {
+                        err[j] = current_error;
+                    }
+                }
+            }
+
+            for (std::size_t j = begin; j < end; j++) {
+                if (!is_active(j)) {
+                    continue;
+                }
+
+                if ( (err[j] < tolerance) || (h[j] < 2.0 * hmin) ) {
+                    /* Calculate new value. */
+                    for (std::size_t v = 0; v < variables; v++) {
+                        states(v, j) = states(v, j) + factor::N1 * k1(v, j) + factor::N3 * k3(v, j) + factor::N4 * k4(v, j) + factor::N5 * k5(v, j);
+                    }
+
+                    if (current_time[j] + h[j] > br) {
+                        time[j] = time_end;
+                    }
+                    else {
+                        time[j] = current_time[j] + h[j];
+                    }
+
+                    iteration_counter[j]++;
+                }
+
+                double s = 0.0;
+                if (err[j] != 0.0) {
+                    s = 0.84 * std::pow( (tolerance * h[j] / err[j]), 0.25 );
+                }
+
+                if ( (s < 0.75) && (h[j] > 2.0 * hmin) ) {
+                    h[j] = h[j] / 2.0;
+                }
+
+                if ( (s > 1.5) && (h[j] * 2.0 < hmax) ) {
+                    h[j] = 2.0 * h[j];
+                }
+            }
+        }
+    });
+}
+
+
 }
 
 }
\ No newline at end of file
@@ -43,4 +43,91 @@ enum bsas_package_indexer {
 extern "C" DECLARATION pyclustering_package * bsas_algorithm(const pyclustering_package * const p_sample,
                                                              const std::size_t p_amount,
                                                              const double p_threshold,
-                                                             const void * const p_metric);
\ No newline at end of file
+                                                             const void * const p_metric);
+
+
+/**
+ *
+ * @brief   Creates stream (online) version of BSAS algorithm.
+ * @details Caller should destroy created instance by 'bsas_stream_destroy' when it is not required.
+ *
+ * @param[in] p_amount: maximum allowable number of clusters that can be allocated during processing.
+ * @param[in] p_threshold: threshold of dissimilarity (maximum distance) between points.
+ * @param[in] p_metric: pointer to distance metric 'distance_metric' that is used for distance calculation between two points.
+ *
+ * @return  Returns pointer to instance of BSAS stream.
+ *
+ * @see bsas_stream_destroy
+ *
+ */
+extern "C" DECLARATION void * bsas_stream_create(const std::size_t p_amount,
+                                                 const double p_threshold,
+                                                 const void * const p_metric);
+
+/**
+ *
+ * @brief   Destroys instance of BSAS stream.
+ *
+ * @param[in] p_pointer: pointer to instance of BSAS stream.
+ *
+ */
+extern "C" DECLARATION void bsas_stream_destroy(const void * p_pointer);
+
+/**
+ *
+ * @brief   Processes points by BSAS stream in the specified order.
+ * @details Caller should destroy returned result that is in 'pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to instance of BSAS stream.
+ * @param[in] p_points: points that should be clustered.
+ *
+ * @return  Returns label (index of cluster) of each point, 'nullptr' if dimension of a point is not equal to
+ *           dimension of the stream (points before it are processed).
+ *
+ */
+extern "C" DECLARATION pyclustering_package * bsas_stream_push(const void * p_pointer,
+                                                               const pyclustering_package * const p_points);
+
+/**
+ *
+ * @brief   Returns representatives of clusters that are allocated by BSAS stream.
+ * @details Caller should destroy returned result that is in 'pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to instance of BSAS stream.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * bsas_stream_get_representatives(const void * p_pointer);
+
+/**
+ *
+ * @brief   Returns amount of points in each cluster that is allocated by BSAS stream.
+ * @details Caller should destroy returned result that is in 'pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to instance of BSAS stream.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * bsas_stream_get_sizes(const void * p_pointer);
+
+/**
+ *
+ * @brief   Saves state of BSAS stream to binary blob.
+ * @details Caller should destroy returned result that is in 'pyclustering_package'.
+ *
+ * @param[in] p_pointer: pointer to instance of BSAS stream.
+ *
+ * @return  Returns binary blob (package of 'char' values) with state of the stream.
+ *
+ */
+extern "C" DECLARATION pyclustering_package * bsas_stream_save(const void * p_pointer);
+
+/**
+ *
+ * @brief   Restores state of BSAS stream from binary blob.
+ *
+ * @param[in] p_pointer: pointer to instance of BSAS stream.
+ * @param[in] p_state: binary blob that has been created by 'bsas_stream_save'.
+ *
+ * @return  Returns 'true' if state is restored, otherwise 'false' (blob is corrupted or it has been created for another metric).
+ *
+ */
+extern "C" DECLARATION bool bsas_stream_load(const void * p_pointer, const pyclustering_package * const p_state);
@@ -58,6 +58,31 @@ extern "C" DECLARATION void som_destroy(const void * pointer);
 */
 extern "C" DECLARATION void som_load(const void * p_pointer, const pyclustering_package * p_weights, const pyclustering_package * p_awards, const pyclustering_package * p_captured_objects);
 
+/**
+*
+* @brief   Stores self-organized feature map (parameters, weights, awards and captured objects) to binary file.
+*
+* @param[in] p_pointer: pointer to instance of self-organized feature map.
+* @param[in] p_filename: path to the file where the network should be stored.
+*
+* @return  Returns 'true' if the network is stored, otherwise 'false'.
+*
+*/
+extern "C" DECLARATION bool som_save(const void * p_pointer, const char * p_filename);
+
+/**
+*
+* @brief   Creates self-organized feature map from binary file that has been created by 'som_save'.
+* @details The file is mapped to memory and weights are used directly from it, so several processes that load
+*           the same file share one read-only weight matrix. Returned instance should be destroyed by 'som_destroy'.
+*
+* @param[in] p_filename: path to the file with the network.
+*
+* @return  Returns pointer to self-organized feature map or 'nullptr' if the file cannot be loaded.
+*
+*/
+extern "C" DECLARATION void * som_load_file(const char * p_filename);
+
 /**
 *
 * @brief   Trains self-organized feature map (SOM).
@@ -72,6 +97,21 @@ extern "C" DECLARATION void som_load(const void * p_pointer, const pyclustering_
 */
 extern "C" DECLARATION size_t som_train(const void * pointer, const pyclustering_package * const sample, const size_t epochs, const bool autostop);
 
+/**
+*
+* @brief   Trains self-organized feature map (SOM) using specified training mode.
+*
+* @param[in] pointer: pointer to instance of self-organized feature map.
+* @param[in] sample: pointer to input dataset for training.
+* @param[in] epochs: number of epochs for training.
+* @param[in] autostop: stop learining when convergance is too low.
+* @param[in] p_mode: training mode (`0` - online, `1` - batch), see `som_train_mode`.
+*
+* @return  Returns number of learining iterations.
+*
+*/
+extern "C" DECLARATION size_t som_train_with_mode(const void * pointer, const pyclustering_package * const sample, const size_t epochs, const bool autostop, const size_t p_mode);
+
 /**
 *
 * @brief   Processes input pattern (no learining) and returns index of neuron-winner.
@@ -87,6 +127,18 @@ extern "C" DECLARATION size_t som_train(const void * pointer, const pyclustering
 */
 extern "C" DECLARATION size_t som_simulate(const void * pointer, const pyclustering_package * const p_pattern);
 
+/**
+*
+* @brief   Processes input patterns (no learining) in parallel and returns indexes of neurons-winners.
+*
+* @param[in] pointer: pointer to instance of self-organized feature map.
+* @param[in] p_patterns: input patterns for processing.
+*
+* @return  Returns package with index of neuron-winner for each input pattern.
+*
+*/
+extern "C" DECLARATION pyclustering_package * som_simulate_batch(const void * pointer, const pyclustering_package * const p_patterns);
+
 /**
 *
 * @brief  Returns number of neuron winners at the last step of learning process.
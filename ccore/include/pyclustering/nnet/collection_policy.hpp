@@ -0,0 +1,368 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace pyclustering {
+
+namespace nnet {
+
+
+/*!
+
+@class   dynamic_reduction collection_policy.hpp pyclustering/nnet/collection_policy.hpp
+
+@brief   Interface of a characteristic of the output dynamic that is calculated during simulation.
+@details Reduction observes each simulation step of the network (including steps that are not stored
+          in the output dynamic), so the characteristic is available without storing the whole dynamic.
+
+*/
+class dynamic_reduction {
+public:
+    /*!
+
+    @brief   Defines shared pointer to the reduction.
+
+    */
+    using ptr = std::shared_ptr<dynamic_reduction>;
+
+public:
+    virtual ~dynamic_reduction() = default;
+
+public:
+    /*!
+
+    @brief   Clears results of the reduction before new simulation.
+
+    @param[in] p_size: amount of oscillators in the network.
+
+    */
+    virtual void reset(const std::size_t p_size) = 0;
+
+    /*!
+
+    @brief   Observes state of the network on the simulation step.
+
+    @param[in] p_time: time of the simulation step.
+    @param[in] p_values: state of each oscillator (phase, output or membrane potential, depending on the network).
+
+    */
+    virtual void observe(const double p_time, const std::vector<double> & p_values) = 0;
+};
+
+
+/*!
+
+@class   sync_order_reduction collection_policy.hpp pyclustering/nnet/collection_policy.hpp
+
+@brief   Calculates global synchronization order of phase oscillators on each simulation step.
+
+*/
+class sync_order_reduction : public dynamic_reduction {
+private:
+    std::vector<double>     m_time      = { };
+    std::vector<double>     m_order     = { };
+
+public:
+    virtual void reset(const std::size_t p_size) override;
+
+    virtual void observe(const double p_time, const std::vector<double> & p_values) override;
+
+    /*!
+
+    @brief   Returns time of each observed simulation step.
+
+    */
+    const std::vector<double> & get_time() const;
+
+    /*!
+
+    @brief   Returns synchronization order on each observed simulation step.
+
+    */
+    const std::vector<double> & get_order() const;
+};
+
+
+/*!
+
+@class   spike_count_reduction collection_policy.hpp pyclustering/nnet/collection_policy.hpp
+
+@brief   Counts spikes of each oscillator, spike is a step when value of the oscillator becomes greater or
+          equal to the threshold while it was less than the threshold on the previous step.
+
+*/
+class spike_count_reduction : public dynamic_reduction {
+private:
+    double                      m_threshold = 0.5;
+    std::vector<std::size_t>    m_counts    = { };
+    std::vector<bool>           m_active    = { };
+
+public:
+    /*!
+
+    @brief   Creates spike counter.
+
+    @param[in] p_threshold: value that should be reached by an oscillator to generate spike, default value
+                is suitable for networks with binary outputs like PCNN.
+
+    */
+    explicit spike_count_reduction(const double p_threshold = 0.5);
+
+public:
+    virtual void reset(const std::size_t p_size) override;
+
+    virtual void observe(const double p_time, const std::vector<double> & p_values) override;
+
+    /*!
+
+    @brief   Returns amount of spikes of each oscillator.
+
+    */
+    const std::vector<std::size_t> & get_counts() const;
+};
+
+
+/*!
+
+@class   collection_policy collection_policy.hpp pyclustering/nnet/collection_policy.hpp
+
+@brief   Defines which simulation steps are stored in the output dynamic of an oscillatory network and which
+          characteristics of the dynamic are calculated during simulation.
+@details When a dynamic sink is attached to the output dynamic then recorded steps are passed to the sink.
+          'LAST' policy does not record any step, therefore it cannot be used with a sink and simulation
+          throws 'std::invalid_argument' in this case.
+
+*/
+class collection_policy {
+public:
+    /*!
+
+    @brief   Defines which simulation steps are stored in the output dynamic.
+
+    */
+    enum class collection_type {
+        LAST,           /**< Only the last state of the network is stored. */
+        ALL,            /**< Each simulation step is stored. */
+        EVERY_NTH,      /**< Each N-th step is stored, the initial state is always stored. */
+        WINDOW,         /**< Only the last W steps are stored. */
+    };
+
+private:
+    collection_type                     m_type          = collection_type::ALL;
+    std::size_t                         m_parameter     = 1;
+    std::vector<dynamic_reduction::ptr> m_reductions    = { };
+
+public:
+    /*!
+
+    @brief   Creates policy that stores each simulation step.
+
+    */
+    collection_policy() = default;
+
+    /*!
+
+    @brief   Creates collection policy.
+
+    @param[in] p_type: defines which simulation steps are stored.
+    @param[in] p_parameter: N for 'EVERY_NTH', W for 'WINDOW', it is ignored for other types.
+
+    */
+    explicit collection_policy(const collection_type p_type, const std::size_t p_parameter = 1);
+
+public:
+    /*!
+
+    @brief   Returns policy that stores only the last state of the network.
+
+    */
+    static collection_policy last();
+
+    /*!
+
+    @brief   Returns policy that stores each simulation step.
+
+    */
+    static collection_policy all();
+
+    /*!
+
+    @brief   Returns policy that stores each N-th simulation step.
+
+    @param[in] p_step: N - interval between stored steps.
+
+    */
+    static collection_policy every(const std::size_t p_step);
+
+    /*!
+
+    @brief   Returns policy that stores only the last W simulation steps.
+
+    @param[in] p_size: W - amount of stored steps.
+
+    */
+    static collection_policy window(const std::size_t p_size);
+
+public:
+    /*!
+
+    @brief   Adds characteristic that is calculated during simulation.
+
+    @param[in] p_reduction: reduction that observes each simulation step.
+
+    @return  Reference to the policy.
+
+    */
+    collection_policy & add_reduction(const dynamic_reduction::ptr & p_reduction);
+
+    collection_type get_type() const;
+
+    std::size_t get_parameter() const;
+
+    const std::vector<dynamic_reduction::ptr> & get_reductions() const;
+
+    /*!
+
+    @brief   Returns maximum amount of states that are stored in the output dynamic.
+
+    @param[in] p_steps: amount of simulation steps including the initial state.
+
+    */
+    std::size_t get_capacity(const std::size_t p_steps) const;
+
+    /*!
+
+    @brief   Returns 'true' if the simulation step is stored in line with the policy.
+    @details 'LAST' policy does not record any step because the final state is known only after simulation,
+              so 'false' is always returned for it.
+
+    @param[in] p_step: index of the simulation step, the initial state has index 0.
+
+    */
+    bool is_recorded(const std::size_t p_step) const;
+
+    /*!
+
+    @brief   Clears results of all reductions before new simulation.
+
+    */
+    void reset(const std::size_t p_size) const;
+
+    /*!
+
+    @brief   Passes state of the network on the simulation step to all reductions.
+
+    */
+    void observe(const double p_time, const std::vector<double> & p_values) const;
+};
+
+
+/*!
+
+@class   dynamic_collector collection_policy.hpp pyclustering/nnet/collection_policy.hpp
+
+@brief   Decides where the state of the network on the current simulation step should be placed in the output
+          dynamic in line with the collection policy.
+@details The window is stored as a ring, the output dynamic is arranged by 'arrange' after simulation.
+
+*/
+class dynamic_collector {
+public:
+    /*!
+
+    @brief   Defines what should be done with the state of the network on the current step.
+
+    */
+    enum class action {
+        SKIP,       /**< State is not stored. */
+        APPEND,     /**< State is added to the end of the output dynamic. */
+        REPLACE,    /**< State replaces the stored state at the position. */
+    };
+
+private:
+    const collection_policy &   m_policy;
+    bool                        m_last      = false;
+    std::size_t                 m_step      = 0;
+    std::size_t                 m_stored    = 0;
+    std::size_t                 m_position  = 0;
+    bool                        m_recorded  = false;
+
+public:
+    /*!
+
+    @brief   Creates collector for the simulation.
+
+    @param[in] p_policy: collection policy of the simulation.
+    @param[in] p_stored: amount of states that are already stored in the output dynamic.
+    @param[in] p_sink: if 'true' then recorded steps are passed to a dynamic sink and only the last state is kept
+                in the output dynamic regardless of the policy.
+
+    @throw std::invalid_argument if a sink is used with 'LAST' policy that does not record any step.
+
+    */
+    dynamic_collector(const collection_policy & p_policy, const std::size_t p_stored = 0, const bool p_sink = false);
+
+public:
+    /*!
+
+    @brief   Moves to the next simulation step and returns action for the state of the network on it.
+
+    @param[out] p_position: position of the state that should be replaced in case of 'REPLACE' action.
+
+    */
+    action next(std::size_t & p_position);
+
+    /*!
+
+    @brief   Returns 'true' if the current step is recorded by the policy (for example, it should be passed to a sink).
+
+    */
+    bool is_recorded() const;
+
+    /*!
+
+    @brief   Returns collection policy of the simulation.
+
+    */
+    const collection_policy & get_policy() const;
+
+    /*!
+
+    @brief   Returns position of the oldest stored state.
+
+    */
+    std::size_t get_first() const;
+
+    /*!
+
+    @brief   Arranges the output dynamic in chronological order after simulation.
+
+    @param[in,out] p_dynamic: output dynamic that is filled in line with actions of the collector.
+
+    */
+    template <typename DynamicType>
+    void arrange(DynamicType & p_dynamic) const {
+        if (get_first() != 0) {
+            std::rotate(p_dynamic.begin(), p_dynamic.begin() + get_first(), p_dynamic.end());
+        }
+    }
+};
+
+
+}
+
+}
@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <ostream>
@@ -19,11 +20,16 @@
 #include <vector>
 #include <unordered_map>
 
+#include <pyclustering/container/dynamic_sink.hpp>
+
 #include <pyclustering/utils/metric.hpp>
 #include <pyclustering/utils/random.hpp>
 
+#include <pyclustering/differential/differ_batch_state.hpp>
 #include <pyclustering/differential/differ_state.hpp>
 
+#include <pyclustering/nnet/collection_policy.hpp>
+
 
 using namespace pyclustering::differential;
 using namespace pyclustering::utils::random;
@@ -121,6 +127,109 @@ struct hhn_oscillator : public basic_neuron_state {
 };
 
 
+/*!
+
+@class      hhn_gating_table hhn.hpp pyclustering/nnet/hhn.hpp
+
+@brief      Precomputed gating rates of sodium and potassium channels of Hodgkin-Huxley neuron.
+@details    Rates depend only on membrane potential relative to the rest potential, therefore they are tabulated once
+             on the uniform grid [MINIMUM_POTENTIAL, MAXIMUM_POTENTIAL] with step RESOLUTION and linearly interpolated
+             between grid nodes. Rates of one node are stored together, so the lookup of all rates of a neuron touches
+             two neighbour records only. Removable singularities of rates 'am' and 'an' are replaced by their limits.
+
+*/
+class hhn_gating_table {
+public:
+    /*!
+    @brief  Positions of gating rates in the record of a grid node.
+    */
+    enum: std::size_t {
+        RATE_AM = 0,    /**< Activation rate of sodium channel (alpha m).       */
+        RATE_AH,        /**< Activation rate of sodium inactivation (alpha h).  */
+        RATE_AN,        /**< Activation rate of potassium channel (alpha n).    */
+        RATE_BM,        /**< Deactivation rate of sodium channel (beta m).      */
+        RATE_BH,        /**< Deactivation rate of sodium inactivation (beta h). */
+        RATE_BN,        /**< Deactivation rate of potassium channel (beta n).   */
+        RATE_AMOUNT
+    };
+
+public:
+    const static double MINIMUM_POTENTIAL;      /**< Lowest tabulated potential relative to the rest potential [mV].  */
+    const static double MAXIMUM_POTENTIAL;      /**< Highest tabulated potential relative to the rest potential [mV]. */
+    const static double RESOLUTION;             /**< Distance between grid nodes [mV]. */
+
+private:
+    std::vector<double> m_rates = { };      /* rates of grid nodes, RATE_AMOUNT values per node */
+    double              m_scale = 0.0;      /* inverse resolution */
+    double              m_last_position = 0.0;
+
+public:
+    /*!
+    @brief  Returns table that is shared by all networks, the table is built on the first call.
+    */
+    static const hhn_gating_table & get();
+
+    /*!
+    @brief  Calculates gating rates using analytic expressions.
+
+    @param[in]  p_potential: membrane potential relative to the rest potential.
+    @param[out] p_rates: gating rates in order that is defined by RATE_* positions.
+
+    */
+    static void calculate_rates(const double p_potential, double * p_rates);
+
+public:
+    /*!
+    @brief  Returns 'true' if the potential relative to the rest potential is covered by the table.
+    */
+    bool contains(const double p_potential) const {
+        return (p_potential >= MINIMUM_POTENTIAL) && (p_potential <= MAXIMUM_POTENTIAL);
+    }
+
+    /*!
+    @brief  Returns amount of grid nodes in the table.
+    */
+    std::size_t size() const { return m_rates.size() / RATE_AMOUNT; }
+
+    /*!
+    @brief  Returns rates of grid nodes, RATE_AMOUNT values per node.
+    */
+    const double * data() const { return m_rates.data(); }
+
+    /*!
+    @brief  Calculates gating rates by linear interpolation, potential should be covered by the table.
+    @details Potential out of the table (including NaN) is clamped to the table, rates for such potential
+              should be calculated by 'calculate_rates'.
+
+    @param[in]  p_potential: membrane potential relative to the rest potential.
+    @param[out] p_rates: gating rates in order that is defined by RATE_* positions.
+
+    */
+    void interpolate(const double p_potential, double * p_rates) const {
+        double position = (p_potential - MINIMUM_POTENTIAL) * m_scale;
+        if (!(position >= 0.0)) {
+            position = 0.0;     /* NaN is also placed to the first node */
+        }
+        else if (position > m_last_position) {
+            position = m_last_position;
+        }
+
+        const std::size_t node = std::min(static_cast<std::size_t>(position), size() - 2);
+        const double fraction = position - static_cast<double>(node);
+
+        const double * lower = m_rates.data() + node * RATE_AMOUNT;
+        const double * upper = lower + RATE_AMOUNT;
+
+        for (std::size_t i = 0; i < RATE_AMOUNT; i++) {
+            p_rates[i] = lower[i] + (upper[i] - lower[i]) * fraction;
+        }
+    }
+
+private:
+    hhn_gating_table();
+};
+
+
 
 /*!
 
@@ -237,6 +346,8 @@ private:
 
     value_dynamic_ptr   m_time                = std::make_shared<value_dynamic>();
 
+    container::dynamic_sink::ptr    m_sink    = nullptr;
+
 
 public:
     /*!
@@ -344,6 +455,25 @@ public:
 
     /*!
 
+    @brief  Attaches sink that receives collected states instead of the output dynamic.
+    @details Each enabled state is passed to the sink as two channels, for example, 'peripheral.membrane_potential'
+              and 'central.membrane_potential'. States are not kept in memory while the sink is attached, only
+              amount of stored steps is counted.
+
+    @param[in] p_sink: sink that receives collected states, 'nullptr' to keep states in memory.
+
+    */
+    void set_sink(const container::dynamic_sink::ptr & p_sink);
+
+    /*!
+
+    @brief  Returns sink that receives collected states, `nullptr` if states are kept in memory.
+
+    */
+    const container::dynamic_sink::ptr & get_sink() const;
+
+    /*!
+
     @brief  Stores current state of the oscillatory network that is defined by timestamp, peripheral and central neurons.
 
     @param[in] p_time: current simulation time.
@@ -355,6 +485,29 @@ public:
 
     /*!
 
+    @brief  Replaces stored state of the oscillatory network on the specified iteration.
+
+    @param[in] p_iteration: iteration of the stored dynamic that should be replaced.
+    @param[in] p_time: current simulation time.
+    @param[in] p_peripheral: container with states of peripheral neurons.
+    @param[in] p_central: container with states of central neurons.
+
+    */
+    void replace(const std::size_t p_iteration, const double p_time, const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central);
+
+    /*!
+
+    @brief  Rotates stored iterations starting from the specified one in order to make another iteration the first one.
+    @details It is used to arrange dynamic that is collected as a ring of the last iterations.
+
+    @param[in] p_begin: the first iteration of the rotated range, the range lasts to the end of the dynamic.
+    @param[in] p_iteration: iteration that should be placed on position 'p_begin'.
+
+    */
+    void rotate(const std::size_t p_begin, const std::size_t p_iteration);
+
+    /*!
+
     @brief  Reserves memory for the evolution that is defined by amount of iterations for simulation.
 
     @param[in] p_dynamic_size: size of the dynamic evolution.
@@ -445,6 +598,8 @@ private:
 
     void reserve_collection(const hhn_dynamic::collect p_state, const std::size_t p_size);
 
+    void store_sink(const double p_time, const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central);
+
     void store_membrane_potential(const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central);
 
     void store_active_cond_sodium(const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central);
@@ -606,8 +761,7 @@ private:
     };
 
 private:
-    using hhn_state           = differ_result<double>;
-    using hhn_states          = std::vector< hhn_state >;
+    using hhn_states          = differ_batch_state<double>;     /* states of peripheral neurons followed by central elements */
 
 private:
     std::vector<hhn_oscillator>   m_peripheral  = { };
@@ -618,6 +772,10 @@ private:
 
     hnn_parameters                m_params;
 
+    std::vector<double>           m_peripheral_currents = { };  /* external currents of peripheral neurons on the current step (SoA copy for the kernel) */
+
+    std::vector<double>           m_peripheral_weights  = { };  /* connection strengths from CN2 to peripheral neurons on the current step (SoA copy for the kernel) */
+
 public:
     /*!
     
@@ -667,6 +825,26 @@ public:
 
     /*!
 
+    @brief      Runs oscillatory network simulation where stored iterations are defined by the collection policy.
+    @details    Reductions of the policy observe membrane potentials of peripheral neurons.
+
+    @param[in] p_steps: number steps of simulations during simulation.
+    @param[in] p_time: time of simulation.
+    @param[in] p_solver: type of the solver for the simulation.
+    @param[in] p_stimulus: external inputs (stimulus) to the network.
+    @param[in] p_policy: defines which iterations are stored and which reductions observe the network.
+    @param[in] p_output_dynamic: output dynamic of the network.
+
+    */
+    void simulate(const std::size_t         p_steps,
+                  const double              p_time,
+                  const solve_type          p_solver,
+                  const hhn_stimulus &      p_stimulus,
+                  const collection_policy & p_policy,
+                  hhn_dynamic &             p_output_dynamic);
+
+    /*!
+
     @brief      Returns size of the oscillatory network.
     @details    Size of the network is defined by amount of neurons (oscillators) in it.
 
@@ -676,21 +854,21 @@ public:
     std::size_t size() const;
 
 private:
-    void store_dynamic(const double p_time, hhn_dynamic & p_dynamic);
+    void store_dynamic(const double p_time, const std::size_t p_begin, dynamic_collector & p_collector, hhn_dynamic & p_dynamic);
 
     void calculate_states(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step);
 
-    void calculate_peripheral_states(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, hhn_states & p_next_states);
+    void perform_calculation(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, hhn_states & p_states) const;
 
-    void calculate_central_states(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, hhn_states & p_next_states);
+    void neuron_states(const std::vector<double> & p_times, const hhn_states & p_inputs, const std::size_t p_begin, const std::size_t p_end, hhn_states & p_outputs) const;
 
-    void perform_calculation(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, const differ_state<double> & p_inputs, const differ_extra<> & p_extra, hhn_state & p_next_states);
+    void peripheral_states(const std::vector<double> & p_times, const hhn_states & p_inputs, const std::size_t p_begin, const std::size_t p_end, hhn_states & p_outputs) const;
 
-    void neuron_states(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) const;
+    void central_states(const double p_time, const std::size_t p_index, const hhn_states & p_inputs, hhn_states & p_outputs) const;
 
     double peripheral_external_current(const std::size_t p_index) const;
 
-    double peripheral_synaptic_current(const std::size_t p_index, const double p_time, const double p_membrane) const;
+    double central_memory_impact(const std::size_t p_central_index, const double p_time) const;
 
     double central_first_synaptic_current(const double p_time, const double p_membrane) const;
 
@@ -698,34 +876,33 @@ private:
 
     void update_peripheral_current();
 
-    void assign_neuron_states(const double p_time, const double p_step, const hhn_states & p_next_peripheral, const hhn_states & p_next_central);
+    void assign_neuron_states(const double p_time, const double p_step, const hhn_states & p_next_states);
 
     static double alpha_function(const double p_time, const double p_alfa, const double p_betta);
 
     template <class NeuronType>
-    static void pack_equation_input(const NeuronType & p_neuron, differ_state<double> & p_inputs);
+    static void pack_equation_input(const NeuronType & p_neuron, const std::size_t p_index, hhn_states & p_inputs);
 
     template <class NeuronType>
-    static void unpack_equation_output(const hhn_state & p_outputs, NeuronType & p_neuron);
+    static void unpack_equation_output(const hhn_states & p_outputs, const std::size_t p_index, NeuronType & p_neuron);
 };
 
 
 template <class NeuronType>
-void hhn_network::pack_equation_input(const NeuronType & p_neuron, differ_state<double> & p_inputs) {
-    p_inputs.resize(POSITION_AMOUNT);
-    p_inputs[POSITION_MEMBRAN_POTENTIAL]      = p_neuron.m_membrane_potential;
-    p_inputs[POSITION_ACTIVE_COND_SODIUM]     = p_neuron.m_active_cond_sodium;
-    p_inputs[POSITION_INACTIVE_COND_SODIUM]   = p_neuron.m_inactive_cond_sodium;
-    p_inputs[POSITION_ACTIVE_COND_POTASSIUM]  = p_neuron.m_active_cond_potassium;
+void hhn_network::pack_equation_input(const NeuronType & p_neuron, const std::size_t p_index, hhn_states & p_inputs) {
+    p_inputs(POSITION_MEMBRAN_POTENTIAL, p_index)      = p_neuron.m_membrane_potential;
+    p_inputs(POSITION_ACTIVE_COND_SODIUM, p_index)     = p_neuron.m_active_cond_sodium;
+    p_inputs(POSITION_INACTIVE_COND_SODIUM, p_index)   = p_neuron.m_inactive_cond_sodium;
+    p_inputs(POSITION_ACTIVE_COND_POTASSIUM, p_index)  = p_neuron.m_active_cond_potassium;
 }
 
 
 template <class NeuronType>
-void hhn_network::unpack_equation_output(const hhn_state & p_outputs, NeuronType & p_neuron) {
-    p_neuron.m_membrane_potential      = p_outputs[0].state[POSITION_MEMBRAN_POTENTIAL];
-    p_neuron.m_active_cond_sodium      = p_outputs[0].state[POSITION_ACTIVE_COND_SODIUM];
-    p_neuron.m_inactive_cond_sodium    = p_outputs[0].state[POSITION_INACTIVE_COND_SODIUM];
-    p_neuron.m_active_cond_potassium   = p_outputs[0].state[POSITION_ACTIVE_COND_POTASSIUM];
+void hhn_network::unpack_equation_output(const hhn_states & p_outputs, const std::size_t p_index, NeuronType & p_neuron) {
+    p_neuron.m_membrane_potential      = p_outputs(POSITION_MEMBRAN_POTENTIAL, p_index);
+    p_neuron.m_active_cond_sodium      = p_outputs(POSITION_ACTIVE_COND_SODIUM, p_index);
+    p_neuron.m_inactive_cond_sodium    = p_outputs(POSITION_INACTIVE_COND_SODIUM, p_index);
+    p_neuron.m_active_cond_potassium   = p_outputs(POSITION_ACTIVE_COND_POTASSIUM, p_index);
 }
 
 
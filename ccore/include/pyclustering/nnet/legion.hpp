@@ -13,6 +13,8 @@
 #include <vector>
 #include <random>
 
+#include <pyclustering/differential/differ_batch_state.hpp>
+#include <pyclustering/differential/differ_fixed_state.hpp>
 #include <pyclustering/differential/runge_kutta_4.hpp>
 #include <pyclustering/differential/runge_kutta_fehlberg_45.hpp>
 
@@ -21,6 +23,7 @@
 #include <pyclustering/container/dynamic_data.hpp>
 #include <pyclustering/container/ensemble_data.hpp>
 
+#include <pyclustering/nnet/collection_policy.hpp>
 #include <pyclustering/nnet/network.hpp>
 
 
@@ -104,6 +107,10 @@ struct legion_oscillator {
 
 
 class legion_network {
+private:
+    using legion_states             = differ_batch_state<double>;      /* excitatory, inhibitory and potential (if it is enabled) of oscillators */
+    using legion_inhibitor_state    = differ_fixed_state<double, 1>;   /* global inhibitor */
+
 private:
     std::vector<legion_oscillator> m_oscillators;
 
@@ -147,6 +154,8 @@ public:
 public:
     void simulate(const unsigned int steps, const double time, const solve_type solver, const bool collect_dynamic, const legion_stimulus & stimulus, legion_dynamic & output_dynamic);
 
+    void simulate(const unsigned int steps, const double time, const solve_type solver, const collection_policy & policy, const legion_stimulus & stimulus, legion_dynamic & output_dynamic);
+
     inline size_t size() const { return m_oscillators.size(); }
 
 
@@ -155,13 +164,11 @@ private:
 
     void calculate_states(const legion_stimulus & stimulus, const solve_type solver, const double t, const double step, const double int_step);
 
-    void inhibitor_state(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) const;
-
-    void neuron_states(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs);
+    void inhibitor_state(const double t, const double sigma, const legion_inhibitor_state & inputs, legion_inhibitor_state & outputs) const;
 
-    void neuron_simplify_states(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs);
+    void neuron_states(const std::vector<double> & times, const legion_states & inputs, const std::size_t begin, const std::size_t end, const std::vector<double> & potentials, legion_states & outputs) const;
 
-    void store_dynamic(const double time, const bool collect_dynamic, legion_dynamic & dynamic) const;
+    void store_dynamic(const double time, dynamic_collector & collector, legion_dynamic & dynamic) const;
 
     void initialize(const size_t num_osc,
         const connection_t connection_type,
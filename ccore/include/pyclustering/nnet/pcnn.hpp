@@ -9,6 +9,8 @@
 #pragma once
 
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <pyclustering/container/adjacency.hpp>
@@ -16,6 +18,7 @@
 #include <pyclustering/container/dynamic_data.hpp>
 #include <pyclustering/container/ensemble_data.hpp>
 
+#include <pyclustering/nnet/collection_policy.hpp>
 #include <pyclustering/nnet/network.hpp>
 
 
@@ -108,12 +111,100 @@ public:
 };
 
 
+/*!
+
+@class   pcnn_grid_kernel pcnn.hpp pyclustering/nnet/pcnn.hpp
+
+@brief   Calculates states of pulse-coupled neural network whose oscillators are connected to a grid
+          (for example, pixels of an image).
+@details Neighbor influence is calculated by a stencil over outputs of grid rows, so connections are not
+          stored. Outputs are packed into bits, each row starts from its own word, therefore rows are
+          processed in parallel by bands without synchronization. Fast linking revisits only oscillators
+          that are adjacent to oscillators whose outputs were changed on the previous iteration.
+
+*/
+class pcnn_grid_kernel {
+public:
+    const static std::size_t BAND_SIZE;     /**< Minimal amount of oscillators in a band of rows that is processed by one task. */
+
+private:
+    using bit_row = std::vector<std::uint64_t>;
+
+private:
+    std::size_t             m_width         = 0;
+    std::size_t             m_height        = 0;
+    std::size_t             m_stride        = 0;    /* amount of words in a row */
+    std::size_t             m_band_rows     = 1;
+    bool                    m_diagonal      = false;
+    pcnn_parameters         m_params;
+
+    std::vector<double>     m_feeding_influence = { };  /* influence for each amount of active neighbors */
+    std::vector<double>     m_linking_influence = { };
+
+    std::vector<double>     m_feeding       = { };
+    std::vector<double>     m_linking       = { };
+    std::vector<double>     m_threshold     = { };
+
+    bit_row                 m_output        = { };
+    bit_row                 m_next          = { };
+    bit_row                 m_changed       = { };      /* outputs that are changed on the previous fast linking iteration */
+    bit_row                 m_next_changed  = { };
+    std::vector<char>       m_row_changed       = { };
+    std::vector<char>       m_next_row_changed  = { };
+
+public:
+    /*!
+
+    @brief   Creates grid kernel.
+
+    @param[in] p_width: amount of oscillators in a row of the grid.
+    @param[in] p_height: amount of rows in the grid.
+    @param[in] p_structure: type of the grid - 'CONNECTION_GRID_FOUR' or 'CONNECTION_GRID_EIGHT'.
+    @param[in] p_parameters: parameters of the network.
+
+    */
+    pcnn_grid_kernel(const std::size_t p_width, const std::size_t p_height, const connection_t p_structure, const pcnn_parameters & p_parameters);
+
+public:
+    /*!
+
+    @brief   Performs one simulation step of the network.
+
+    @param[in] p_stimulus: stimulus of each oscillator, oscillators are placed row by row.
+
+    */
+    void calculate_states(const pcnn_stimulus & p_stimulus);
+
+    double get_output(const std::size_t p_index) const;
+
+    inline std::size_t size() const { return m_width * m_height; }
+
+private:
+    template <typename TypeAction>
+    void process_bands(const TypeAction & p_action);
+
+    std::size_t count_active_neighbors(const bit_row & p_outputs, const std::size_t p_row, const std::size_t p_column) const;
+
+    bool calculate_fast_linking(const std::size_t p_row, const std::size_t p_column);
+
+    void fast_linking();
+
+    void fast_linking_row(const std::size_t p_row);
+
+    void fast_linking_frontier_row(const std::size_t p_row);
+
+    std::uint64_t candidate_word(const std::size_t p_row, const std::size_t p_word) const;
+};
+
+
 class pcnn {
 protected:
     std::vector<pcnn_oscillator> m_oscillators;
 
     std::shared_ptr<adjacency_collection> m_connection;
 
+    std::unique_ptr<pcnn_grid_kernel> m_grid;
+
     pcnn_parameters m_params;
 
 
@@ -132,13 +223,41 @@ public:
          const size_t p_width,
          const pcnn_parameters & p_parameters);
 
+    /*!
+
+    @brief   Copy constructor, state of the grid kernel is copied, so copies are simulated independently.
+
+    @param[in] p_other: network that should be copied.
+
+    */
+    pcnn(const pcnn & p_other);
+
+    pcnn(pcnn && p_other) = default;
+
     virtual ~pcnn() = default;
 
 
+public:
+    /*!
+
+    @brief   Makes deep copy of the network including state of the grid kernel.
+
+    @param[in] p_other: network that should be copied.
+
+    @return  Reference to the network.
+
+    */
+    pcnn & operator=(const pcnn & p_other);
+
+    pcnn & operator=(pcnn && p_other) = default;
+
+
 public:
     void simulate(const std::size_t steps, const pcnn_stimulus & stimulus, pcnn_dynamic & output_dynamic);
 
-    inline size_t size() const { return m_oscillators.size(); }
+    void simulate(const std::size_t steps, const pcnn_stimulus & stimulus, const collection_policy & policy, pcnn_dynamic & output_dynamic);
+
+    inline size_t size() const { return m_grid ? m_grid->size() : m_oscillators.size(); }
 
 
 private:
@@ -150,7 +269,7 @@ private:
 
   void calculate_states(const pcnn_stimulus & stimulus);
 
-  void store_dynamic(const std::size_t step, pcnn_dynamic & dynamic) const;
+  void store_dynamic(const std::size_t step, dynamic_collector & collector, pcnn_dynamic & dynamic) const;
 
   void fast_linking(const std::vector<double> & feeding, std::vector<double> & linking, std::vector<double> & output);
 };
@@ -9,8 +9,16 @@
 #pragma once
 
 
-#include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <pyclustering/container/kdtree_balanced.hpp>
+
+#include <pyclustering/utils/mapped_file.hpp>
 
 #include <pyclustering/definitions.hpp>
 
@@ -62,6 +70,20 @@ enum class som_init_type {
 };
 
 
+/**
+*
+* @brief   Training modes of self-organized feature map.
+*
+*/
+enum class som_train_mode {
+    /*!< Weights are adapted after each input pattern (classical Kohonen rule). */
+    SOM_ONLINE = 0,
+
+    /*!< Neurons-winners are found for the whole input data at once and weights are replaced by neighborhood-weighted averages of captured patterns (batch SOM). */
+    SOM_BATCH = 1
+};
+
+
 /*!
 
 @class   som_parameters som.hpp pyclustering/nnet/som.hpp
@@ -132,6 +154,25 @@ using som_neighbor_sequence = std::vector<std::vector<size_t> >;
 
 */
 class som {
+private:
+    const static std::size_t INDEX_MINIMUM_SIZE;        /**< Minimum amount of neurons when KD-tree is used to find neuron-winner during simulation. */
+    const static std::size_t INDEX_MAXIMUM_DIMENSION;   /**< Maximum dimension of weights when KD-tree is used to find neuron-winner during simulation. */
+
+    const static char           FILE_SIGNATURE[4];      /**< Signature of binary file with SOM network. */
+    const static std::uint32_t  FILE_VERSION;           /**< Version of binary file format. */
+
+private:
+    /*!
+
+    @brief   Offset between two neurons on the grid.
+
+    */
+    struct grid_offset {
+        long long       row;        /**< Difference between row indexes. */
+        long long       col;        /**< Difference between column indexes. */
+        std::size_t     distance;   /**< Square distance between neurons. */
+    };
+
 private:
     /* network description */
     std::size_t m_rows;
@@ -140,7 +181,8 @@ private:
 
     som_conn_type m_conn_type;
 
-    dataset             m_weights;
+    mutable dataset     m_weights;      /* weights of the network that is loaded from binary file are copied on the first request */
+    mutable std::mutex  m_weights_lock; /* protects copying of the mapped weights by 'get_weights' */
     dataset             m_previous_weights;
     som_award_sequence  m_awards;
 
@@ -149,10 +191,22 @@ private:
 
     /* just for convenience (avoid excess calculation during learning) */
     dataset                 m_location;
-    dataset                 m_sqrt_distances;
     som_gain_sequence       m_capture_objects;
     som_neighbor_sequence   m_neighbors;
 
+    /* neighborhood on the grid: offsets are sorted by distance and truncated by the current radius */
+    std::vector<grid_offset>    m_offsets;
+    std::size_t                 m_offsets_in_radius = 0;
+    std::vector<double>         m_influences;           /* influence for each square distance in the current radius */
+
+    /* index over weights of trained network to find neuron-winner during simulation */
+    container::kdtree_balanced  m_index;
+
+    /* binary file that is mapped to memory and weights in it (coordinate 'd' of neuron 'k' is located by index 'd * size + k') */
+    std::shared_ptr<const utils::mapped_file>   m_file;
+    const double *                              m_mapped_weights = nullptr;
+    std::size_t                                 m_mapped_dimension = 0;
+
     /* describe learning process and internal state */
     std::size_t     m_epouchs = 0;
     som_parameters  m_params;
@@ -204,6 +258,23 @@ public:
      */
     std::size_t train(const dataset & input_data, const size_t num_epochs, bool autostop);
 
+    /**
+     *
+     * @brief   Trains self-organized feature map (SOM) using the specified training mode.
+     * @details In case of batch mode neurons-winners for all input patterns are searched in parallel and
+     *           learning rate is not used: each neuron weight is replaced by average of input patterns
+     *           that are weighted by neighborhood function of their winners.
+     *
+     * @param[in] input_data: input dataset for training.
+     * @param[in] num_epochs: number of epochs for training.
+     * @param[in] autostop: stop learining when convergance is too low.
+     * @param[in] p_mode: training mode (online or batch).
+     *
+     * @return  Returns number of learining iterations.
+     *
+     */
+    std::size_t train(const dataset & input_data, const size_t num_epochs, bool autostop, const som_train_mode p_mode);
+
     /**
      *
      * @brief   Initialize SOM network by loading weights.
@@ -219,6 +290,31 @@ public:
      */
     void load(const dataset & p_weights, const som_award_sequence & p_awards, const som_gain_sequence & p_capture_objects);
 
+    /**
+     *
+     * @brief   Stores the network (parameters, weights, awards and captured objects) to versioned binary file.
+     * @details Weights are stored dimension by dimension, so they are used by the network directly from the
+     *           file after loading.
+     *
+     * @param[in] p_filename: path to the file where the network should be stored.
+     *
+     */
+    void save(const std::string & p_filename) const;
+
+    /**
+     *
+     * @brief   Loads the network from binary file that has been created by `save`.
+     * @details The file is mapped to memory and weights are not copied: neuron-winners are searched using weights
+     *           in the mapped file, so processes that load the same file share one read-only weight matrix. Weights
+     *           are copied to the network only if they are requested by `get_weights` or the network is trained again.
+     *           KD-tree index is not created for the mapped weights because it would keep a private copy of them,
+     *           neuron-winner is found by comparison with each neuron in the mapped file.
+     *
+     * @param[in] p_filename: path to the file with the network.
+     *
+     */
+    void load(const std::string & p_filename);
+
     /**
      *
      * @brief   Processes input pattern (no learining) and returns index of neuron-winner.
@@ -231,6 +327,16 @@ public:
      */
     std::size_t simulate(const pattern & input_pattern) const;
 
+    /**
+     *
+     * @brief   Processes input patterns (no learining) in parallel and returns indexes of neurons-winners.
+     *
+     * @param[in] p_patterns: input patterns for processing.
+     * @param[out] p_winners: index of neuron-winner for each input pattern.
+     *
+     */
+    void simulate(const dataset & p_patterns, std::vector<std::size_t> & p_winners) const;
+
     /**
      *
      * @return  Returns number of winner at the last step of learning process.
@@ -250,9 +356,7 @@ public:
     * @return  Constant reference to neurons weights for read-only purposes.
     *
     */
-    inline const dataset & get_weights() const {
-        return m_weights;
-    }
+    const dataset & get_weights() const;
 
     /**
     *
@@ -312,6 +416,30 @@ private:
      */
     void create_initial_weights(const som_init_type type);
 
+    /**
+     *
+     * @brief   Creates offsets to neurons on the grid that can be reached by the initial radius.
+     *
+     */
+    void create_offsets();
+
+    /**
+     *
+     * @brief   Truncates offsets and fills table of influences in line with the current radius.
+     *
+     */
+    void update_neighborhood();
+
+    /**
+     *
+     * @brief   Returns square distance between two neurons on the grid.
+     *
+     * @param[in] p_neuron1: index of the first neuron.
+     * @param[in] p_neuron2: index of the second neuron.
+     *
+     */
+    std::size_t grid_distance_square(const std::size_t p_neuron1, const std::size_t p_neuron2) const;
+
     /**
      *
      * @brief   Returns neuron winner (distance, neuron index).
@@ -324,6 +452,19 @@ private:
      */
     std::size_t competition(const pattern & input_pattern) const;
 
+    /**
+     *
+     * @brief   Returns neuron winner using weights that are stored dimension by dimension.
+     * @details This method can be called from several threads simultaneously.
+     *
+     * @param[in] p_weight_matrix: neuron weights where coordinate 'd' of neuron 'k' is located by index 'd * size + k'.
+     * @param[in] p_pattern: input pattern from the input data set.
+     *
+     * @return  Returns index of neuron that is winner.
+     *
+     */
+    std::size_t competition(const double * p_weight_matrix, const pattern & p_pattern) const;
+
     /**
      *
      * @brief   Change weight of neurons in line with won neuron.
@@ -334,6 +475,25 @@ private:
      */
     std::size_t adaptation(const size_t index_winner, const pattern & input_pattern);
 
+    /**
+     *
+     * @brief   Performs one epoch of online training where weights are adapted after each input pattern.
+     *
+     * @param[in] p_collect: if `true` then awards and captured objects are collected.
+     *
+     */
+    void train_online_epoch(const bool p_collect);
+
+    /**
+     *
+     * @brief   Performs one epoch of batch training: neurons-winners are found for all input patterns and then
+     *           each neuron weight is replaced by neighborhood-weighted average of input patterns.
+     *
+     * @param[in] p_collect: if `true` then awards and captured objects are collected.
+     *
+     */
+    void train_batch_epoch(const bool p_collect);
+
     /**
      *
      * @brief   Returns maximum changes of weight in line with comparison between previous weights
@@ -344,6 +504,29 @@ private:
      */
     double calculate_maximal_adaptation() const;
 
+    /**
+     *
+     * @brief   Creates KD-tree over neuron weights that is used to find neuron-winner during simulation.
+     * @details The index is created only for big maps where it is faster than comparison with each neuron
+     *           and weights are not mapped from file, otherwise the index is cleared.
+     *
+     */
+    void build_index();
+
+    /**
+     *
+     * @brief   Finds neuron-winner in the subtree of the index.
+     * @details Neuron with the smallest index is chosen among neurons with the same distance, so result is
+     *           the same as result of `competition`.
+     *
+     * @param[in] p_node: root of the subtree where neuron-winner is searched.
+     * @param[in] p_pattern: input pattern for processing.
+     * @param[in,out] p_winner: index of current neuron-winner.
+     * @param[in,out] p_distance: square Euclidean distance to the current neuron-winner.
+     *
+     */
+    void find_winner(const container::kdnode::ptr & p_node, const pattern & p_pattern, std::size_t & p_winner, double & p_distance) const;
+
     /**
     *
     * @brief   Calculates appropriate initial radius.
@@ -20,6 +20,7 @@
 #include <pyclustering/differential/runge_kutta_4.hpp>
 #include <pyclustering/differential/runge_kutta_fehlberg_45.hpp>
 
+#include <pyclustering/nnet/collection_policy.hpp>
 #include <pyclustering/nnet/network.hpp>
 
 
@@ -237,6 +238,33 @@ public:
             const std::shared_ptr<adjacency_collection> & p_connections,
             const std::vector<sync_oscillator> & p_oscillators);
 
+    /**
+     *
+     * @brief    Calculates level of local synchronization (order parameter) for input phases of oscillators
+     *            where each oscillator is connected to all other oscillators.
+     * @details  The result is the same as in case of 'calculate_local_sync_order' with all-to-all connections,
+     *            but phases are sorted and contribution of all pairs is accumulated in one pass, therefore
+     *            complexity is O(n * log(n)) instead of O(n^2).
+     *
+     * @param[in]  p_phases: Oscillator phases that are used for calculation.
+     *
+     * @return  Order parameter for the specified state.
+     *
+     */
+    static double calculate_local_sync_order_all_to_all(const std::vector<double> & p_phases);
+
+    /**
+     *
+     * @brief    Calculates level of local synchronization (order parameter) for oscillators where each
+     *            oscillator is connected to all other oscillators.
+     *
+     * @param[in]  p_oscillators: Network oscillators that are used for calculation.
+     *
+     * @return  Order parameter for the specified state.
+     *
+     */
+    static double calculate_local_sync_order_all_to_all(const std::vector<sync_oscillator> & p_oscillators);
+
 private:
     template <class TypeContainer>
     static double calculate_sync_order_parameter(
@@ -248,6 +276,10 @@ private:
             const std::shared_ptr<adjacency_collection> & p_connections,
             const TypeContainer & p_container,
             const phase_getter & p_getter);
+
+    static double calculate_all_to_all_local_sync_order_parameter(
+            const std::size_t p_size,
+            const phase_getter & p_getter);
 };
 
 
@@ -372,6 +404,18 @@ protected:
 private:
     equation<double>  m_equation;
 
+    bool              m_network_integration = true;     /* Kuramoto equation of the network is used, so all oscillators can be integrated by the network integrator */
+    bool              m_kuramoto_equation = true;       /* 'phase_kuramoto' (it might be overridden) is used, so it is integrated by solvers of fixed-size state */
+
+    std::vector<std::size_t>  m_neighbor_offsets;       /* connections in CSR representation: neighbors of oscillator 'i' are in range [m_neighbor_offsets[i], m_neighbor_offsets[i + 1]) */
+    std::vector<std::size_t>  m_neighbor_indexes;
+    std::vector<double>       m_current_phases;         /* phases at the beginning of the current step */
+    std::vector<double>       m_next_phases;
+
+    bool              m_mean_field = false;             /* each oscillator is connected to all others, so coupling is calculated using mean field */
+    double            m_sum_sin = 0.0;                  /* sum of sin(phase) of all oscillators at the beginning of the current step */
+    double            m_sum_cos = 0.0;                  /* sum of cos(phase) of all oscillators at the beginning of the current step */
+
 public:
     /**
      *
@@ -466,6 +510,24 @@ public:
         const bool collect_dynamic,
         sync_dynamic & output_dynamic);
 
+    /**
+     *
+     * @brief   Performs static simulation of oscillatory network where stored steps are defined by the collection policy.
+     *
+     * @param[in]  steps: number steps of simulations during simulation.
+     * @param[in]  time: time of simulation.
+     * @param[in]  solver: type of solver for simulation.
+     * @param[in]  policy: defines which steps are stored and which reductions observe phases of oscillators.
+     * @param[out] output_dynamic: output dynamic of the network.
+     *
+     */
+    void simulate_static(
+        const std::size_t steps,
+        const double time,
+        const solve_type solver,
+        const collection_policy & policy,
+        sync_dynamic & output_dynamic);
+
     /**
      *
      * @brief   Performs dynamic simulation of oscillatory network until stop condition is not
@@ -491,6 +553,24 @@ public:
         const bool collect_dynamic,
         sync_dynamic & output_dynamic);
 
+    /**
+     *
+     * @brief   Performs dynamic simulation of oscillatory network where stored steps are defined by the collection policy.
+     *
+     * @param[in]  order: order of process synchronization, distributed 0..1.
+     * @param[in]  step: time step of one iteration of simulation.
+     * @param[in]  solver: type of solver for simulation.
+     * @param[in]  policy: defines which steps are stored and which reductions observe phases of oscillators.
+     * @param[out] output_dynamic: output dynamic of the network.
+     *
+     */
+    void simulate_dynamic(
+        const double order,
+        const double step,
+        const solve_type solver,
+        const collection_policy & policy,
+        sync_dynamic & output_dynamic);
+
     /**
      *
      * @brief   Returns size of the oscillatory network that is defined by amount of oscillators.
@@ -605,15 +685,95 @@ protected:
         const bool collect_dynamic, 
         sync_dynamic & output_dynamic) const;
 
+    /**
+    *
+    * @brief   Stores phases of oscillators in line with the collection policy of the collector.
+    *
+    * @param[in]     time: timestamp that corresponds time point when dyncamic is collected.
+    * @param[in,out] collector: collector that defines where the current state should be stored.
+    * @param[out]    output_dynamic: storage of output dynamic.
+    *
+    */
+    void store_dynamic(
+        const double time,
+        dynamic_collector & collector,
+        sync_dynamic & output_dynamic) const;
+
     /**
     *
     * @brief   Set phase oscillator equation that is used to calculate state of each oscillator in the network.
+    * @details Once the equation is replaced, each oscillator is integrated separately by the generic solver
+    *           instead of the network integrator of the Kuramoto model.
     *
     * @param[in]  solver: equation of phase oscillator.
     *
     */
     virtual void set_equation(const equation<double> & solver);
 
+    /**
+    *
+    * @brief   Disables the network integrator of the Kuramoto model when 'phase_kuramoto' is overridden by the derived network.
+    * @details Each oscillator is integrated separately using the overridden 'phase_kuramoto', the Runge-Kutta-Fehlberg
+    *           solver calls it without 'std::function' and allocation of stage states.
+    *
+    */
+    void disable_network_integration();
+
+private:
+    /*!
+
+    @brief   Creates CSR representation of connections that is used by the network integrator.
+    @details In case of all-to-all connections the CSR representation is not created, coupling is calculated
+              using mean field instead.
+
+    */
+    void create_neighbor_arrays();
+
+    /*!
+
+    @brief   Calculates new phases of all oscillators by Runge-Kutta 4 method using CSR representation of connections.
+    @details Phases of neighbors are fixed during the step as well as in case of integration of each oscillator by
+              the generic solver, therefore the result is the same, but there are no allocations and indirect calls
+              during integration.
+
+    @param[in] t: time of simulation.
+    @param[in] step: step of solution at the end of which states of oscillators should be calculated.
+    @param[in] int_step: step differentiation that is used for solving differential equation.
+
+    */
+    void calculate_phases_network(const double t, const double step, const double int_step);
+
+    /*!
+
+    @brief   Calculates derivative of oscillator phase using Kuramoto model and CSR representation of connections.
+
+    @param[in] p_index: index of the oscillator.
+    @param[in] p_teta: current value of phase of the oscillator.
+
+    */
+    double phase_kuramoto_network(const std::size_t p_index, const double p_teta) const;
+
+    /*!
+
+    @brief   Calculates sums of sin(phase) and cos(phase) of all oscillators that are used as mean field.
+
+    */
+    void calculate_mean_field();
+
+    /*!
+
+    @brief   Calculates derivative of oscillator phase using Kuramoto model and mean field of its neighbors.
+    @details Sum of sin(phase_j - teta) over neighbors is equal to Im(sum(exp(i * phase_j)) * exp(-i * teta)),
+              therefore it is calculated in O(1) instead of O(n).
+
+    @param[in] p_index: index of the oscillator.
+    @param[in] p_teta: current value of phase of the oscillator.
+    @param[in] p_neighbors_sin: sum of sin(phase) of neighbors of the oscillator.
+    @param[in] p_neighbors_cos: sum of cos(phase) of neighbors of the oscillator.
+
+    */
+    double phase_kuramoto_mean_field(const std::size_t p_index, const double p_teta, const double p_neighbors_sin, const double p_neighbors_cos) const;
+
 private:
     /*!
     
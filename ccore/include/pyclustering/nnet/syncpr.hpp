@@ -43,6 +43,9 @@ protected:
     double m_increase_strength2;
     matrix m_coupling;
 
+private:
+    std::vector<double> m_derivatives;      /* derivatives of oscillator phases that are calculated at the beginning of the current step */
+
 public:
     syncpr(const unsigned int num_osc, 
            const double increase_strength1, 
@@ -76,6 +79,8 @@ public:
     double memory_order(const syncpr_pattern & input_pattern) const;
 
 protected:
+    void calculate_phases(const solve_type solver, const double t, const double step, const double int_step) override;
+
     double phase_kuramoto(const double t, const double teta, const std::vector<void *> & argv) const override;
 
     void phase_kuramoto_equation(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) const override;
@@ -86,6 +91,8 @@ private:
     void initialize_phases(const syncpr_pattern & sample);
 
     double calculate_memory_order(const syncpr_pattern & input_pattern) const;
+
+    void calculate_derivatives();
 };
 
 
@@ -39,6 +39,72 @@ const std::size_t AMOUNT_HARDWARE_THREADS = std::thread::hardware_concurrency();
 const std::size_t AMOUNT_THREADS = (AMOUNT_HARDWARE_THREADS > 1) ? (AMOUNT_HARDWARE_THREADS - 1) : 0;
 
 
+/*!
+
+@brief Returns reference to the flag that marks the current thread as a thread that executes a body of a parallel loop.
+@details The flag is used by `parallel_for` and `parallel_for_each` to execute nested loops in the calling thread
+          instead of spawning new threads for each of them, thus outer loop (for example, over K values) and inner
+          loops (for example, K-Means assignment step) share the same amount of threads without oversubscription.
+
+@return Reference to the thread local flag of the current thread.
+
+*/
+inline bool & parallel_region_flag() {
+    static thread_local bool inside_region = false;
+    return inside_region;
+}
+
+
+/*!
+
+@brief Returns `true` if the current thread executes a body of a parallel loop.
+
+@return `true` if the current thread is inside parallel region.
+
+*/
+inline bool is_parallel_region() {
+    return parallel_region_flag();
+}
+
+
+/*!
+
+@class parallel_region_guard parallel.hpp pyclustering/parallel/parallel.hpp
+
+@brief Marks the current thread as a thread that executes a body of a parallel loop during the lifetime of the guard.
+
+*/
+class parallel_region_guard {
+private:
+    bool m_previous = false;
+
+public:
+    /*!
+
+    @brief Marks the current thread as a thread that is inside parallel region.
+
+    */
+    parallel_region_guard() :
+        m_previous(parallel_region_flag())
+    {
+        parallel_region_flag() = true;
+    }
+
+    parallel_region_guard(const parallel_region_guard & p_other) = delete;
+
+    parallel_region_guard(parallel_region_guard && p_other) = delete;
+
+    /*!
+
+    @brief Restores previous state of the current thread.
+
+    */
+    ~parallel_region_guard() {
+        parallel_region_flag() = m_previous;
+    }
+};
+
+
 /*!
 
 @brief Parallelizes for-loop using all available cores.
@@ -80,6 +146,15 @@ void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeInde
         return;     /* There are no work for threads. */
     }
 
+    if ((p_threads < 2) || is_parallel_region()) {
+        /* Nested loop or single core - threads of the outer loop are already busy. */
+        parallel_region_guard guard;
+        for (TypeIndex i = p_start; i < p_end; i += p_step) {
+            p_task(i);
+        }
+        return;
+    }
+
     if ((interval_length > 0) && (interval_length <= p_step)) {
         p_task(p_start);    /* There is only one iteration in the loop. */
         return;
@@ -106,20 +181,23 @@ void parallel_for(const TypeIndex p_start, const TypeIndex p_end, const TypeInde
     */
     for (std::size_t i = 0; (i < static_cast<TypeIndex>(p_threads) - 1) && (current_end < p_end); ++i) {
         const auto async_task = [&p_task, current_start, current_end, p_step](){
+            parallel_region_guard guard;
             for (TypeIndex i = current_start; i < current_end; i += p_step) {
                 p_task(i);
             }
         };
-        /* There was an optimization for nested 'parallel_for' loops, but the maximum depth in the current library is 2.
-           If the optimization is needed - get it from repository (versions that are <= 0.10.0.1). */
+
         future_storage.push_back(std::async(std::launch::async, async_task));
 
         current_start = current_end;
         current_end += interval_thread_length;
     }
 
-    for (TypeIndex i = current_start; i < p_end; i += p_step) {
-        p_task(i);
+    {
+        parallel_region_guard guard;
+        for (TypeIndex i = current_start; i < p_end; i += p_step) {
+            p_task(i);
+        }
     }
 
     for (auto & feature : future_storage) {
@@ -196,6 +274,15 @@ void parallel_for_each(const TypeIter p_begin, const TypeIter p_end, const TypeA
         return;
     }
 
+    if ((p_threads < 2) || is_parallel_region()) {
+        /* Nested loop or single core - threads of the outer loop are already busy. */
+        parallel_region_guard guard;
+        for (auto iter = p_begin; iter != p_end; ++iter) {
+            p_task(*iter);
+        }
+        return;
+    }
+
     const std::size_t step = std::max(interval_length / p_threads, std::size_t(1));
 
     std::size_t amount_threads = static_cast<std::size_t>(interval_length / step);
@@ -213,6 +300,7 @@ void parallel_for_each(const TypeIter p_begin, const TypeIter p_end, const TypeA
 
     for (std::size_t i = 0; i < amount_threads; ++i) {
         auto async_task = [&p_task, current_start, current_end](){
+            parallel_region_guard guard;
             for (auto iter = current_start; iter != current_end; ++iter) {
                 p_task(*iter);
             }
@@ -224,8 +312,11 @@ void parallel_for_each(const TypeIter p_begin, const TypeIter p_end, const TypeA
         current_end += step;
     }
 
-    for (auto iter = current_start; iter != p_end; ++iter) {
-        p_task(*iter);
+    {
+        parallel_region_guard guard;
+        for (auto iter = current_start; iter != p_end; ++iter) {
+            p_task(*iter);
+        }
     }
 
     for (auto & feature : future_storage) {
@@ -0,0 +1,92 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+
+
+namespace pyclustering {
+
+namespace utils {
+
+
+/*!
+
+@class    mapped_file mapped_file.hpp pyclustering/utils/mapped_file.hpp
+
+@brief    Read-only memory mapping of a file.
+@details  Content of the file is not copied to the process memory, pages of the file are shared between all
+           processes that map the same file.
+
+*/
+class mapped_file {
+private:
+    const char *    m_data = nullptr;
+    std::size_t     m_size = 0;
+
+#if defined(WIN32) || (_WIN32) || (_WIN64)
+    void *          m_file = nullptr;
+    void *          m_mapping = nullptr;
+#endif
+
+public:
+    /*!
+
+    @brief    Maps the specified file to memory for reading.
+
+    @param[in] p_filename: path to the file that should be mapped.
+
+    */
+    explicit mapped_file(const std::string & p_filename);
+
+    /*!
+
+    @brief    Mapped file cannot be copied.
+
+    */
+    mapped_file(const mapped_file & p_other) = delete;
+
+    /*!
+
+    @brief    Unmaps the file.
+
+    */
+    ~mapped_file();
+
+public:
+    /*!
+
+    @brief    Returns pointer to the content of the file.
+
+    */
+    const char * data() const;
+
+    /*!
+
+    @brief    Returns size of the file in bytes.
+
+    */
+    std::size_t size() const;
+
+public:
+    /*!
+
+    @brief    Mapped file cannot be copied.
+
+    */
+    mapped_file & operator=(const mapped_file & p_other) = delete;
+};
+
+
+}
+
+}
@@ -28,6 +28,24 @@ namespace metric {
 
 
 
+/*!
+
+@brief   Defines type of distance metric that allows to use specialized (bulk) distance calculation for known metrics.
+
+*/
+enum class distance_metric_type {
+    EUCLIDEAN = 0,          /**< Euclidean distance metric. */
+    EUCLIDEAN_SQUARE,       /**< Square Euclidean distance metric. */
+    MANHATTAN,              /**< Manhattan distance metric. */
+    CHEBYSHEV,              /**< Chebyshev distance metric. */
+    MINKOWSKI,              /**< Minkowski distance metric. */
+    CANBERRA,               /**< Canberra distance metric. */
+    CHI_SQUARE,             /**< Chi square distance metric. */
+    GOWER,                  /**< Gower distance metric. */
+    USER_DEFINED = 1000     /**< User-defined distance metric. */
+};
+
+
 /*!
 
 @brief   Encapsulates distance metric calculation function between two objects.
@@ -259,6 +277,8 @@ class distance_metric {
 protected:
     distance_functor<TypeContainer> m_functor = nullptr;    /**< Function that defines metric calculation. */
 
+    distance_metric_type m_type = distance_metric_type::USER_DEFINED;  /**< Type of the metric that is defined by the function. */
+
 public:
     /*!
     
@@ -276,6 +296,19 @@ public:
     */
     explicit distance_metric(const distance_functor<TypeContainer> & p_functor) : m_functor(p_functor) { }
 
+    /*!
+
+    @brief  Parameterized constructor of distance metric whose type is known.
+
+    @param[in] p_functor: function that defines how to calculate distance metric.
+    @param[in] p_type: type of the metric that is defined by the function.
+
+    */
+    distance_metric(const distance_functor<TypeContainer> & p_functor, const distance_metric_type p_type) :
+        m_functor(p_functor),
+        m_type(p_type)
+    { }
+
     /*!
     
     @brief  Default copy constructor of distance metric.
@@ -329,6 +362,15 @@ public:
         return m_functor != nullptr;
     }
 
+    /*!
+
+    @brief  Returns type of the distance metric (`distance_metric_type::USER_DEFINED` for user-defined functions).
+
+    */
+    distance_metric_type type() const {
+        return m_type;
+    }
+
     /*!
     
     @brief  Assignment operator to copy distance metric.
@@ -341,6 +383,7 @@ public:
     distance_metric<TypeContainer>& operator=(const distance_metric<TypeContainer>& p_other) {
         if (this != &p_other) {
             m_functor = p_other.m_functor;
+            m_type = p_other.m_type;
         }
 
         return *this;
@@ -366,7 +409,7 @@ public:
     
     */
     euclidean_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(euclidean_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(std::bind(euclidean_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2), distance_metric_type::EUCLIDEAN)
     { }
 };
 
@@ -389,7 +432,7 @@ public:
 
     */
     euclidean_distance_square_metric() :
-        distance_metric<TypeContainer>(std::bind(euclidean_distance_square<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(std::bind(euclidean_distance_square<TypeContainer>, std::placeholders::_1, std::placeholders::_2), distance_metric_type::EUCLIDEAN_SQUARE)
     { }
 };
 
@@ -412,7 +455,7 @@ public:
 
     */
     manhattan_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(manhattan_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(std::bind(manhattan_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2), distance_metric_type::MANHATTAN)
     { }
 };
 
@@ -438,7 +481,7 @@ public:
     
     */
     chebyshev_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(chebyshev_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(std::bind(chebyshev_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2), distance_metric_type::CHEBYSHEV)
     { }
 };
 
@@ -463,7 +506,7 @@ public:
 
     */
     explicit minkowski_distance_metric(const double p_degree) :
-        distance_metric<TypeContainer>(std::bind(minkowski_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2, p_degree))
+        distance_metric<TypeContainer>(std::bind(minkowski_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2, p_degree), distance_metric_type::MINKOWSKI)
     { }
 };
 
@@ -486,7 +529,7 @@ public:
 
     */
     canberra_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(canberra_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(std::bind(canberra_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2), distance_metric_type::CANBERRA)
     { }
 };
 
@@ -509,7 +552,7 @@ public:
 
     */
     chi_square_distance_metric() :
-        distance_metric<TypeContainer>(std::bind(chi_square_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2))
+        distance_metric<TypeContainer>(std::bind(chi_square_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2), distance_metric_type::CHI_SQUARE)
     { }
 };
 
@@ -543,7 +586,7 @@ public:
 
     */
     explicit gower_distance_metric(const TypeContainer & p_max_range) :
-        distance_metric<TypeContainer>(std::bind(gower_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2, p_max_range))
+        distance_metric<TypeContainer>(std::bind(gower_distance<TypeContainer>, std::placeholders::_1, std::placeholders::_2, p_max_range), distance_metric_type::GOWER)
     { }
 };
 
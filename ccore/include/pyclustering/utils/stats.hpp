@@ -152,11 +152,77 @@ std::vector<double> pdf(const TypeContainer & p_data) {
  */
 template <class TypeContainer>
 std::vector<double> cdf(const TypeContainer & p_data) {
-    std::vector<double> result;
-    result.reserve(p_data.size());
+    std::vector<double> result(p_data.size());
 
-    for (auto & value : p_data) {
-        result.push_back(0.5 * std::erfc(-value * SQRT_0_5));
+    auto iter_data = std::begin(p_data);
+    for (std::size_t i = 0; i < result.size(); ++i, ++iter_data) {
+        result[i] = 0.5 * std::erfc(-(*iter_data) * SQRT_0_5);
+    }
+
+    return result;
+}
+
+
+/**
+ *
+ * @brief   Places order statistics with specified ranks on their positions as if the data was sorted.
+ * @details Only the data between ranks is partially ordered using selection, therefore complexity is
+ *           O(n * log(m)) where 'n' is a size of the data and 'm' is amount of ranks.
+ *
+ * @param[in] p_begin: iterator to the begin of the data.
+ * @param[in] p_end: iterator to the end of the data.
+ * @param[in] p_ranks: sorted ranks that should be placed on their positions.
+ * @param[in] p_first: index of the first rank that should be processed.
+ * @param[in] p_last: index of the rank that follows the last one that should be processed.
+ * @param[in] p_offset: rank of the element that is pointed by 'p_begin'.
+ *
+ */
+template <class TypeIterator>
+void select_ranks(TypeIterator p_begin, TypeIterator p_end, const std::vector<std::size_t> & p_ranks, const std::size_t p_first, const std::size_t p_last, const std::size_t p_offset) {
+    if ((p_first >= p_last) || (p_begin == p_end)) {
+        return;
+    }
+
+    const std::size_t middle = p_first + (p_last - p_first) / 2;
+    const TypeIterator nth = p_begin + (p_ranks[middle] - p_offset);
+
+    std::nth_element(p_begin, nth, p_end);
+
+    select_ranks(p_begin, nth, p_ranks, p_first, middle, p_offset);
+    select_ranks(nth + 1, p_end, p_ranks, middle + 1, p_last, p_ranks[middle] + 1);
+}
+
+
+/**
+ *
+ * @brief   Calculates evenly spaced quantiles of the data (quantile sketch of the data).
+ * @details The sketch is used instead of the full sorted data in case of huge data, the data is partially reordered.
+ *
+ * @param[in,out] p_data: data whose quantiles should be calculated.
+ * @param[in] p_amount: amount of quantiles, if it is not less than size of the data then sorted data is returned.
+ *
+ * @return  Sorted quantiles of the data.
+ *
+ */
+template <class TypeContainer>
+TypeContainer quantiles(TypeContainer & p_data, const std::size_t p_amount) {
+    const std::size_t length = p_data.size();
+    if (p_amount >= length) {
+        TypeContainer result = p_data;
+        std::sort(std::begin(result), std::end(result));
+        return result;
+    }
+
+    std::vector<std::size_t> ranks(p_amount);
+    for (std::size_t i = 0; i < p_amount; ++i) {
+        ranks[i] = static_cast<std::size_t>((static_cast<double>(i) + 0.5) * static_cast<double>(length) / static_cast<double>(p_amount));
+    }
+
+    select_ranks(std::begin(p_data), std::end(p_data), ranks, 0, ranks.size(), 0);
+
+    TypeContainer result(p_amount);
+    for (std::size_t i = 0; i < p_amount; ++i) {
+        result[i] = p_data[ranks[i]];
     }
 
     return result;
@@ -189,7 +255,6 @@ double anderson(const TypeContainer & p_data) {
 
     double s = 0.0;
     const std::size_t n = p_data.size();
-
     for (std::size_t i = 0; i < n; ++i) {
         const double k = 2.0 * (static_cast<double>(i) + 1.0) - 1.0;
         s += k * (std::log(y[i]) + std::log(1.0 - y[n - i - 1]));
@@ -200,7 +265,6 @@ double anderson(const TypeContainer & p_data) {
 }
 
 
-
 /**
  *
  * @brief   Calculates critical values for data with Gaussian distribution for the following 
@@ -27,52 +27,59 @@ bsas::bsas(const std::size_t p_amount,
 void bsas::process(const dataset & p_data, bsas_data & p_result) {
     m_result_ptr = &p_result;
 
-    cluster_sequence & clusters = m_result_ptr->clusters();
-    representative_sequence & representatives = m_result_ptr->representatives();
-
-    clusters.push_back({ 0 });
-    representatives.push_back( p_data[0] );
+    initialize(p_data);
 
+    cluster_sequence & clusters = m_result_ptr->clusters();
     for (std::size_t i = 1; i < p_data.size(); i++) {
         auto nearest = find_nearest_cluster(p_data[i]);
 
         if ( (nearest.m_distance > m_threshold) && (clusters.size() < m_amount) ) {
-            representatives.push_back(p_data[i]);
-            clusters.push_back({ i });
+            allocate_cluster(i, p_data[i]);
         }
         else {
             clusters[nearest.m_index].push_back(i);
             update_representative(nearest.m_index, p_data[i]);
         }
     }
+
+    finalize();
 }
 
 
 bsas::nearest_cluster bsas::find_nearest_cluster(const point & p_point) const {
     bsas::nearest_cluster result;
-
-    for (std::size_t i = 0; i < m_result_ptr->clusters().size(); i++) {
-        double distance = m_metric(p_point, m_result_ptr->representatives()[i]);
-        if (distance < result.m_distance) {
-            result.m_distance = distance;
-            result.m_index = i;
-        }
-    }
-
+    result.m_index = m_representatives.find_nearest(p_point, result.m_distance);
     return result;
 }
 
 
 void bsas::update_representative(const std::size_t p_index, const point & p_point) {
     auto len = static_cast<double>(m_result_ptr->clusters().size());
-    auto & rep = m_result_ptr->representatives()[p_index];
 
-    for (std::size_t dim = 0; dim < rep.size(); dim++) {
-        rep[dim] = ( (len - 1) * rep[dim] + p_point[dim] ) / len;
+    for (std::size_t dim = 0; dim < m_representatives.dimension(); dim++) {
+        double & coordinate = m_representatives.at(p_index, dim);
+        coordinate = ( (len - 1) * coordinate + p_point[dim] ) / len;
     }
 }
 
 
+void bsas::initialize(const dataset & p_data) {
+    m_representatives = representative_matrix(p_data[0].size(), m_metric);
+    allocate_cluster(0, p_data[0]);
+}
+
+
+void bsas::allocate_cluster(const std::size_t p_index_point, const point & p_point) {
+    m_result_ptr->clusters().push_back({ p_index_point });
+    m_representatives.append(p_point);
+}
+
+
+void bsas::finalize() {
+    m_representatives.extract(m_result_ptr->representatives());
+    m_representatives = representative_matrix();
+}
+
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/bsas_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+const char          bsas_stream::STATE_SIGNATURE[4]     = { 'B', 'S', 'A', 'S' };
+const std::uint32_t bsas_stream::STATE_VERSION          = 1;
+
+
+template <typename TypeValue>
+static void write_value(const TypeValue & p_value, bsas_stream_state & p_state) {
+    const std::size_t position = p_state.size();
+    p_state.resize(position + sizeof(TypeValue));
+    std::memcpy(p_state.data() + position, &p_value, sizeof(TypeValue));
+}
+
+
+template <typename TypeValue>
+static TypeValue read_value(const bsas_stream_state & p_state, std::size_t & p_position) {
+    if (p_position + sizeof(TypeValue) > p_state.size()) {
+        throw std::invalid_argument("bsas_stream: state is corrupted (unexpected end of the state at position '" + std::to_string(p_position) + "').");
+    }
+
+    TypeValue value;
+    std::memcpy(&value, p_state.data() + p_position, sizeof(TypeValue));
+    p_position += sizeof(TypeValue);
+
+    return value;
+}
+
+
+bsas_stream::bsas_stream(const std::size_t p_amount, const double p_threshold, const distance_metric<point> & p_metric) :
+    m_amount(p_amount),
+    m_threshold(p_threshold),
+    m_metric(p_metric)
+{ }
+
+
+std::size_t bsas_stream::push(const point & p_point) {
+    if (m_representatives.empty()) {
+        m_representatives = representative_matrix(p_point.size(), m_metric);
+    }
+    else if (p_point.size() != m_representatives.dimension()) {
+        throw std::invalid_argument("bsas_stream: dimension of the point '" + std::to_string(p_point.size()) +
+            "' is not equal to dimension of the stream '" + std::to_string(m_representatives.dimension()) + "'.");
+    }
+
+    double distance = 0.0;
+    const std::size_t index_nearest = m_representatives.find_nearest(p_point, distance);
+
+    if ((index_nearest == (std::size_t) -1) || ((distance > m_threshold) && (m_sizes.size() < m_amount))) {
+        m_representatives.append(p_point);
+        m_sizes.push_back(1);
+
+        return m_sizes.size() - 1;
+    }
+
+    m_sizes[index_nearest]++;
+    update_representative(index_nearest, p_point);
+
+    return index_nearest;
+}
+
+
+void bsas_stream::push_batch(const dataset & p_points, index_sequence & p_labels) {
+    p_labels.resize(p_points.size());
+    for (std::size_t i = 0; i < p_points.size(); i++) {
+        p_labels[i] = push(p_points[i]);
+    }
+}
+
+
+std::size_t bsas_stream::size() const {
+    return m_sizes.size();
+}
+
+
+const std::vector<std::size_t> & bsas_stream::cluster_sizes() const {
+    return m_sizes;
+}
+
+
+void bsas_stream::get_representatives(representative_sequence & p_representatives) const {
+    m_representatives.extract(p_representatives);
+}
+
+
+void bsas_stream::save(bsas_stream_state & p_state) const {
+    p_state.clear();
+    for (const char symbol : STATE_SIGNATURE) {
+        p_state.push_back(symbol);
+    }
+
+    write_value(STATE_VERSION, p_state);
+    write_value(static_cast<std::uint32_t>(m_metric.type()), p_state);
+    write_value(static_cast<std::uint64_t>(m_amount), p_state);
+    write_value(m_threshold, p_state);
+    write_value(static_cast<std::uint64_t>(m_representatives.dimension()), p_state);
+    write_value(static_cast<std::uint64_t>(m_sizes.size()), p_state);
+
+    for (std::size_t index_cluster = 0; index_cluster < m_sizes.size(); index_cluster++) {
+        write_value(static_cast<std::uint64_t>(m_sizes[index_cluster]), p_state);
+
+        for (std::size_t index_dimension = 0; index_dimension < m_representatives.dimension(); index_dimension++) {
+            write_value(m_representatives.at(index_cluster, index_dimension), p_state);
+        }
+    }
+}
+
+
+void bsas_stream::load(const bsas_stream_state & p_state) {
+    if ((p_state.size() < sizeof(STATE_SIGNATURE)) || !std::equal(std::begin(STATE_SIGNATURE), std::end(STATE_SIGNATURE), p_state.begin())) {
+        throw std::invalid_argument("bsas_stream: state does not have BSAS stream signature.");
+    }
+
+    std::size_t position = sizeof(STATE_SIGNATURE);
+
+    const auto version = read_value<std::uint32_t>(p_state, position);
+    if (version != STATE_VERSION) {
+        throw std::invalid_argument("bsas_stream: unsupported version of the state '" + std::to_string(version) + "'.");
+    }
+
+    const auto metric_type = read_value<std::uint32_t>(p_state, position);
+    if (metric_type != static_cast<std::uint32_t>(m_metric.type())) {
+        throw std::invalid_argument("bsas_stream: state has been created using another metric (type '" + std::to_string(metric_type) + "').");
+    }
+
+    const auto amount = static_cast<std::size_t>(read_value<std::uint64_t>(p_state, position));
+    const auto threshold = read_value<double>(p_state, position);
+    const auto dimension = static_cast<std::size_t>(read_value<std::uint64_t>(p_state, position));
+    const auto amount_clusters = static_cast<std::size_t>(read_value<std::uint64_t>(p_state, position));
+
+    const std::size_t limit = p_state.size() - position;   /* representatives cannot be bigger than the rest of the state */
+    if ( (dimension > limit / sizeof(double)) || (amount_clusters > limit / (sizeof(std::uint64_t) + dimension * sizeof(double))) ) {
+        throw std::invalid_argument("bsas_stream: amount of clusters '" + std::to_string(amount_clusters) + "' with dimension '" +
+            std::to_string(dimension) + "' does not correspond to size of the state '" + std::to_string(p_state.size()) + "'.");
+    }
+
+    const std::size_t expected_size = position + amount_clusters * (sizeof(std::uint64_t) + dimension * sizeof(double));
+    if (expected_size != p_state.size()) {
+        throw std::invalid_argument("bsas_stream: size of the state '" + std::to_string(p_state.size()) +
+            "' does not correspond to its content (expected '" + std::to_string(expected_size) + "').");
+    }
+
+    representative_matrix representatives(dimension, m_metric);
+    std::vector<std::size_t> sizes(amount_clusters, 0);
+
+    point representative(dimension, 0.0);
+    for (std::size_t index_cluster = 0; index_cluster < amount_clusters; index_cluster++) {
+        sizes[index_cluster] = static_cast<std::size_t>(read_value<std::uint64_t>(p_state, position));
+
+        for (std::size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
+            representative[index_dimension] = read_value<double>(p_state, position);
+        }
+
+        representatives.append(representative);
+    }
+
+    m_amount = amount;
+    m_threshold = threshold;
+    m_representatives = std::move(representatives);
+    m_sizes = std::move(sizes);
+}
+
+
+void bsas_stream::update_representative(const std::size_t p_index, const point & p_point) {
+    const auto len = static_cast<double>(m_sizes[p_index]);
+
+    for (std::size_t dim = 0; dim < m_representatives.dimension(); dim++) {
+        double & coordinate = m_representatives.at(p_index, dim);
+        coordinate = ( (len - 1) * coordinate + p_point[dim] ) / len;
+    }
+}
+
+
+}
+
+}
@@ -8,7 +8,20 @@
 
 #include <pyclustering/cluster/clique.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <algorithm>
+#include <bitset>
 #include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+
+using namespace pyclustering::parallel;
 
 
 namespace pyclustering {
@@ -46,16 +59,29 @@ coordinate_iterator & coordinate_iterator::operator++() {
 }
 
 
-clique::clique(const std::size_t p_intervals, const std::size_t p_threshold) :
+const std::size_t clique::MAXIMUM_DENSE_GRID_SIZE = 1000000;
+
+
+clique::clique(const std::size_t p_intervals, const std::size_t p_threshold, const clique_mode p_mode) :
     m_intervals(p_intervals),
-    m_density_threshold(p_threshold)
-{ }
+    m_density_threshold(p_threshold),
+    m_mode(p_mode)
+{
+    if (m_intervals == 0) {
+        throw std::invalid_argument("clique: amount of intervals should be greater than 0.");
+    }
+}
 
 
 void clique::process(const dataset & p_data, clique_data & p_result) {
     m_data_ptr   = &p_data;
     m_result_ptr = &p_result;
 
+    if (m_mode == clique_mode::SUBSPACES) {
+        process_subspaces();
+        return;
+    }
+
     create_grid();
 
     for (auto & block : m_result_ptr->blocks()) {
@@ -65,6 +91,270 @@ void clique::process(const dataset & p_data, clique_data & p_result) {
     }
 
     m_cells_map.clear();
+    m_strides.clear();
+}
+
+
+void clique::process_subspaces() {
+    clique::data_info info;
+    get_data_info(info);
+
+    const std::size_t dimension = m_data_ptr->at(0).size();
+
+    dense_unit_sequence units;
+    find_dense_units(info, units);
+
+    for (std::size_t subspace_dimension = 1; !units.empty(); subspace_dimension++) {
+        allocate_subspace_clusters(units);
+
+        if (subspace_dimension == dimension) {
+            break;
+        }
+
+        dense_unit_sequence candidates;
+        generate_dense_units(units, candidates);
+
+        units = std::move(candidates);
+    }
+
+    /* subspace clusters are ordered by dimensionality of subspaces */
+    const auto & subspace_clusters = m_result_ptr->subspace_clusters();
+    const std::size_t maximum_dimension = subspace_clusters.empty() ? 0 : subspace_clusters.back().dimensions.size();
+
+    std::vector<std::size_t> candidates;
+    for (std::size_t index_cluster = 0; index_cluster < subspace_clusters.size(); index_cluster++) {
+        if (subspace_clusters[index_cluster].dimensions.size() == maximum_dimension) {
+            candidates.push_back(index_cluster);
+        }
+    }
+
+    /* clusters of different subspaces might overlap, each point is assigned to the biggest cluster that contains it */
+    std::stable_sort(candidates.begin(), candidates.end(), [&subspace_clusters](const std::size_t p_first, const std::size_t p_second) {
+        return subspace_clusters[p_first].points.size() > subspace_clusters[p_second].points.size();
+    });
+
+    std::vector<bool> assigned(m_data_ptr->size(), false);
+    for (const std::size_t index_cluster : candidates) {
+        cluster points;
+        for (const auto index_point : subspace_clusters[index_cluster].points) {
+            if (!assigned[index_point]) {
+                assigned[index_point] = true;
+                points.push_back(index_point);
+            }
+        }
+
+        if (!points.empty()) {
+            m_result_ptr->clusters().push_back(std::move(points));
+        }
+    }
+
+    for (std::size_t index_point = 0; index_point < assigned.size(); index_point++) {
+        if (!assigned[index_point]) {
+            m_result_ptr->noise().push_back(index_point);
+        }
+    }
+}
+
+
+void clique::find_dense_units(const clique::data_info & p_info, dense_unit_sequence & p_units) const {
+    const dataset & data = *m_data_ptr;
+    const std::size_t dimension = data[0].size();
+    const std::size_t amount_words = get_bitmap_size(data.size());
+
+    std::vector<dense_unit_sequence> units_by_dimension(dimension);
+
+    parallel_for(std::size_t(0), dimension, [this, &data, &p_info, &units_by_dimension, amount_words](const std::size_t p_dimension) {
+        std::vector<std::size_t> intervals(data.size());
+        std::vector<std::size_t> support(m_intervals, 0);
+
+        for (std::size_t index_point = 0; index_point < data.size(); index_point++) {
+            intervals[index_point] = get_interval(data[index_point][p_dimension], p_dimension, p_info);
+            support[intervals[index_point]]++;
+        }
+
+        /* bitmaps are created only for dense units */
+        std::vector<std::size_t> positions(m_intervals, std::numeric_limits<std::size_t>::max());
+        dense_unit_sequence & units = units_by_dimension[p_dimension];
+
+        for (std::size_t interval = 0; interval < m_intervals; interval++) {
+            if (support[interval] > m_density_threshold) {
+                positions[interval] = units.size();
+                units.push_back({ { p_dimension }, { interval }, point_bitmap(amount_words, 0) });
+            }
+        }
+
+        for (std::size_t index_point = 0; index_point < data.size(); index_point++) {
+            const std::size_t position = positions[intervals[index_point]];
+            if (position != std::numeric_limits<std::size_t>::max()) {
+                set_bitmap_bit(units[position].m_points, index_point);
+            }
+        }
+    });
+
+    for (auto & units : units_by_dimension) {
+        std::move(units.begin(), units.end(), std::back_inserter(p_units));
+    }
+}
+
+
+void clique::generate_dense_units(const dense_unit_sequence & p_units, dense_unit_sequence & p_candidates) const {
+    /* units with the same prefix (all dimensions and intervals except the last) are joined */
+    std::map<std::vector<std::size_t>, std::vector<std::size_t>> groups;
+    std::set<std::vector<std::size_t>> dense_keys;
+
+    for (std::size_t index_unit = 0; index_unit < p_units.size(); index_unit++) {
+        const dense_unit & unit = p_units[index_unit];
+
+        groups[get_unit_key(unit.m_dimensions, unit.m_intervals, unit.m_dimensions.size() - 1)].push_back(index_unit);
+        dense_keys.insert(get_unit_key(unit.m_dimensions, unit.m_intervals, unit.m_dimensions.size()));
+    }
+
+    dense_unit_sequence candidates;
+    std::vector<std::pair<std::size_t, std::size_t>> parents;
+
+    for (const auto & group : groups) {
+        for (const std::size_t index_first : group.second) {
+            for (const std::size_t index_second : group.second) {
+                const dense_unit & first = p_units[index_first];
+                const dense_unit & second = p_units[index_second];
+
+                if (first.m_dimensions.back() >= second.m_dimensions.back()) {
+                    continue;
+                }
+
+                dense_unit candidate = { first.m_dimensions, first.m_intervals, { } };
+                candidate.m_dimensions.push_back(second.m_dimensions.back());
+                candidate.m_intervals.push_back(second.m_intervals.back());
+
+                /* each projection of the candidate should be dense, projections without the last two dimensions are the parents */
+                bool pruned = false;
+                for (std::size_t index_skip = 0; (index_skip + 2 < candidate.m_dimensions.size()) && !pruned; index_skip++) {
+                    std::vector<std::size_t> key;
+                    for (std::size_t i = 0; i < candidate.m_dimensions.size(); i++) {
+                        if (i != index_skip) {
+                            key.push_back(candidate.m_dimensions[i]);
+                            key.push_back(candidate.m_intervals[i]);
+                        }
+                    }
+
+                    pruned = (dense_keys.find(key) == dense_keys.cend());
+                }
+
+                if (!pruned) {
+                    candidates.push_back(std::move(candidate));
+                    parents.push_back({ index_first, index_second });
+                }
+            }
+        }
+    }
+
+    /* support of each candidate is counted by intersection of point bitmaps of its parents */
+    std::vector<std::size_t> support(candidates.size(), 0);
+    parallel_for(std::size_t(0), candidates.size(), [&p_units, &candidates, &parents, &support](const std::size_t p_index) {
+        const point_bitmap & first = p_units[parents[p_index].first].m_points;
+        const point_bitmap & second = p_units[parents[p_index].second].m_points;
+
+        point_bitmap & points = candidates[p_index].m_points;
+        points.resize(first.size());
+
+        std::size_t amount = 0;
+        for (std::size_t index_word = 0; index_word < first.size(); index_word++) {
+            points[index_word] = first[index_word] & second[index_word];
+            amount += std::bitset<64>(points[index_word]).count();
+        }
+
+        support[p_index] = amount;
+    });
+
+    for (std::size_t index_candidate = 0; index_candidate < candidates.size(); index_candidate++) {
+        if (support[index_candidate] > m_density_threshold) {
+            p_candidates.push_back(std::move(candidates[index_candidate]));
+        }
+    }
+}
+
+
+void clique::allocate_subspace_clusters(const dense_unit_sequence & p_units) const {
+    std::map<std::vector<std::size_t>, std::map<std::vector<std::size_t>, std::size_t>> subspaces;
+    for (std::size_t index_unit = 0; index_unit < p_units.size(); index_unit++) {
+        subspaces[p_units[index_unit].m_dimensions].insert({ p_units[index_unit].m_intervals, index_unit });
+    }
+
+    const std::size_t amount_words = get_bitmap_size(m_data_ptr->size());
+
+    for (const auto & subspace : subspaces) {
+        const auto & subspace_units = subspace.second;
+        std::set<std::size_t> visited;
+
+        for (const auto & unit : subspace_units) {
+            if (visited.count(unit.second) != 0) {
+                continue;
+            }
+
+            /* dense units are connected when they have common face */
+            point_bitmap cluster_points(amount_words, 0);
+            std::list<std::size_t> neighbors = { unit.second };
+            visited.insert(unit.second);
+
+            for (const std::size_t index_unit : neighbors) {
+                const point_bitmap & points = p_units[index_unit].m_points;
+                for (std::size_t index_word = 0; index_word < amount_words; index_word++) {
+                    cluster_points[index_word] |= points[index_word];
+                }
+
+                std::vector<std::size_t> location = p_units[index_unit].m_intervals;
+                for (std::size_t i = 0; i < location.size(); i++) {
+                    for (const int shift : { 1, -1 }) {
+                        if ((shift < 0) && (location[i] == 0)) {
+                            continue;
+                        }
+
+                        location[i] += shift;
+
+                        const auto neighbor = subspace_units.find(location);
+                        if ((neighbor != subspace_units.cend()) && (visited.count(neighbor->second) == 0)) {
+                            visited.insert(neighbor->second);
+                            neighbors.push_back(neighbor->second);
+                        }
+
+                        location[i] -= shift;
+                    }
+                }
+            }
+
+            clique_subspace_cluster subspace_cluster = { subspace.first, { } };
+            for (std::size_t index_point = 0; index_point < m_data_ptr->size(); index_point++) {
+                if (cluster_points[index_point / 64] & (std::uint64_t(1) << (index_point % 64))) {
+                    subspace_cluster.points.push_back(index_point);
+                }
+            }
+
+            m_result_ptr->subspace_clusters().push_back(std::move(subspace_cluster));
+        }
+    }
+}
+
+
+std::size_t clique::get_bitmap_size(const std::size_t p_amount_points) {
+    return (p_amount_points + 63) / 64;
+}
+
+
+void clique::set_bitmap_bit(point_bitmap & p_bitmap, const std::size_t p_index_point) {
+    p_bitmap[p_index_point / 64] |= (std::uint64_t(1) << (p_index_point % 64));
+}
+
+
+std::vector<std::size_t> clique::get_unit_key(const std::vector<std::size_t> & p_dimensions, const std::vector<std::size_t> & p_intervals, const std::size_t p_length) {
+    std::vector<std::size_t> key;
+    key.reserve(2 * p_length);
+
+    for (std::size_t i = 0; i < p_length; i++) {
+        key.push_back(p_dimensions[i]);
+        key.push_back(p_intervals[i]);
+    }
+
+    return key;
 }
 
 
@@ -101,59 +391,178 @@ void clique::expand_cluster(clique_block & p_block) {
 
 
 void clique::get_neighbors(const clique_block & p_block, std::list<clique_block *> & p_neighbors) const {
-    std::vector<clique_block_location> location_neighbors;
-    p_block.get_location_neighbors(m_intervals, location_neighbors);
-
-    for (const auto & location : location_neighbors) {
-        const std::string key = location_to_key(location);
-        clique_block * candidate = m_cells_map.at(key);
+    const clique_block_location & location = p_block.get_logical_location();
+    const block_id id = location_to_id(location);
 
-        if (!candidate->is_visited()) {
+    const auto append_neighbor = [this, &p_neighbors](const block_id p_id) {
+        clique_block * candidate = find_block(p_id);
+        if (candidate && !candidate->is_visited()) {
             candidate->touch();
             p_neighbors.push_back(candidate);
         }
+    };
+
+    for (std::size_t index_dimension = 0; index_dimension < location.size(); ++index_dimension) {
+        if (location[index_dimension] + 1 < m_intervals) {
+            append_neighbor(id + m_strides[index_dimension]);
+        }
+
+        if (location[index_dimension] != 0) {
+            append_neighbor(id - m_strides[index_dimension]);
+        }
     }
 }
 
 
+clique_block * clique::find_block(const block_id p_id) const {
+    auto & blocks = m_result_ptr->blocks();
+    if (!m_sparse) {
+        return &(blocks[static_cast<std::size_t>(p_id)]);
+    }
+
+    const auto iter = m_cells_map.find(p_id);
+    return (iter == m_cells_map.cend()) ? nullptr : &(blocks[iter->second]);
+}
+
+
 void clique::create_grid() {
     clique::data_info info;
     get_data_info(info);
 
-    const std::size_t dimension = m_data_ptr->at(0).size();
-    const auto amount_blocks = static_cast<std::size_t>(std::pow(m_intervals, dimension));
+    const block_id amount_blocks = initialize_strides();
+
+    std::vector<block_id> point_ids;
+    calculate_block_ids(info, point_ids);
 
     auto & blocks = m_result_ptr->blocks();
-    blocks.reserve(amount_blocks);
+    const auto append_block = [this, &info, &blocks](clique_block_location && p_location) {
+        clique_spatial_block spatial_block;
+        get_spatial_location(p_location, info, spatial_block);
 
-    auto iterator = coordinate_iterator(dimension, m_intervals);
+        blocks.emplace_back(std::move(p_location), std::move(spatial_block));
+    };
 
-    std::vector<bool> point_availability(m_data_ptr->size(), true);
+    if (m_sparse) {
+        /* only blocks that contain points are created, they are ordered in the same way as in the dense grid */
+        std::vector<block_id> occupied_ids = point_ids;
+        std::sort(occupied_ids.begin(), occupied_ids.end());
+        occupied_ids.erase(std::unique(occupied_ids.begin(), occupied_ids.end()), occupied_ids.end());
 
-    for (std::size_t i = 0; i < amount_blocks; ++i) {
-        clique_block_location logical_location = iterator.get_coordinate();
-        ++iterator;
+        blocks.reserve(occupied_ids.size());
+        m_cells_map.reserve(occupied_ids.size());
 
-        clique_spatial_block spatial_block;
-        get_spatial_location(logical_location, info, spatial_block);
+        for (const block_id id : occupied_ids) {
+            m_cells_map.insert({ id, blocks.size() });
+            append_block(id_to_location(id));
+        }
+    }
+    else {
+        /* position of each block in the dense grid is equal to its identifier */
+        const std::size_t dimension = m_data_ptr->at(0).size();
+        blocks.reserve(static_cast<std::size_t>(amount_blocks));
 
-        clique_block cell(logical_location, std::move(spatial_block));
-        cell.capture_points(*m_data_ptr, point_availability);
+        auto iterator = coordinate_iterator(dimension, m_intervals);
+        for (block_id i = 0; i < amount_blocks; ++i) {
+            clique_block_location logical_location = iterator.get_coordinate();
+            ++iterator;
 
-        blocks.push_back(std::move(cell));
+            append_block(std::move(logical_location));
+        }
+    }
+
+    for (std::size_t index_point = 0; index_point < point_ids.size(); ++index_point) {
+        find_block(point_ids[index_point])->add_point(index_point);
+    }
+}
+
+
+clique::block_id clique::initialize_strides() {
+    const std::size_t dimension = m_data_ptr->at(0).size();
+
+    m_strides.resize(dimension);
+
+    block_id amount_blocks = 1;
+    for (std::size_t index_dimension = 0; index_dimension < dimension; ++index_dimension) {
+        if (amount_blocks > std::numeric_limits<block_id>::max() / m_intervals) {
+            throw std::invalid_argument("clique: amount of blocks in the grid ('" + std::to_string(m_intervals) +
+                "' intervals in '" + std::to_string(dimension) + "' dimensions) exceeds 2^64.");
+        }
 
-        m_cells_map.insert({ location_to_key(blocks.back().get_logical_location()), &(blocks.back()) });
+        m_strides[index_dimension] = amount_blocks;
+        amount_blocks *= m_intervals;
     }
+
+    m_sparse = (amount_blocks > MAXIMUM_DENSE_GRID_SIZE);
+    return amount_blocks;
 }
 
 
-std::string clique::location_to_key(const clique_block_location & p_location) {
-    std::string result;
-    for (const auto coordinate : p_location) {
-        result += std::to_string(coordinate) + '.';
+void clique::calculate_block_ids(const clique::data_info & p_info, std::vector<block_id> & p_ids) const {
+    const dataset & data = *m_data_ptr;
+    p_ids.resize(data.size());
+
+    parallel_for(std::size_t(0), data.size(), [this, &data, &p_info, &p_ids](const std::size_t p_index) {
+        const point & current_point = data[p_index];
+
+        block_id id = 0;
+        for (std::size_t index_dimension = 0; index_dimension < current_point.size(); ++index_dimension) {
+            id += get_interval(current_point[index_dimension], index_dimension, p_info) * m_strides[index_dimension];
+        }
+
+        p_ids[p_index] = id;
+    });
+}
+
+
+std::size_t clique::get_interval(const double p_coordinate, const std::size_t p_dimension, const clique::data_info & p_info) const {
+    if (p_info.m_sizes[p_dimension] == 0.0) {
+        return 0;
+    }
+
+    const double min_coordinate = p_info.m_min_corner[p_dimension];
+    const double cell_size = p_info.m_sizes[p_dimension] / static_cast<double>(m_intervals);
+
+    /* upper border of the interval is calculated in the same way as the max corner of the block */
+    const auto upper_border = [min_coordinate, cell_size](const std::size_t p_interval) {
+        return (min_coordinate + cell_size * static_cast<double>(p_interval)) + cell_size;
+    };
+
+    const double position = std::floor((p_coordinate - min_coordinate) / cell_size);
+    std::size_t interval = (position <= 0.0) ? 0 : std::min(static_cast<std::size_t>(position), m_intervals - 1);
+
+    /* borders belong to both neighbor blocks, the point is captured by the first of them (like in the dense grid) */
+    while ((interval > 0) && (p_coordinate <= upper_border(interval - 1))) {
+        --interval;
+    }
+
+    while ((interval + 1 < m_intervals) && (p_coordinate > upper_border(interval))) {
+        ++interval;
+    }
+
+    return interval;
+}
+
+
+clique::block_id clique::location_to_id(const clique_block_location & p_location) const {
+    block_id id = 0;
+    for (std::size_t index_dimension = 0; index_dimension < p_location.size(); ++index_dimension) {
+        id += p_location[index_dimension] * m_strides[index_dimension];
+    }
+
+    return id;
+}
+
+
+clique_block_location clique::id_to_location(const block_id p_id) const {
+    clique_block_location location(m_strides.size(), 0);
+
+    block_id remainder = p_id;
+    for (std::size_t index_dimension = 0; index_dimension < location.size(); ++index_dimension) {
+        location[index_dimension] = static_cast<std::size_t>(remainder % m_intervals);
+        remainder /= m_intervals;
     }
 
-    return result;
+    return location;
 }
 
 
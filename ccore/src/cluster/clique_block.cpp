@@ -93,6 +93,10 @@ void clique_block::capture_points(const dataset & p_data, std::vector<bool> & p_
     }
 }
 
+void clique_block::add_point(const std::size_t p_index_point) {
+    m_points.push_back(p_index_point);
+}
+
 void clique_block::get_location_neighbors(const std::size_t p_edge, std::vector<clique_block_location> & p_neighbors) const {
     for (std::size_t index_dimension = 0; index_dimension < m_logical_location.size(); ++index_dimension) {
         if (m_logical_location[index_dimension] + 1 < p_edge) {
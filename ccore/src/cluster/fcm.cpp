@@ -13,6 +13,10 @@
 
 #include <pyclustering/parallel/parallel.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 
 using namespace pyclustering::parallel;
 using namespace pyclustering::utils::metric;
@@ -40,6 +44,7 @@ fcm::fcm(const dataset & p_initial_centers, const double p_m, const double p_tol
     }
 
     m_degree = 2.0 / (p_m - 1.0);
+    m_square_degree = (m_degree == 2.0);
 }
 
 
@@ -56,8 +61,7 @@ void fcm::process(const dataset & p_data, fcm_data & p_result) {
     double current_change = std::numeric_limits<double>::max();
 
     for(std::size_t iteration = 0; iteration < m_itermax && current_change > m_tolerance; iteration++) {
-        update_membership();
-        current_change = update_centers();
+        current_change = update_membership_and_centers();
     }
 
     extract_clusters(m_ptr_result->clusters());
@@ -71,74 +75,106 @@ void fcm::verify() const {
 }
 
 
-double fcm::update_centers() {
-    const std::size_t amount_centers = m_ptr_result->centers().size();
+double fcm::update_membership_and_centers() {
+    const dataset & data = *m_ptr_data;
+    dataset & centers = m_ptr_result->centers();
 
-    std::vector<double> changes(amount_centers, 0.0);
+    const std::size_t amount_centers = centers.size();
+    const std::size_t dimensions = data[0].size();
 
-    parallel_for(std::size_t(0), amount_centers, [this, &changes](const std::size_t p_index) {
-        changes[p_index] = update_center(p_index);
-    });
+    /* each block of points has own accumulators of weighted sums, they are merged in the order of blocks */
+    const std::size_t amount_blocks = std::min(AMOUNT_THREADS + 1, data.size());
+    const std::size_t block_length = data.size() / amount_blocks + ((data.size() % amount_blocks == 0) ? 0 : 1);
 
-    return *(std::max_element(changes.cbegin(), changes.cend()));
-}
+    std::vector<dataset> dividends(amount_blocks, dataset(amount_centers, point(dimensions, 0.0)));
+    std::vector<std::vector<double>> dividers(amount_blocks, std::vector<double>(amount_centers, 0.0));
+
+    parallel_for(std::size_t(0), amount_blocks, [this, &data, block_length, amount_centers, dimensions, &dividends, &dividers](const std::size_t p_block) {
+        const std::size_t begin = p_block * block_length;
+        const std::size_t end = std::min(begin + block_length, data.size());
 
+        dataset & dividend = dividends[p_block];
+        std::vector<double> & divider = dividers[p_block];
+        std::vector<double> distances(amount_centers, 0.0);
 
-double fcm::update_center(const std::size_t p_index) {
-    const std::size_t dimensions = m_ptr_data->at(0).size();
-    const std::size_t data_length = m_ptr_data->size();
+        for (std::size_t index_point = begin; index_point < end; index_point++) {
+            update_point_membership(index_point, distances);
 
-    std::vector<double> dividend(dimensions, 0.0);
-    std::vector<double> divider(dimensions, 0.0);
-    for (std::size_t j = 0; j < data_length; j++) {
-        for (std::size_t dimension = 0; dimension < dimensions; dimension++) {
-            dividend[dimension] += m_ptr_data->at(j).at(dimension) * m_ptr_result->membership()[j][p_index];
-            divider[dimension] += m_ptr_result->membership()[j][p_index];
+            const double * const coordinates = data[index_point].data();
+            const std::vector<double> & membership = m_ptr_result->membership()[index_point];
+
+            for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+                const double weight = membership[index_center];
+                double * const center_dividend = dividend[index_center].data();
+
+                for (std::size_t dimension = 0; dimension < dimensions; dimension++) {
+                    center_dividend[dimension] += coordinates[dimension] * weight;
+                }
+
+                divider[index_center] += weight;
+            }
         }
-    }
+    });
 
-    point update_center(dimensions, 0.0);
-    for (std::size_t dimension = 0; dimension < dimensions; dimension++) {
-        update_center[dimension] = dividend[dimension] / divider[dimension];
-    }
+    double maximum_change = 0.0;
+    for (std::size_t index_center = 0; index_center < amount_centers; index_center++) {
+        point update_center(dimensions, 0.0);
+        double divider = 0.0;
 
-    double change = euclidean_distance(update_center, m_ptr_result->centers().at(p_index));
-    m_ptr_result->centers().at(p_index) = std::move(update_center);
+        for (std::size_t index_block = 0; index_block < amount_blocks; index_block++) {
+            const point & dividend = dividends[index_block][index_center];
+            for (std::size_t dimension = 0; dimension < dimensions; dimension++) {
+                update_center[dimension] += dividend[dimension];
+            }
 
-    return change;
-}
+            divider += dividers[index_block][index_center];
+        }
 
+        for (auto & coordinate : update_center) {
+            coordinate /= divider;
+        }
 
-void fcm::update_membership() {
-    const std::size_t data_size = m_ptr_result->membership().size();
+        const double change = euclidean_distance(update_center, centers[index_center]);
+        maximum_change = std::max(maximum_change, change);
 
-    parallel_for(std::size_t(0), data_size, [this](std::size_t p_index) {
-        update_point_membership(p_index);
-    });
+        centers[index_center] = std::move(update_center);
+    }
+
+    return maximum_change;
 }
 
 
-void fcm::update_point_membership(const std::size_t p_index) {
-    const std::size_t center_amount = m_ptr_result->centers().size();
-    std::vector<double> differences(center_amount, 0.0);
+void fcm::update_point_membership(const std::size_t p_index, std::vector<double> & p_distances) {
+    const dataset & centers = m_ptr_result->centers();
+    const std::size_t center_amount = centers.size();
+
+    double minimum_distance = std::numeric_limits<double>::max();
     for (std::size_t j = 0; j < center_amount; j++) {
-        differences[j] = euclidean_distance_square(m_ptr_data->at(p_index), m_ptr_result->centers().at(j));
+        p_distances[j] = euclidean_distance_square((*m_ptr_data)[p_index], centers[j]);
+        if ((p_distances[j] != 0.0) && (p_distances[j] < minimum_distance)) {
+            minimum_distance = p_distances[j];
+        }
     }
 
+    /*
+
+    Closed form of 1 / sum_k (d_j / d_k)^degree is w_j / sum_k w_k where w_k = (d_min / d_k)^degree,
+    the minimum distance is used for normalization to avoid overflow. Centers that coincide with the point
+    do not take part in the sum (as in the original form) and membership for them is 1.0.
+
+    */
+    double total_weight = 0.0;
     for (std::size_t j = 0; j < center_amount; j++) {
-        double divider = 0.0;
-        for (std::size_t k = 0; k < center_amount; k++) {
-            if (differences[k] != 0.0) {
-                divider += std::pow(differences[j] / differences[k], m_degree);
-            }
+        if (p_distances[j] != 0.0) {
+            const double ratio = minimum_distance / p_distances[j];
+            p_distances[j] = m_square_degree ? ratio * ratio : std::pow(ratio, m_degree);
+            total_weight += p_distances[j];
         }
+    }
 
-        if (divider == 0.0) {
-            m_ptr_result->membership()[p_index][j] = 1.0;
-        }
-        else {
-            m_ptr_result->membership()[p_index][j] = 1.0 / divider;
-        }
+    std::vector<double> & membership = m_ptr_result->membership()[p_index];
+    for (std::size_t j = 0; j < center_amount; j++) {
+        membership[j] = (p_distances[j] == 0.0) ? 1.0 : p_distances[j] / total_weight;
     }
 }
 
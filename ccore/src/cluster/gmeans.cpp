@@ -42,6 +42,8 @@ const std::size_t        gmeans::DEFAULT_REPEAT             = 3;
 
 const std::size_t        gmeans::DEFAULT_CANDIDATES         = 3;
 
+const std::size_t        gmeans::MAXIMUM_TEST_SAMPLE        = 16384;
+
 
 gmeans::gmeans(const std::size_t p_k_initial, const double p_tolerance, const std::size_t p_repeat, const long long p_kmax, const long long p_random_state) :
     m_amount(p_k_initial),
@@ -83,40 +85,53 @@ bool gmeans::is_run_condition() const {
 
 
 void gmeans::search_optimal_parameters(const dataset & p_data, const std::size_t p_amount, cluster_sequence & p_clusters, dataset & p_centers) const {
-    double           best_wce = std::numeric_limits<double>::infinity();
-    cluster_sequence best_clusters = { };
-    dataset          best_centers = { };
+    /* No need to rerun clustering for one initial center. */
+    const std::size_t attempts = (p_amount == 1) ? 1 : m_repeat;
 
-    for (std::size_t i = 0; i < m_repeat; i++) {
+    std::vector<kmeans_data> results(attempts);
+    parallel_for(std::size_t(0), attempts, [this, &p_data, p_amount, &results](const std::size_t p_attempt) {
         dataset initial_centers;
         kmeans_plus_plus(p_amount, get_amount_candidates(p_data), m_random_state).initialize(p_data, initial_centers);
 
-        kmeans_data result;
-        kmeans(initial_centers, m_tolerance).process(p_data, result);
+        kmeans(initial_centers, m_tolerance).process(p_data, results[p_attempt]);
+    });
 
-        if (result.wce() < best_wce) {
-            best_wce = result.wce();
-            best_clusters = std::move(result.clusters());
-            best_centers = std::move(result.centers());
-        }
+    /* the first best attempt is chosen as it is done in case of sequential processing */
+    double best_wce = std::numeric_limits<double>::infinity();
+    std::size_t best_attempt = attempts;
 
-        if (p_amount == 1) {
-            break;      /* No need to rerun clustering for one initial center. */
+    for (std::size_t i = 0; i < attempts; i++) {
+        if (results[i].wce() < best_wce) {
+            best_wce = results[i].wce();
+            best_attempt = i;
         }
     }
 
-    p_clusters = std::move(best_clusters);
-    p_centers = std::move(best_centers);
+    if (best_attempt == attempts) {
+        p_clusters.clear();
+        p_centers.clear();
+        return;
+    }
+
+    p_clusters = std::move(results[best_attempt].clusters());
+    p_centers = std::move(results[best_attempt].centers());
 }
 
 
 void gmeans::statistical_optimization() {
+    const cluster_sequence & clusters = m_ptr_result->clusters();
+
+    /* split tests are independent, only the decision about amount of clusters depends on the order */
+    std::vector<dataset> split_centers(clusters.size());
+    parallel_for(std::size_t(0), clusters.size(), [this, &clusters, &split_centers](const std::size_t p_index) {
+        split_and_search_optimal(clusters[p_index], split_centers[p_index]);
+    });
+
     dataset centers;
     long long potential_amount_clusters = static_cast<long long>(m_ptr_result->clusters().size());
     for (std::size_t i = 0; i < m_ptr_result->clusters().size(); i++) {
-        dataset new_centers;
-        split_and_search_optimal(m_ptr_result->clusters().at(i), new_centers);
-        
+        dataset & new_centers = split_centers[i];
+
         if (new_centers.empty() || ((m_kmax != IGNORE_KMAX) && (potential_amount_clusters >= m_kmax))) {
             centers.push_back(std::move(m_ptr_result->centers().at(i)));
         }
@@ -167,6 +182,11 @@ bool gmeans::is_null_hypothesis(const dataset & p_data, const point & p_center1,
     point v = subtract(p_center1, p_center2);
     projection sample = calculate_projection(p_data, v);
 
+    if (sample.size() > MAXIMUM_TEST_SAMPLE) {
+        /* the test is performed using quantile sketch of the projection in case of huge clusters */
+        sample = quantiles(sample, MAXIMUM_TEST_SAMPLE);
+    }
+
     double estimation = anderson(sample);
     std::vector<double> critical = critical_values(sample.size());
 
@@ -180,8 +200,27 @@ std::size_t gmeans::get_amount_candidates(const dataset & p_data) {
 
 
 gmeans::projection gmeans::calculate_projection(const dataset & p_data, const point & p_vector) {
-    double square_norm = sum(multiply(p_vector, p_vector));
-    return divide(sum(multiply(p_data, p_vector), 1), square_norm);
+    const std::size_t dimension = p_vector.size();
+
+    double square_norm = 0.0;
+    for (const auto value : p_vector) {
+        square_norm += value * value;
+    }
+
+    /* dot product and normalization are fused to avoid temporary matrix of products */
+    projection result(p_data.size(), 0.0);
+    for (std::size_t index_point = 0; index_point < p_data.size(); index_point++) {
+        const double * const coordinates = p_data[index_point].data();
+
+        double product = 0.0;
+        for (std::size_t dim = 0; dim < dimension; dim++) {
+            product += coordinates[dim] * p_vector[dim];
+        }
+
+        result[index_point] = product / square_norm;
+    }
+
+    return result;
 }
 
 
@@ -8,14 +8,24 @@
 
 #include <pyclustering/cluster/hsyncnet.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 
+#include <pyclustering/container/adjacency_list.hpp>
+#include <pyclustering/container/kdtree_searcher.hpp>
+
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <pyclustering/utils/math.hpp>
 #include <pyclustering/utils/metric.hpp>
 
 
-using namespace pyclustering::utils::metric;
+using namespace pyclustering::container;
 using namespace pyclustering::nnet;
+using namespace pyclustering::parallel;
+using namespace pyclustering::utils::math;
+using namespace pyclustering::utils::metric;
 
 
 namespace pyclustering {
@@ -25,6 +35,8 @@ namespace clst {
 
 const double        hsyncnet::DEFAULT_TIME_STEP         = 1.0;
 const std::size_t   hsyncnet::DEFAULT_INCREASE_STEP     = 1;
+const double        hsyncnet::DEFAULT_SYNC_TOLERANCE    = 0.05;
+const double        hsyncnet::NEIGHBORS_COVERAGE_FACTOR = 2.0;
 
 
 hsyncnet::hsyncnet(dataset * input_data, const std::size_t cluster_number, const initial_type initial_phases) :
@@ -57,16 +69,18 @@ void hsyncnet::process(const double order, const solve_type solver, const bool c
         return;   /* Nothing to process, amount of objects is less than required amount of clusters. */
     }
 
-    double radius = average_neighbor_distance(oscillator_locations, number_neighbors);
+    initialize_neighbors();
+
+    double radius = average_neighbor_distance(number_neighbors);
     
-    std::size_t increase_step = static_cast<std::size_t>(round(oscillator_locations->size() * static_cast<std::size_t>(m_increase_persent)));
+    std::size_t increase_step = static_cast<std::size_t>(static_cast<double>(oscillator_locations->size()) * m_increase_persent);
     if (increase_step < 1) {
         increase_step = DEFAULT_INCREASE_STEP;
     }
 
     sync_dynamic current_dynamic;
     do {
-        create_connections(radius, false);
+        append_connections(radius);
 
         simulate_dynamic(order, 0.1, solver, collect_dynamic, current_dynamic);
 
@@ -81,8 +95,9 @@ void hsyncnet::process(const double order, const solve_type solver, const bool c
             m_time += DEFAULT_TIME_STEP;
         }
 
+        /* the same phase-only allocation as it is used by the analyser, so the amount of clusters is consistent with it */
         hsyncnet_cluster_data clusters;
-        current_dynamic.allocate_sync_ensembles(0.05, clusters);
+        current_dynamic.allocate_sync_ensembles(DEFAULT_SYNC_TOLERANCE, clusters);
 
         current_number_clusters = clusters.size();
 
@@ -105,19 +120,148 @@ void hsyncnet::store_state(sync_network_state & state, hsyncnet_analyser & analy
 }
 
 
-double hsyncnet::calculate_radius(const double radius, const std::size_t amount_neighbors) const {
+double hsyncnet::calculate_radius(const double radius, const std::size_t amount_neighbors) {
     double next_radius = 0.0;
     if (amount_neighbors >= oscillator_locations->size()) {
         next_radius = radius * m_increase_persent + radius;
     }
     else {
-        next_radius = average_neighbor_distance(oscillator_locations, amount_neighbors);
+        next_radius = average_neighbor_distance(amount_neighbors);
     }
 
     return next_radius;
 }
 
 
+void hsyncnet::initialize_neighbors() {
+    std::vector<void *> payload(size());
+    for (std::size_t index = 0; index < size(); index++) {
+        payload[index] = (void *) index;
+    }
+
+    m_tree = kdtree_balanced(*oscillator_locations, payload);
+
+    m_neighbors.assign(size(), { });
+    m_neighbors_coverage.assign(size(), -1.0);
+    m_neighbors_connected.assign(size(), 0);
+
+    m_connections = std::make_shared<adjacency_list>(size());
+    m_conn_offsets.assign(size() + 1, 0);
+    m_conn_indexes.clear();
+    m_conn_weights.clear();
+}
+
+
+void hsyncnet::update_neighbors(const std::size_t p_index, const std::size_t p_amount_neighbors, const double p_radius_square) {
+    auto & neighbors = m_neighbors[p_index];
+
+    const std::size_t required_neighbors = std::min(p_amount_neighbors, size() - 1);
+    if ( (neighbors.size() >= required_neighbors) && (m_neighbors_coverage[p_index] >= p_radius_square) ) {
+        return;
+    }
+
+    double coverage = p_radius_square;
+    if (required_neighbors > 0) {
+        std::vector<double> heap;
+        find_nearest_distances(m_tree.get_root(), p_index, required_neighbors, heap);
+        coverage = std::max(coverage, heap.front());
+    }
+
+    /* the list is extended with a reserve, so it is not updated on each level of the hierarchy */
+    const double radius = std::sqrt(coverage * NEIGHBORS_COVERAGE_FACTOR);
+
+    neighbors.clear();
+    kdtree_searcher searcher((*oscillator_locations)[p_index], m_tree.get_root(), radius);
+    searcher.find_nearest([p_index, &neighbors](const kdnode::ptr & p_node, const double p_distance) {
+        const std::size_t index_neighbor = (std::size_t) p_node->get_payload();
+        if (index_neighbor != p_index) {
+            neighbors.emplace_back(p_distance, index_neighbor);
+        }
+    });
+
+    std::sort(neighbors.begin(), neighbors.end());
+
+    m_neighbors_coverage[p_index] = radius * radius;   /* the same border as it is used by the searcher */
+}
+
+
+void hsyncnet::find_nearest_distances(const kdnode::ptr & p_node, const std::size_t p_index, const std::size_t p_amount_neighbors, std::vector<double> & p_heap) const {
+    if (p_node == nullptr) {
+        return;
+    }
+
+    const std::vector<double> & point = (*oscillator_locations)[p_index];
+
+    if ((std::size_t) p_node->get_payload() != p_index) {
+        const double distance = euclidean_distance_square(point, p_node->get_data());
+        if (p_heap.size() < p_amount_neighbors) {
+            p_heap.push_back(distance);
+            std::push_heap(p_heap.begin(), p_heap.end());
+        }
+        else if (distance < p_heap.front()) {
+            std::pop_heap(p_heap.begin(), p_heap.end());
+            p_heap.back() = distance;
+            std::push_heap(p_heap.begin(), p_heap.end());
+        }
+    }
+
+    /* left subtree contains points whose coordinate is less than the node value */
+    const double difference = point[p_node->get_discriminator()] - p_node->get_value();
+    const kdnode::ptr nearest_branch = (difference < 0.0) ? p_node->get_left() : p_node->get_right();
+    const kdnode::ptr farthest_branch = (difference < 0.0) ? p_node->get_right() : p_node->get_left();
+
+    find_nearest_distances(nearest_branch, p_index, p_amount_neighbors, p_heap);
+
+    if ( (p_heap.size() < p_amount_neighbors) || (difference * difference <= p_heap.front()) ) {
+        find_nearest_distances(farthest_branch, p_index, p_amount_neighbors, p_heap);
+    }
+}
+
+
+double hsyncnet::average_neighbor_distance(const std::size_t p_amount_neighbors) {
+    const std::size_t amount_neighbors = std::min(p_amount_neighbors, size() - 1);
+
+    parallel_for(std::size_t(0), size(), [this, amount_neighbors](const std::size_t p_index) {
+        update_neighbors(p_index, amount_neighbors, 0.0);
+    });
+
+    /* the same order of summation as in case of the distance matrix */
+    double total_distance = 0.0;
+    for (std::size_t i = 0; i < size(); i++) {
+        for (std::size_t j = 0; j < amount_neighbors; j++) {
+            total_distance += std::sqrt(m_neighbors[i][j].first);
+        }
+    }
+
+    return total_distance / ( (double) amount_neighbors * (double) size() );
+}
+
+
+void hsyncnet::append_connections(const double p_radius) {
+    const double radius_square = p_radius * p_radius;
+
+    parallel_for(std::size_t(0), size(), [this, radius_square](const std::size_t p_index) {
+        update_neighbors(p_index, 0, radius_square);
+    });
+
+    m_conn_indexes.clear();
+    for (std::size_t i = 0; i < size(); i++) {
+        const auto & neighbors = m_neighbors[i];
+        std::size_t & connected = m_neighbors_connected[i];
+
+        for (; (connected < neighbors.size()) && (neighbors[connected].first <= radius_square); connected++) {
+            m_connections->set_connection(i, neighbors[connected].second);
+        }
+
+        for (std::size_t k = 0; k < connected; k++) {
+            m_conn_indexes.push_back(neighbors[k].second);
+        }
+
+        m_conn_offsets[i + 1] = m_conn_indexes.size();
+    }
+}
+
+
 }
 
 }
\ No newline at end of file
@@ -101,17 +101,19 @@ void kmeans::update_clusters(const dataset & p_centers, cluster_sequence & p_clu
         }
     }
     else {
-        /* This part of code is used by X-Means and in case of parallel implementation of this part in scope of X-Means
-           performance is slightly reduced. Experiments has been performed our implementation and Intel TBB library. 
-           But in K-Means case only - it works perfectly and increase performance. */
-        std::vector<std::size_t> winners(data.size(), 0);
-        parallel_for_each(*m_ptr_indexes, [this, &p_centers, &winners](std::size_t p_index) {
-            assign_point_to_cluster(p_index, p_centers, winners);
+        /* This part of code is used by X-Means for regions of the data, therefore winners are stored by position in
+           the region instead of index in the data. The buffer is reused by the thread that processes regions. */
+        const index_sequence & indexes = *m_ptr_indexes;
+
+        index_sequence & winners = get_region_buffer();
+        winners.resize(indexes.size());
+
+        parallel_for(std::size_t(0), indexes.size(), [this, &p_centers, &indexes, &winners](const std::size_t p_position) {
+            winners[p_position] = find_nearest_center(indexes[p_position], p_centers);
         });
 
-        for (std::size_t index_point : *m_ptr_indexes) {
-            const std::size_t suitable_index_cluster = winners[index_point];
-            p_clusters[suitable_index_cluster].push_back(index_point);
+        for (std::size_t position = 0; position < indexes.size(); position++) {
+            p_clusters[winners[position]].push_back(indexes[position]);
         }
     }
 
@@ -120,6 +122,11 @@ void kmeans::update_clusters(const dataset & p_centers, cluster_sequence & p_clu
 
 
 void kmeans::assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_centers, index_sequence & p_clusters) {
+    p_clusters[p_index_point] = find_nearest_center(p_index_point, p_centers);
+}
+
+
+std::size_t kmeans::find_nearest_center(const std::size_t p_index_point, const dataset & p_centers) const {
     double    minimum_distance = std::numeric_limits<double>::max();
     size_t    suitable_index_cluster = 0;
 
@@ -132,7 +139,13 @@ void kmeans::assign_point_to_cluster(const std::size_t p_index_point, const data
         }
     }
 
-    p_clusters[p_index_point] = suitable_index_cluster;
+    return suitable_index_cluster;
+}
+
+
+index_sequence & kmeans::get_region_buffer() {
+    static thread_local index_sequence buffer;
+    return buffer;
 }
 
 
@@ -188,12 +201,19 @@ double kmeans::update_center(const cluster & p_cluster, point & p_center) {
 
 void kmeans::calculate_total_wce() {
     double & wce = m_ptr_result->wce();
+    std::vector<double> & cluster_wce = m_ptr_result->cluster_wce();
+
+    cluster_wce.assign(m_ptr_result->clusters().size(), 0.0);
+
     for (std::size_t i = 0; i < m_ptr_result->clusters().size(); i++) {
         const auto & current_cluster = m_ptr_result->clusters().at(i);
         const auto & cluster_center = m_ptr_result->centers().at(i);
 
         for (const auto & cluster_point : current_cluster) {
-            wce += m_metric(m_ptr_data->at(cluster_point), cluster_center);
+            const double error = m_metric(m_ptr_data->at(cluster_point), cluster_center);
+
+            wce += error;
+            cluster_wce[i] += error;
         }
     }
 }
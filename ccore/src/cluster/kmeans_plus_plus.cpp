@@ -131,6 +131,7 @@ void kmeans_plus_plus::store_temporal_params(const dataset & p_data, const index
 
     m_allocated_indexes.clear();
     m_free_indexes.clear();
+    m_shortest_distances.clear();
 
     if (m_indexes_ptr->empty())
     {
@@ -149,6 +150,8 @@ void kmeans_plus_plus::store_temporal_params(const dataset & p_data, const index
 void kmeans_plus_plus::free_temporal_params() const {
     m_data_ptr      = nullptr;
     m_indexes_ptr   = nullptr;
+
+    m_shortest_distances.clear();
 }
 
 
@@ -187,35 +190,24 @@ kmeans_plus_plus::center_description kmeans_plus_plus::get_next_center() const
 
 void kmeans_plus_plus::calculate_shortest_distances(std::vector<double> & p_distances) const
 {
-    p_distances.reserve(m_data_ptr->size());
-
-    if (m_indexes_ptr->empty())
-    {
-        for (auto & point : (*m_data_ptr)) {
-            double shortest_distance = get_shortest_distance(point);
-            p_distances.push_back(shortest_distance);
-        }
-    }
-    else {
-        for (auto index : (*m_indexes_ptr)) {
-            double shortest_distance = get_shortest_distance((*m_data_ptr)[index]);
-            p_distances.push_back(shortest_distance);
-        }
+    const std::size_t length = m_indexes_ptr->empty() ? m_data_ptr->size() : m_indexes_ptr->size();
+    if (m_shortest_distances.empty()) {
+        m_shortest_distances.assign(length, std::numeric_limits<double>::max());
     }
 
-}
+    /* only the last allocated center might reduce the shortest distances */
+    const point & last_center = m_data_ptr->at(m_allocated_indexes.back());
 
+    for (std::size_t i = 0; i < length; i++) {
+        const point & current_point = m_indexes_ptr->empty() ? (*m_data_ptr)[i] : (*m_data_ptr)[ (*m_indexes_ptr)[i] ];
 
-double kmeans_plus_plus::get_shortest_distance(const point & p_point) const {
-    double shortest_distance = std::numeric_limits<double>::max();
-    for (auto & index_point : m_allocated_indexes) {
-        double distance = std::abs(m_dist_func(p_point, m_data_ptr->at(index_point)));
-        if (distance < shortest_distance) {
-            shortest_distance = distance;
+        const double distance = std::abs(m_dist_func(current_point, last_center));
+        if (distance < m_shortest_distances[i]) {
+            m_shortest_distances[i] = distance;
         }
     }
 
-    return shortest_distance;
+    p_distances = m_shortest_distances;
 }
 
 
@@ -79,37 +79,46 @@ void kmedians::process(const dataset & p_data, kmedians_data & p_output_result)
 void kmedians::update_clusters(const dataset & p_medians, cluster_sequence & p_clusters) {
     const dataset & data = *m_ptr_data;
 
-    p_clusters.clear();
-    p_clusters.resize(p_medians.size());
-
-    index_sequence labels(data.size(), 0);
+    m_labels.resize(data.size());
 
-    parallel_for(std::size_t(0), data.size(), [this, &p_medians, &labels](std::size_t index) {
-        assign_point_to_cluster(index, p_medians, labels);
+    parallel_for(std::size_t(0), data.size(), [this, &p_medians](const std::size_t p_index) {
+        m_labels[p_index] = find_nearest_median(p_index, p_medians);
     });
 
-    for (std::size_t index_point = 0; index_point < labels.size(); index_point++) {
-        const std::size_t suitable_index_cluster = labels[index_point];
-        p_clusters[suitable_index_cluster].push_back(index_point);
+    /* clusters are filled again, but memory that has been allocated for them is reused */
+    std::vector<std::size_t> sizes(p_medians.size(), 0);
+    for (const auto index_cluster : m_labels) {
+        sizes[index_cluster]++;
+    }
+
+    p_clusters.resize(p_medians.size());
+    for (std::size_t index_cluster = 0; index_cluster < p_clusters.size(); index_cluster++) {
+        p_clusters[index_cluster].clear();
+        p_clusters[index_cluster].reserve(sizes[index_cluster]);
+    }
+
+    for (std::size_t index_point = 0; index_point < m_labels.size(); index_point++) {
+        p_clusters[m_labels[index_point]].push_back(index_point);
     }
 
     erase_empty_clusters(p_clusters);
 }
 
 
-void kmedians::assign_point_to_cluster(const std::size_t p_index_point, const dataset & p_medians, index_sequence & p_lables) {
-    size_t index_cluster_optim = 0;
+std::size_t kmedians::find_nearest_median(const std::size_t p_index_point, const dataset & p_medians) const {
+    std::size_t index_cluster_optim = 0;
     double distance_optim = std::numeric_limits<double>::max();
 
-    for (size_t index_cluster = 0; index_cluster < p_medians.size(); index_cluster++) {
-        double distance = m_metric((*m_ptr_data)[p_index_point], p_medians[index_cluster]);
+    const point & current_point = (*m_ptr_data)[p_index_point];
+    for (std::size_t index_cluster = 0; index_cluster < p_medians.size(); index_cluster++) {
+        const double distance = m_metric(current_point, p_medians[index_cluster]);
         if (distance < distance_optim) {
             index_cluster_optim = index_cluster;
             distance_optim = distance;
         }
     }
 
-    p_lables[p_index_point] = index_cluster_optim;
+    return index_cluster_optim;
 }
 
 
@@ -128,45 +137,58 @@ double kmedians::update_medians(cluster_sequence & clusters, dataset & medians)
 
     std::vector<point> prev_medians(medians);
 
-    medians.clear();
-    medians.resize(clusters.size(), point(dimension, 0.0));
+    medians.resize(clusters.size());
+    for (auto & median : medians) {
+        median.resize(dimension);
+    }
 
-    std::vector<double> changes(clusters.size(), 0);
+    /* each median coordinate is calculated independently, therefore (cluster, dimension) pairs are processed in parallel */
+    parallel_for(std::size_t(0), clusters.size() * dimension, [this, &clusters, &medians, dimension](const std::size_t p_task) {
+        const std::size_t index_cluster = p_task / dimension;
+        const std::size_t index_dimension = p_task % dimension;
 
-    parallel_for(std::size_t(0), clusters.size(), [this, &medians, &prev_medians, &clusters, &changes](std::size_t index_cluster) {
-        calculate_median(clusters[index_cluster], medians[index_cluster]);
-        changes[index_cluster] = m_metric(prev_medians[index_cluster], medians[index_cluster]);
+        medians[index_cluster][index_dimension] = calculate_median(clusters[index_cluster], index_dimension);
     });
 
-    return *std::max_element(changes.cbegin(), changes.cend());
+    double maximum_change = 0.0;
+    for (std::size_t index_cluster = 0; index_cluster < clusters.size(); index_cluster++) {
+        maximum_change = std::max(maximum_change, m_metric(prev_medians[index_cluster], medians[index_cluster]));
+    }
+
+    return maximum_change;
 }
 
 
-void kmedians::calculate_median(cluster & current_cluster, point & median) {
+double kmedians::calculate_median(const cluster & p_cluster, const std::size_t p_dimension) const {
     const dataset & data = *m_ptr_data;
-    const std::size_t dimension = data[0].size();
 
-    for (size_t index_dimension = 0; index_dimension < dimension; index_dimension++) {
-        std::sort(current_cluster.begin(), current_cluster.end(), 
-            [this](std::size_t index_object1, std::size_t index_object2) 
-        {
-            return (*m_ptr_data)[index_object1] > (*m_ptr_data)[index_object2];
-        });
+    std::vector<double> & coordinates = get_coordinate_buffer();
+    coordinates.resize(p_cluster.size());
 
-        std::size_t relative_index_median = (std::size_t) (current_cluster.size() - 1) / 2;
-        std::size_t index_median = current_cluster[relative_index_median];
+    for (std::size_t i = 0; i < p_cluster.size(); i++) {
+        coordinates[i] = data[p_cluster[i]][p_dimension];
+    }
 
-        if (current_cluster.size() % 2 == 0) {
-            std::size_t index_median_second = current_cluster[relative_index_median + 1];
-            median[index_dimension] = (data[index_median][index_dimension] + data[index_median_second][index_dimension]) / 2.0;
-        }
-        else {
-            median[index_dimension] = data[index_median][index_dimension];
-        }
+    const std::size_t relative_index_median = (coordinates.size() - 1) / 2;
+    auto iter_median = coordinates.begin() + relative_index_median;
+
+    std::nth_element(coordinates.begin(), iter_median, coordinates.end());
+
+    if (coordinates.size() % 2 == 0) {
+        /* the second middle value is the smallest value that follows the first one */
+        const double median_second = *std::min_element(iter_median + 1, coordinates.end());
+        return (*iter_median + median_second) / 2.0;
     }
+
+    return *iter_median;
 }
 
 
+std::vector<double> & kmedians::get_coordinate_buffer() {
+    static thread_local std::vector<double> buffer;
+    return buffer;
+}
+
 }
 
 }
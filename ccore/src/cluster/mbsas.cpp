@@ -9,6 +9,11 @@
 
 #include <pyclustering/cluster/mbsas.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
+
+using namespace pyclustering::parallel;
+
 
 namespace pyclustering {
 
@@ -25,35 +30,53 @@ mbsas::mbsas(const std::size_t p_amount,
 void mbsas::process(const dataset & p_data, mbsas_data & p_result) {
     m_result_ptr = &p_result;
 
-    cluster_sequence & clusters = m_result_ptr->clusters();
-    representative_sequence & representative = m_result_ptr->representatives();
-
-    clusters.push_back({ 0 });
-    representative.push_back( p_data[0] );
+    initialize(p_data);
 
+    cluster_sequence & clusters = m_result_ptr->clusters();
     std::vector<std::size_t> skipped_objects = { };
 
     for (std::size_t i = 1; i < p_data.size(); i++) {
         auto nearest = find_nearest_cluster(p_data[i]);
 
         if ( (nearest.m_distance > m_threshold) && (clusters.size() < m_amount) ) {
-            representative.push_back(p_data[i]);
-            clusters.push_back({ i });
+            allocate_cluster(i, p_data[i]);
         }
         else {
             skipped_objects.push_back(i);
         }
     }
 
-    for (auto index : skipped_objects) {
-        auto nearest = find_nearest_cluster(p_data[index]);
+    if (m_parallel_assignment) {
+        /* clusters are not created anymore, therefore the nearest clusters are searched independently */
+        std::vector<std::size_t> nearest_clusters(skipped_objects.size());
+        parallel_for(std::size_t(0), skipped_objects.size(), [this, &p_data, &skipped_objects, &nearest_clusters](const std::size_t p_index) {
+            nearest_clusters[p_index] = find_nearest_cluster(p_data[skipped_objects[p_index]]).m_index;
+        });
+
+        for (std::size_t i = 0; i < skipped_objects.size(); i++) {
+            const std::size_t index = skipped_objects[i];
 
-        clusters.at(nearest.m_index).push_back(index);
-        update_representative(nearest.m_index, p_data[index]);
+            clusters[nearest_clusters[i]].push_back(index);
+            update_representative(nearest_clusters[i], p_data[index]);
+        }
+    }
+    else {
+        for (auto index : skipped_objects) {
+            auto nearest = find_nearest_cluster(p_data[index]);
+
+            clusters.at(nearest.m_index).push_back(index);
+            update_representative(nearest.m_index, p_data[index]);
+        }
     }
+
+    finalize();
 }
 
 
+void mbsas::set_parallel_assignment(const bool p_enable) {
+    m_parallel_assignment = p_enable;
+}
+
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/cluster/representative_matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace pyclustering {
+
+namespace clst {
+
+
+representative_matrix::representative_matrix(const std::size_t p_dimension, const distance_metric<point> & p_metric) :
+    m_dimension(p_dimension),
+    m_metric(p_metric)
+{ }
+
+
+std::size_t representative_matrix::size() const {
+    return m_size;
+}
+
+
+std::size_t representative_matrix::dimension() const {
+    return m_dimension;
+}
+
+
+bool representative_matrix::empty() const {
+    return m_size == 0;
+}
+
+
+void representative_matrix::append(const point & p_representative) {
+    if (m_size == m_capacity) {
+        reserve(std::max(std::size_t(4), m_capacity * 2));
+    }
+
+    for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+        m_coordinates[index_dimension * m_capacity + m_size] = p_representative[index_dimension];
+    }
+
+    m_size++;
+}
+
+
+double & representative_matrix::at(const std::size_t p_index, const std::size_t p_dimension) {
+    return m_coordinates[p_dimension * m_capacity + p_index];
+}
+
+
+double representative_matrix::at(const std::size_t p_index, const std::size_t p_dimension) const {
+    return m_coordinates[p_dimension * m_capacity + p_index];
+}
+
+
+void representative_matrix::get(const std::size_t p_index, point & p_representative) const {
+    p_representative.resize(m_dimension);
+    for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+        p_representative[index_dimension] = at(p_index, index_dimension);
+    }
+}
+
+
+std::size_t representative_matrix::find_nearest(const point & p_point, double & p_distance) const {
+    static thread_local std::vector<double> distances;
+    calculate_distances(p_point, distances);
+
+    std::size_t index_nearest = (std::size_t) -1;
+    p_distance = std::numeric_limits<double>::max();
+
+    for (std::size_t index = 0; index < m_size; index++) {
+        if (distances[index] < p_distance) {
+            p_distance = distances[index];
+            index_nearest = index;
+        }
+    }
+
+    return index_nearest;
+}
+
+
+void representative_matrix::extract(representative_sequence & p_representatives) const {
+    p_representatives.resize(m_size);
+    for (std::size_t index = 0; index < m_size; index++) {
+        get(index, p_representatives[index]);
+    }
+}
+
+
+void representative_matrix::reserve(const std::size_t p_capacity) {
+    std::vector<double> coordinates(m_dimension * p_capacity, 0.0);
+    for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+        std::copy(m_coordinates.begin() + index_dimension * m_capacity,
+                  m_coordinates.begin() + index_dimension * m_capacity + m_size,
+                  coordinates.begin() + index_dimension * p_capacity);
+    }
+
+    m_coordinates = std::move(coordinates);
+    m_capacity = p_capacity;
+}
+
+
+void representative_matrix::calculate_distances(const point & p_point, std::vector<double> & p_distances) const {
+    p_distances.assign(m_size, 0.0);
+    double * const distances = p_distances.data();
+
+    /* distances are accumulated dimension by dimension in the same order as by the metric functions */
+    switch (m_metric.type()) {
+    case distance_metric_type::EUCLIDEAN:
+    case distance_metric_type::EUCLIDEAN_SQUARE:
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            const double coordinate = p_point[index_dimension];
+            const double * const representatives = m_coordinates.data() + index_dimension * m_capacity;
+
+            for (std::size_t index = 0; index < m_size; index++) {
+                const double difference = coordinate - representatives[index];
+                distances[index] += difference * difference;
+            }
+        }
+
+        if (m_metric.type() == distance_metric_type::EUCLIDEAN) {
+            for (std::size_t index = 0; index < m_size; index++) {
+                distances[index] = std::sqrt(distances[index]);
+            }
+        }
+
+        break;
+
+    case distance_metric_type::MANHATTAN:
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            const double coordinate = p_point[index_dimension];
+            const double * const representatives = m_coordinates.data() + index_dimension * m_capacity;
+
+            for (std::size_t index = 0; index < m_size; index++) {
+                distances[index] += std::abs(coordinate - representatives[index]);
+            }
+        }
+
+        break;
+
+    case distance_metric_type::CHEBYSHEV:
+        for (std::size_t index_dimension = 0; index_dimension < m_dimension; index_dimension++) {
+            const double coordinate = p_point[index_dimension];
+            const double * const representatives = m_coordinates.data() + index_dimension * m_capacity;
+
+            for (std::size_t index = 0; index < m_size; index++) {
+                distances[index] = std::max(distances[index], std::abs(coordinate - representatives[index]));
+            }
+        }
+
+        break;
+
+    default: {
+        static thread_local point representative;
+        for (std::size_t index = 0; index < m_size; index++) {
+            get(index, representative);
+            distances[index] = m_metric(p_point, representative);
+        }
+
+        break;
+    }
+    }
+}
+
+
+}
+
+}
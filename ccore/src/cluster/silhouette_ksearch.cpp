@@ -15,14 +15,136 @@
 #include <pyclustering/cluster/kmedians.hpp>
 #include <pyclustering/cluster/kmedoids.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 
+using namespace pyclustering::parallel;
+
+
 namespace pyclustering {
 
 namespace clst {
 
 
+/*!
+
+@brief Finds the worst cluster (with the biggest within-cluster error) and its farthest point from the center.
+
+@param[in]  p_data: input data.
+@param[in]  p_clusters: clusters that should be analysed.
+@param[out] p_centers: centers of the clusters.
+@param[out] p_index_worst: index of the worst cluster.
+@param[out] p_index_farthest: index of the farthest point of the worst cluster.
+
+@return `true` if the worst cluster can be split, otherwise `false` (all points in all clusters are identical).
+
+*/
+static bool find_worst_cluster(const dataset & p_data, const cluster_sequence & p_clusters, dataset & p_centers, std::size_t & p_index_worst, std::size_t & p_index_farthest) {
+    const std::size_t dimension = p_data[0].size();
+
+    p_centers.assign(p_clusters.size(), point(dimension, 0.0));
+
+    double worst_error = 0.0;
+    for (std::size_t index_cluster = 0; index_cluster < p_clusters.size(); index_cluster++) {
+        const auto & current_cluster = p_clusters[index_cluster];
+        auto & center = p_centers[index_cluster];
+
+        for (const auto index_point : current_cluster) {
+            const auto & current_point = p_data[index_point];
+            for (std::size_t dim = 0; dim < dimension; dim++) {
+                center[dim] += current_point[dim];
+            }
+        }
+
+        for (auto & coordinate : center) {
+            coordinate /= static_cast<double>(current_cluster.size());
+        }
+
+        double error = 0.0;
+        double farthest_distance = -1.0;
+        std::size_t farthest = 0;
+        for (const auto index_point : current_cluster) {
+            const double distance = euclidean_distance_square(p_data[index_point], center);
+            error += distance;
+
+            if (distance > farthest_distance) {
+                farthest_distance = distance;
+                farthest = index_point;
+            }
+        }
+
+        if (error > worst_error) {
+            worst_error = error;
+            p_index_worst = index_cluster;
+            p_index_farthest = farthest;
+        }
+    }
+
+    return worst_error > 0.0;
+}
+
+
+void silhouette_ksearch_allocator::allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) {
+    (void) p_previous;
+    allocate(p_amount, p_data, p_random_state, p_clusters);
+}
+
+
+bool silhouette_ksearch_allocator::split_worst_cluster(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, dataset & p_centers) {
+    if (p_previous.size() + 1 != p_amount) {
+        return false;
+    }
+
+    std::size_t index_worst = 0, index_farthest = 0;
+    if (!find_worst_cluster(p_data, p_previous, p_centers, index_worst, index_farthest)) {
+        return false;
+    }
+
+    p_centers.push_back(p_data[index_farthest]);
+    return true;
+}
+
+
+bool silhouette_ksearch_allocator::split_worst_cluster(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, index_sequence & p_medoids) {
+    if (p_previous.size() + 1 != p_amount) {
+        return false;
+    }
+
+    dataset centers;
+    std::size_t index_worst = 0, index_farthest = 0;
+    if (!find_worst_cluster(p_data, p_previous, centers, index_worst, index_farthest)) {
+        return false;
+    }
+
+    /* the closest point to the center of the cluster is considered as an initial medoid */
+    p_medoids.clear();
+    p_medoids.reserve(p_amount);
+
+    for (std::size_t index_cluster = 0; index_cluster < p_previous.size(); index_cluster++) {
+        double nearest_distance = std::numeric_limits<double>::max();
+        std::size_t nearest = p_previous[index_cluster].front();
+
+        for (const auto index_point : p_previous[index_cluster]) {
+            const double distance = euclidean_distance_square(p_data[index_point], centers[index_cluster]);
+            if ((distance < nearest_distance) && (index_point != index_farthest)) {
+                nearest_distance = distance;
+                nearest = index_point;
+            }
+        }
+
+        p_medoids.push_back(nearest);
+    }
+
+    p_medoids.push_back(index_farthest);
+    return true;
+}
+
+
 void kmeans_allocator::allocate(const std::size_t p_amount, const dataset & p_data, cluster_sequence & p_clusters) {
     allocate(p_amount, p_data, RANDOM_STATE_CURRENT_TIME, p_clusters);
 }
@@ -39,6 +161,20 @@ void kmeans_allocator::allocate(const std::size_t p_amount, const dataset & p_da
 }
 
 
+void kmeans_allocator::allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) {
+    dataset initial_centers;
+    if (!split_worst_cluster(p_amount, p_data, p_previous, initial_centers)) {
+        allocate(p_amount, p_data, p_random_state, p_clusters);
+        return;
+    }
+
+    kmeans_data result;
+    kmeans(initial_centers).process(p_data, result);
+
+    p_clusters = std::move(result.clusters());
+}
+
+
 void kmedians_allocator::allocate(const std::size_t p_amount, const dataset & p_data, cluster_sequence & p_clusters) {
     allocate(p_amount, p_data, RANDOM_STATE_CURRENT_TIME, p_clusters);
 }
@@ -55,6 +191,20 @@ void kmedians_allocator::allocate(const std::size_t p_amount, const dataset & p_
 }
 
 
+void kmedians_allocator::allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) {
+    dataset initial_medians;
+    if (!split_worst_cluster(p_amount, p_data, p_previous, initial_medians)) {
+        allocate(p_amount, p_data, p_random_state, p_clusters);
+        return;
+    }
+
+    kmedians_data result;
+    kmedians(initial_medians).process(p_data, result);
+
+    p_clusters = std::move(result.clusters());
+}
+
+
 void kmedoids_allocator::allocate(const std::size_t p_amount, const dataset & p_data, cluster_sequence & p_clusters) {
     allocate(p_amount, p_data, RANDOM_STATE_CURRENT_TIME, p_clusters);
 }
@@ -71,6 +221,20 @@ void kmedoids_allocator::allocate(const std::size_t p_amount, const dataset & p_
 }
 
 
+void kmedoids_allocator::allocate(const std::size_t p_amount, const dataset & p_data, const cluster_sequence & p_previous, const long long p_random_state, cluster_sequence & p_clusters) {
+    medoid_sequence initial_medoids;
+    if (!split_worst_cluster(p_amount, p_data, p_previous, initial_medoids)) {
+        allocate(p_amount, p_data, p_random_state, p_clusters);
+        return;
+    }
+
+    kmedoids_data result;
+    kmedoids(initial_medoids).process(p_data, result);
+
+    p_clusters = std::move(result.clusters());
+}
+
+
 
 silhouette_ksearch::silhouette_ksearch(const std::size_t p_kmin, const std::size_t p_kmax, const silhouette_ksearch_allocator::ptr & p_allocator, const long long p_random_state) :
     m_kmin(p_kmin),
@@ -91,29 +255,144 @@ void silhouette_ksearch::process(const dataset & p_data, silhouette_ksearch_data
             "' should be bigger than amount of objects '" + std::to_string(p_data.size()) + "' in input data.");
     }
 
-    p_result.scores().reserve(m_kmax - m_kmin);
+    if (m_distance_cache) {
+        calculate_distances(p_data);
+    }
+
+    silhouette_score_sequence & scores = p_result.scores();
+    scores.reserve(m_kmax - m_kmin);
+
+    if (m_warm_start) {
+        process_sequentially(p_data, scores);
+    }
+    else {
+        process_parallel(p_data, scores);
+    }
+
+    for (std::size_t index = 0; index < scores.size(); index++) {
+        if (scores[index] > p_result.get_score()) {
+            p_result.set_amount(m_kmin + index);
+            p_result.set_score(scores[index]);
+        }
+    }
+
+    m_distances = dataset();
+}
+
+
+void silhouette_ksearch::set_warm_start(const bool p_enable) {
+    m_warm_start = p_enable;
+}
+
+
+void silhouette_ksearch::set_distance_cache(const bool p_enable) {
+    m_distance_cache = p_enable;
+}
+
+
+void silhouette_ksearch::set_early_stop(const std::size_t p_patience) {
+    m_patience = p_patience;
+}
+
+
+void silhouette_ksearch::process_sequentially(const dataset & p_data, silhouette_score_sequence & p_scores) const {
+    cluster_sequence previous;
 
     for (std::size_t k = m_kmin; k < m_kmax; k++) {
         cluster_sequence clusters;
-        m_allocator->allocate(k, p_data, m_random_state, clusters);
+        if (previous.empty()) {
+            m_allocator->allocate(k, p_data, m_random_state, clusters);
+        }
+        else {
+            m_allocator->allocate(k, p_data, previous, m_random_state, clusters);
+        }
+
+        p_scores.push_back(calculate_score(p_data, clusters, k));
+        previous = std::move(clusters);
+
+        if (is_peak_passed(p_scores)) {
+            break;
+        }
+    }
+}
+
+
+void silhouette_ksearch::process_parallel(const dataset & p_data, silhouette_score_sequence & p_scores) const {
+    /* in case of early stop K values are processed by portions to check the score curve between them */
+    const std::size_t portion = (m_patience > 0) ? AMOUNT_THREADS + 1 : m_kmax - m_kmin;
 
-        if (clusters.size() != k) {
-            p_result.scores().push_back(std::nan("1"));
-            continue;
+    for (std::size_t kbegin = m_kmin; kbegin < m_kmax; kbegin += portion) {
+        const std::size_t kend = std::min(kbegin + portion, m_kmax);
+        p_scores.resize(kend - m_kmin, std::nan("1"));
+
+        parallel_for(kbegin, kend, [this, &p_data, &p_scores](const std::size_t p_kvalue) {
+            cluster_sequence clusters;
+            m_allocator->allocate(p_kvalue, p_data, m_random_state, clusters);
+
+            p_scores[p_kvalue - m_kmin] = calculate_score(p_data, clusters, p_kvalue);
+        });
+
+        if (is_peak_passed(p_scores)) {
+            /* the same amount of scores as in case of sequential processing */
+            const auto best = std::max_element(p_scores.begin(), p_scores.end(), [](const double p_lhs, const double p_rhs) {
+                return std::isnan(p_lhs) || (p_lhs < p_rhs);
+            });
+
+            p_scores.resize(std::distance(p_scores.begin(), best) + m_patience + 1);
+            break;
         }
-        
-        silhouette_data result;
-        silhouette().process(p_data, clusters, result);
+    }
+}
+
+
+bool silhouette_ksearch::is_peak_passed(const silhouette_score_sequence & p_scores) const {
+    if (m_patience == 0) {
+        return false;
+    }
 
-        const auto & scores = result.get_score();
-        const double score = std::accumulate(scores.begin(), scores.end(), 0.0) / static_cast<double>(scores.size());
-        p_result.scores().push_back(score);
+    std::size_t index_best = p_scores.size();
+    double best_score = -std::numeric_limits<double>::infinity();
 
-        if (score > p_result.get_score()) {
-            p_result.set_amount(k);
-            p_result.set_score(score);
+    for (std::size_t index = 0; index < p_scores.size(); index++) {
+        if (p_scores[index] > best_score) {
+            best_score = p_scores[index];
+            index_best = index;
         }
     }
+
+    return (index_best < p_scores.size()) && (p_scores.size() - index_best > m_patience);
+}
+
+
+double silhouette_ksearch::calculate_score(const dataset & p_data, const cluster_sequence & p_clusters, const std::size_t p_amount) const {
+    if (p_clusters.size() != p_amount) {
+        return std::nan("1");
+    }
+
+    silhouette_data result;
+    if (m_distances.empty()) {
+        silhouette().process(p_data, p_clusters, result);
+    }
+    else {
+        silhouette().process(m_distances, p_clusters, data_t::DISTANCE_MATRIX, result);
+    }
+
+    const auto & scores = result.get_score();
+    return std::accumulate(scores.begin(), scores.end(), 0.0) / static_cast<double>(scores.size());
+}
+
+
+void silhouette_ksearch::calculate_distances(const dataset & p_data) {
+    const distance_metric<point> metric = distance_metric_factory<point>::euclidean_square();
+
+    m_distances.assign(p_data.size(), point(p_data.size(), 0.0));
+
+    parallel_for(std::size_t(0), p_data.size(), [this, &p_data, &metric](const std::size_t p_index) {
+        auto & row = m_distances[p_index];
+        for (std::size_t index_neighbor = 0; index_neighbor < p_data.size(); index_neighbor++) {
+            row[index_neighbor] = metric(p_data[p_index], p_data[index_neighbor]);
+        }
+    });
 }
 
 
@@ -8,15 +8,20 @@
 
 #include <pyclustering/cluster/syncnet.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
-#include <pyclustering/utils/metric.hpp>
+#include <pyclustering/container/adjacency_list.hpp>
+#include <pyclustering/container/kdtree_balanced.hpp>
+#include <pyclustering/container/kdtree_searcher.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
 
-using namespace pyclustering::utils::metric;
-using namespace pyclustering::nnet;
 
-using namespace std::placeholders;
+using namespace pyclustering::container;
+using namespace pyclustering::nnet;
+using namespace pyclustering::parallel;
 
 
 namespace pyclustering {
@@ -31,10 +36,9 @@ void syncnet_analyser::allocate_clusters(const double eps, syncnet_cluster_data
 
 
 syncnet::syncnet(std::vector<std::vector<double> > * input_data, const double connectivity_radius, const bool enable_conn_weight, const initial_type initial_phases) :
-sync_network(input_data->size(), 1, 0, connection_t::CONNECTION_NONE, initial_type::RANDOM_GAUSSIAN)
+sync_network(input_data->size(), 1, 0, connection_t::CONNECTION_NONE, initial_phases)
 {
-    equation<double> oscillator_equation = std::bind(&syncnet::phase_kuramoto_equation, this, _1, _2, _3, _4);
-    set_equation(oscillator_equation);
+    disable_network_integration();
 
     oscillator_locations = new std::vector<std::vector<double> >(*input_data);
     create_connections(connectivity_radius, enable_conn_weight);
@@ -46,68 +50,72 @@ syncnet::~syncnet() {
         delete oscillator_locations;
         oscillator_locations = nullptr;
     }
-
-    if (distance_conn_weights != nullptr) {
-        delete distance_conn_weights;
-        distance_conn_weights = nullptr;
-    }
 }
 
 
 void syncnet::create_connections(const double connectivity_radius, const bool enable_conn_weight) {
-    double sqrt_connectivity_radius = connectivity_radius * connectivity_radius;
-
-    if (enable_conn_weight == true) {
-        std::vector<double> instance(size(), 0);
-        distance_conn_weights = new std::vector<std::vector<double> >(size(), instance);
-    }
-    else {
-        distance_conn_weights = nullptr;
+    std::vector<void *> payload(size());
+    for (std::size_t index = 0; index < size(); index++) {
+        payload[index] = (void *) index;
     }
 
-    double maximum_distance = 0;
-    double minimum_distance = std::numeric_limits<double>::max();
+    const kdtree_balanced tree(*oscillator_locations, payload);
 
-    for (std::size_t i = 0; i < size(); i++) {
-        for (std::size_t j = i + 1; j < size(); j++) {
-            double distance = euclidean_distance_square( (*oscillator_locations)[i], (*oscillator_locations)[j] );
+    std::vector<std::vector<std::pair<std::size_t, double>>> neighbors(size());
+
+    parallel_for(std::size_t(0), size(), [this, &tree, &neighbors, connectivity_radius](const std::size_t p_index) {
+        auto & oscillator_neighbors = neighbors[p_index];
 
-            if (distance <= sqrt_connectivity_radius) {
-                m_connections->set_connection(j, i);
-                m_connections->set_connection(i, j);
+        kdtree_searcher searcher((*oscillator_locations)[p_index], tree.get_root(), connectivity_radius);
+        searcher.find_nearest([p_index, &oscillator_neighbors](const kdnode::ptr & p_node, const double p_distance) {
+            const std::size_t index_neighbor = (std::size_t) p_node->get_payload();
+            if (index_neighbor != p_index) {
+                oscillator_neighbors.emplace_back(index_neighbor, p_distance);
             }
+        });
+
+        /* the same order of neighbors as in case of the adjacency collection */
+        std::sort(oscillator_neighbors.begin(), oscillator_neighbors.end());
+    });
+
+    std::shared_ptr<adjacency_list> connections = std::make_shared<adjacency_list>(size());
+
+    m_conn_offsets.assign(size() + 1, 0);
+    m_conn_indexes.clear();
+    m_conn_weights.clear();
 
-            if (enable_conn_weight == true) {
-                (*distance_conn_weights)[i][j] = distance;
-                (*distance_conn_weights)[j][i] = distance;
+    double maximum_distance = 0;
+    double minimum_distance = std::numeric_limits<double>::max();
+
+    for (std::size_t i = 0; i < size(); i++) {
+        for (const auto & neighbor : neighbors[i]) {
+            m_conn_indexes.push_back(neighbor.first);
+            connections->set_connection(i, neighbor.first);
 
-                if (distance > maximum_distance) {
-                    maximum_distance = distance;
-                }
+            if (enable_conn_weight) {
+                m_conn_weights.push_back(neighbor.second);
 
-                if (distance < maximum_distance) {
-                    maximum_distance = distance;
-                }
+                maximum_distance = std::max(maximum_distance, neighbor.second);
+                minimum_distance = std::min(minimum_distance, neighbor.second);
             }
         }
+
+        m_conn_offsets[i + 1] = m_conn_indexes.size();
     }
 
-    if (enable_conn_weight == true) {
+    m_connections = connections;
+
+    if (enable_conn_weight) {
         double multiplier = 1;
         double subtractor = 0;
 
-        if (maximum_distance != minimum_distance) {
+        if (maximum_distance > minimum_distance) {
             multiplier = maximum_distance - minimum_distance;
             subtractor = minimum_distance;
         }
 
-        for (std::size_t i = 0; i < size(); i++) {
-            for (std::size_t j = i + 1; j < size(); j++) {
-                double value_weight = ((*distance_conn_weights)[i][j] - subtractor) / multiplier;
-
-                (*distance_conn_weights)[i][j] = value_weight;
-                (*distance_conn_weights)[j][i] = value_weight;
-            }
+        for (auto & value_weight : m_conn_weights) {
+            value_weight = (value_weight - subtractor) / multiplier;
         }
     }
 }
@@ -115,27 +123,24 @@ void syncnet::create_connections(const double connectivity_radius, const bool en
 
 double syncnet::phase_kuramoto(const double t, const double teta, const std::vector<void *> & argv) const {
     std::size_t index = *(std::size_t *) argv[0];
-    std::size_t num_neighbors = 0;
     double phase = 0;
 
+    const std::size_t begin = m_conn_offsets[index];
+    const std::size_t end = m_conn_offsets[index + 1];
+
     /* Avoid a lot of checking of this condition in the loop */
-    if (distance_conn_weights != nullptr) {
-        for (std::size_t k = 0; k < size(); k++) {
-            if (m_connections->has_connection(index, k)) {
-                phase += (*distance_conn_weights)[index][k] * std::sin( m_oscillators[k].phase - teta );
-                num_neighbors++;
-            }
+    if (!m_conn_weights.empty()) {
+        for (std::size_t k = begin; k < end; k++) {
+            phase += m_conn_weights[k] * std::sin( m_oscillators[m_conn_indexes[k]].phase - teta );
         }
     }
     else {
-        for (std::size_t k = 0; k < size(); k++) {
-            if (m_connections->has_connection(index, k)) {
-                phase += std::sin( m_oscillators[k].phase - teta );
-                num_neighbors++;
-            }
+        for (std::size_t k = begin; k < end; k++) {
+            phase += std::sin( m_oscillators[m_conn_indexes[k]].phase - teta );
         }
     }
 
+    std::size_t num_neighbors = end - begin;
     if (num_neighbors == 0) {
         num_neighbors = 1;
     }
@@ -151,6 +156,25 @@ void syncnet::phase_kuramoto_equation(const double t, const differ_state<double>
 }
 
 
+double syncnet::sync_local_order() const {
+    double exp_amount = 0.0;
+
+    for (std::size_t i = 0; i < size(); i++) {
+        const double phase = m_oscillators[i].phase;
+        for (std::size_t k = m_conn_offsets[i]; k < m_conn_offsets[i + 1]; k++) {
+            exp_amount += std::exp( -std::abs( m_oscillators[m_conn_indexes[k]].phase - phase ) );
+        }
+    }
+
+    double number_neighbors = static_cast<double>(m_conn_indexes.size());
+    if (number_neighbors == 0.0) {
+        number_neighbors = 1.0;
+    }
+
+    return exp_amount / number_neighbors;
+}
+
+
 void syncnet::process(const double order, const solve_type solver, const bool collect_dynamic, syncnet_analyser & analyser) {
     simulate_dynamic(order, 0.1, solver, collect_dynamic, analyser);
 }
@@ -9,6 +9,11 @@
 
 #include <pyclustering/cluster/ttsas.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
+
+using namespace pyclustering::parallel;
+
 
 namespace pyclustering {
 
@@ -34,6 +39,8 @@ void ttsas::process(const dataset & p_data, ttsas_data & p_result) {
     m_skipped_objects = std::vector<bool>(p_data.size(), true);
     m_start = 0;
 
+    m_representatives = representative_matrix(p_data[0].size(), m_metric);
+
     std::size_t changes = 0;
     while (m_amount != 0) {
         const std::size_t previous_amount = m_amount;
@@ -41,6 +48,8 @@ void ttsas::process(const dataset & p_data, ttsas_data & p_result) {
 
         changes = previous_amount - m_amount;
     }
+
+    finalize();
 }
 
 
@@ -56,6 +65,11 @@ void ttsas::process_objects(const std::size_t p_changes) {
         m_start++;
     }
 
+    if (m_parallel_classification) {
+        process_skipped_objects_parallel();
+        return;
+    }
+
     for (std::size_t i = m_start; i < m_skipped_objects.size(); i++) {
         if (m_skipped_objects[i]) {
             process_skipped_object(i);
@@ -64,6 +78,52 @@ void ttsas::process_objects(const std::size_t p_changes) {
 }
 
 
+void ttsas::process_skipped_objects_parallel() {
+    std::vector<std::size_t> pending;
+    for (std::size_t i = m_start; i < m_skipped_objects.size(); i++) {
+        if (m_skipped_objects[i]) {
+            pending.push_back(i);
+        }
+    }
+
+    std::vector<nearest_cluster> nearest(pending.size());
+    parallel_for(std::size_t(0), pending.size(), [this, &pending, &nearest](const std::size_t p_index) {
+        nearest[p_index] = find_nearest_cluster(m_data_ptr->at(pending[p_index]));
+    });
+
+    /* clusters that are created during the pass are checked sequentially for each following point */
+    const std::size_t amount_clusters = m_result_ptr->clusters().size();
+    point representative;
+
+    for (std::size_t i = 0; i < pending.size(); i++) {
+        const point & cur_point = m_data_ptr->at(pending[i]);
+        nearest_cluster & cur_nearest = nearest[i];
+
+        for (std::size_t index_cluster = amount_clusters; index_cluster < m_result_ptr->clusters().size(); index_cluster++) {
+            m_representatives.get(index_cluster, representative);
+
+            const double distance = m_metric(cur_point, representative);
+            if (distance < cur_nearest.m_distance) {
+                cur_nearest.m_distance = distance;
+                cur_nearest.m_index = index_cluster;
+            }
+        }
+
+        if (cur_nearest.m_distance <= m_threshold) {
+            append_to_cluster(cur_nearest.m_index, pending[i], cur_point);
+        }
+        else if (cur_nearest.m_distance > m_threshold2) {
+            allocate_cluster(pending[i], cur_point);
+        }
+    }
+}
+
+
+void ttsas::set_parallel_classification(const bool p_enable) {
+    m_parallel_classification = p_enable;
+}
+
+
 void ttsas::process_skipped_object(const std::size_t p_index_point) {
     const point & cur_point = m_data_ptr->at(p_index_point);
     const nearest_cluster nearest = find_nearest_cluster(cur_point);
@@ -87,8 +147,7 @@ void ttsas::append_to_cluster(const std::size_t p_index_cluster, const std::size
 
 
 void ttsas::allocate_cluster(const std::size_t p_index_point, const point & p_point) {
-    m_result_ptr->clusters().push_back({ p_index_point });
-    m_result_ptr->representatives().push_back(p_point);
+    bsas::allocate_cluster(p_index_point, p_point);
 
     m_amount--;
     m_skipped_objects[p_index_point] = false;
@@ -69,10 +69,11 @@ void xmeans::process(const dataset & p_data, xmeans_data & p_result) {
 
     std::size_t current_number_clusters = centers.size();
     const index_sequence dummy;
+    std::vector<double> errors;
 
     while (current_number_clusters <= m_maximum_clusters) {
-        improve_parameters(clusters, centers, dummy);
-        improve_structure();
+        improve_parameters(clusters, centers, errors, dummy);
+        improve_structure(errors);
 
         if (current_number_clusters == centers.size()) {
             break;
@@ -81,7 +82,7 @@ void xmeans::process(const dataset & p_data, xmeans_data & p_result) {
         current_number_clusters = centers.size();
     }
 
-    m_ptr_result->wce() = improve_parameters(clusters, centers, dummy);
+    m_ptr_result->wce() = improve_parameters(clusters, centers, errors, dummy);
 }
 
 
@@ -103,18 +104,19 @@ void xmeans::set_mndl_beta_bound(const double p_beta) {
 }
 
 
-double xmeans::improve_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, const index_sequence & available_indexes) const {
+double xmeans::improve_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, std::vector<double> & improved_errors, const index_sequence & available_indexes) const {
     kmeans_data result;
     kmeans(improved_centers, m_tolerance, kmeans::DEFAULT_ITERMAX, m_metric).process((*m_ptr_data), available_indexes, result);
 
-    improved_centers = result.centers();
-    improved_clusters = result.clusters();
+    improved_centers = std::move(result.centers());
+    improved_clusters = std::move(result.clusters());
+    improved_errors = std::move(result.cluster_wce());
 
     return result.wce();
 }
 
 
-double xmeans::search_optimal_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, const index_sequence & available_indexes) const {
+double xmeans::search_optimal_parameters(cluster_sequence & improved_clusters, dataset & improved_centers, std::vector<double> & improved_errors, const index_sequence & available_indexes) const {
     double optimal_wce = std::numeric_limits<double>::max();
 
     for (std::size_t attempt = 0; attempt < m_repeat; attempt++) {
@@ -125,11 +127,13 @@ double xmeans::search_optimal_parameters(cluster_sequence & improved_clusters, d
 
         /* perform cluster analysis and update optimum if results became better */
         cluster_sequence candidate_clusters;
-        double candidate_wce = improve_parameters(candidate_clusters, candidate_centers, available_indexes);
+        std::vector<double> candidate_errors;
+        double candidate_wce = improve_parameters(candidate_clusters, candidate_centers, candidate_errors, available_indexes);
 
         if (candidate_wce < optimal_wce) {
             improved_clusters = std::move(candidate_clusters);
             improved_centers = std::move(candidate_centers);
+            improved_errors = std::move(candidate_errors);
             optimal_wce = candidate_wce;
         }
     }
@@ -138,14 +142,14 @@ double xmeans::search_optimal_parameters(cluster_sequence & improved_clusters, d
 }
 
 
-void xmeans::improve_structure() {
+void xmeans::improve_structure(const std::vector<double> & p_errors) {
     cluster_sequence & clusters = m_ptr_result->clusters();
     dataset & current_centers = m_ptr_result->centers();
 
     std::vector<dataset> region_allocated_centers(m_ptr_result->clusters().size(), dataset());
 
-    parallel_for(std::size_t(0), m_ptr_result->clusters().size(), [this, &clusters, &current_centers, &region_allocated_centers](const std::size_t p_index) {
-        improve_region_structure(clusters[p_index], current_centers[p_index], region_allocated_centers[p_index]);
+    parallel_for(std::size_t(0), m_ptr_result->clusters().size(), [this, &clusters, &current_centers, &p_errors, &region_allocated_centers](const std::size_t p_index) {
+        improve_region_structure(clusters[p_index], current_centers[p_index], p_errors[p_index], region_allocated_centers[p_index]);
     });
 
     /* update current centers */
@@ -169,7 +173,7 @@ void xmeans::improve_structure() {
 }
 
 
-void xmeans::improve_region_structure(const cluster & p_cluster, const point & p_center, dataset & p_allocated_centers) const {
+void xmeans::improve_region_structure(const cluster & p_cluster, const point & p_center, const double p_error, dataset & p_allocated_centers) const {
     /* in case of cluster with one object */
     if (p_cluster.size() == 1) {
         std::size_t index_center = p_cluster[0];
@@ -180,7 +184,8 @@ void xmeans::improve_region_structure(const cluster & p_cluster, const point & p
     /* solve k-means problem for children where data of parent are used */
     dataset parent_child_centers;
     cluster_sequence parent_child_clusters;
-    search_optimal_parameters(parent_child_clusters, parent_child_centers, p_cluster);
+    std::vector<double> parent_child_errors;
+    search_optimal_parameters(parent_child_clusters, parent_child_centers, parent_child_errors, p_cluster);
 
     if (parent_child_clusters.size() == 1) {
         /* real situation when all points in cluster are identical */
@@ -188,12 +193,14 @@ void xmeans::improve_region_structure(const cluster & p_cluster, const point & p
         return;
     }
 
-    /* splitting criterion */
-    cluster_sequence parent_cluster(1, p_cluster);
-    dataset parent_center(1, p_center);
+    /* splitting criterion - within-cluster errors have been collected by K-Means, so data is not scanned again */
+    const std::vector<std::size_t> parent_sizes = { p_cluster.size() };
+    const std::vector<double> parent_errors = { p_error };
 
-    double parent_scores = splitting_criterion(parent_cluster, parent_center);
-    double child_scores = splitting_criterion(parent_child_clusters, parent_child_centers);
+    const std::vector<std::size_t> child_sizes = { parent_child_clusters[0].size(), parent_child_clusters[1].size() };
+
+    double parent_scores = splitting_criterion(parent_sizes, parent_errors);
+    double child_scores = splitting_criterion(child_sizes, parent_child_errors);
 
     bool divide_descision = false;
 
@@ -213,45 +220,42 @@ void xmeans::improve_region_structure(const cluster & p_cluster, const point & p
     }
 }
 
-double xmeans::splitting_criterion(const cluster_sequence & analysed_clusters, const dataset & analysed_centers) const {
+double xmeans::splitting_criterion(const std::vector<std::size_t> & p_sizes, const std::vector<double> & p_errors) const {
     switch(m_criterion) {
         case splitting_type::BAYESIAN_INFORMATION_CRITERION:
-            return bayesian_information_criterion(analysed_clusters, analysed_centers);
+            return bayesian_information_criterion(p_sizes, p_errors);
 
         case splitting_type::MINIMUM_NOISELESS_DESCRIPTION_LENGTH:
-            return minimum_noiseless_description_length(analysed_clusters, analysed_centers);
+            return minimum_noiseless_description_length(p_sizes, p_errors);
 
         default:
             /* Unexpected state - return default */
-            return bayesian_information_criterion(analysed_clusters, analysed_centers);
+            return bayesian_information_criterion(p_sizes, p_errors);
     }
 }
 
 
-double xmeans::bayesian_information_criterion(const cluster_sequence & analysed_clusters, const dataset & analysed_centers) const {
+double xmeans::bayesian_information_criterion(const std::vector<std::size_t> & p_sizes, const std::vector<double> & p_errors) const {
     double score = std::numeric_limits<double>::max();
-    double dimension = (double) analysed_centers[0].size();
+    double dimension = (double) (*m_ptr_data)[0].size();
     double sigma = 0.0;
-    double K = static_cast<double>(analysed_centers.size());
+    double K = static_cast<double>(p_sizes.size());
     double N = 0;
 
-    for (std::size_t index_cluster = 0; index_cluster < analysed_clusters.size(); index_cluster++) {
-        for (auto & index_object : analysed_clusters[index_cluster]) {
-            sigma += m_metric((*m_ptr_data)[index_object], analysed_centers[index_cluster]);
-        }
-
-        N += static_cast<double>(analysed_clusters[index_cluster].size());
+    for (std::size_t index_cluster = 0; index_cluster < p_sizes.size(); index_cluster++) {
+        sigma += p_errors[index_cluster];
+        N += static_cast<double>(p_sizes[index_cluster]);
     }
 
     if (N != K) {
-        std::vector<double> scores(analysed_centers.size(), 0.0);
+        std::vector<double> scores(p_sizes.size(), 0.0);
 
         sigma /= N - K;
         double p = (K - 1) + dimension * K + 1;
 
         /* splitting criterion */
-        for (std::size_t index_cluster = 0; index_cluster < analysed_centers.size(); index_cluster++) {
-            double n = (double) analysed_clusters[index_cluster].size();
+        for (std::size_t index_cluster = 0; index_cluster < p_sizes.size(); index_cluster++) {
+            double n = (double) p_sizes[index_cluster];
             double L = n * std::log(n) - n * std::log(N) - n * std::log(2.0 * utils::math::pi) / 2.0 - n * dimension * std::log(sigma) / 2.0 - (n - K) / 2.0;
 
             scores[index_cluster] = L - p * 0.5 * std::log(N);
@@ -264,25 +268,22 @@ double xmeans::bayesian_information_criterion(const cluster_sequence & analysed_
 }
 
 
-double xmeans::minimum_noiseless_description_length(const cluster_sequence & clusters, const dataset & centers) const {
+double xmeans::minimum_noiseless_description_length(const std::vector<std::size_t> & p_sizes, const std::vector<double> & p_errors) const {
     double score = std::numeric_limits<double>::max();
 
     double W = 0.0;
-    double K = (double) clusters.size();
+    double K = (double) p_sizes.size();
     double N = 0.0;
 
     double sigma_square = 0.0;
 
-    for (std::size_t index_cluster = 0; index_cluster < clusters.size(); index_cluster++) {
-        if (clusters[index_cluster].empty()) {
+    for (std::size_t index_cluster = 0; index_cluster < p_sizes.size(); index_cluster++) {
+        if (p_sizes[index_cluster] == 0) {
             return std::numeric_limits<double>::max();
         }
 
-        double Ni = (double) clusters[index_cluster].size();
-        double Wi = 0.0;
-        for (auto & index_object : clusters[index_cluster]) {
-            Wi += m_metric((*m_ptr_data)[index_object], centers[index_cluster]);
-        }
+        double Ni = (double) p_sizes[index_cluster];
+        double Wi = p_errors[index_cluster];
 
         sigma_square += Wi;
         W += Wi / Ni;
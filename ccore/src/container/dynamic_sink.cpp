@@ -0,0 +1,641 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/container/dynamic_sink.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+namespace pyclustering {
+
+namespace container {
+
+
+const char dynamic_file_sink::FILE_SIGNATURE[4] = { 'D', 'Y', 'N', 'B' };
+
+const std::uint32_t dynamic_file_sink::FILE_VERSION = 1;
+
+const std::size_t dynamic_file_sink::DEFAULT_CHUNK_BYTES = 4 * 1024 * 1024;
+
+const std::size_t dynamic_file_sink::MAXIMUM_QUEUE_SIZE = 2;
+
+
+enum dynamic_encoding : std::uint32_t {
+    ENCODING_RAW = 0,
+    ENCODING_DELTA = 1
+};
+
+
+static const std::size_t MAXIMUM_ZERO_RUN = 129;     /* amount of zero bytes that is encoded by one control byte */
+
+
+template <typename TypeValue>
+static void write_values(const TypeValue * p_values, const std::size_t p_amount, std::ostream & p_stream) {
+    p_stream.write(reinterpret_cast<const char *>(p_values), static_cast<std::streamsize>(p_amount * sizeof(TypeValue)));
+}
+
+
+template <typename TypeValue>
+static void write_value(const TypeValue & p_value, std::ostream & p_stream) {
+    write_values(&p_value, 1, p_stream);
+}
+
+
+template <typename TypeValue>
+static TypeValue read_value(const utils::mapped_file & p_file, std::size_t & p_position) {
+    if (p_position + sizeof(TypeValue) > p_file.size()) {
+        throw std::invalid_argument("dynamic file is corrupted (unexpected end of the file at position '" + std::to_string(p_position) + "').");
+    }
+
+    TypeValue value;
+    std::memcpy(&value, p_file.data() + p_position, sizeof(TypeValue));
+    p_position += sizeof(TypeValue);
+
+    return value;
+}
+
+
+/*
+
+ Values of each neuron are XOR-ed with its previous value, so slowly changing values produce words with
+ zero high bytes. Bytes of words are grouped by their significance, after that runs of zero bytes are
+ encoded: control byte 'c < 128' is followed by 'c + 1' literal bytes, control byte 'c >= 128' means
+ 'c - 126' zero bytes.
+
+*/
+static void encode_delta(const std::uint32_t * p_words, const std::size_t p_size, const std::size_t p_steps, std::vector<char> & p_shuffle, std::vector<char> & p_output) {
+    const std::size_t amount = p_size * p_steps;
+    p_shuffle.resize(amount * sizeof(std::uint32_t));
+
+    for (std::size_t neuron = 0; neuron < p_size; neuron++) {
+        const std::uint32_t * words = p_words + neuron * p_steps;
+        for (std::size_t step = 0; step < p_steps; step++) {
+            const std::uint32_t delta = (step == 0) ? words[step] : (words[step] ^ words[step - 1]);
+            const std::size_t index = neuron * p_steps + step;
+
+            for (std::size_t byte = 0; byte < sizeof(std::uint32_t); byte++) {
+                p_shuffle[byte * amount + index] = static_cast<char>((delta >> (8 * byte)) & 0xFF);
+            }
+        }
+    }
+
+    p_output.clear();
+
+    const std::size_t length = p_shuffle.size();
+    for (std::size_t position = 0; position < length; ) {
+        std::size_t run = 0;
+        while ((position + run < length) && (p_shuffle[position + run] == 0) && (run < MAXIMUM_ZERO_RUN)) {
+            run++;
+        }
+
+        if (run >= 2) {
+            p_output.push_back(static_cast<char>(run + 126));
+            position += run;
+            continue;
+        }
+
+        const std::size_t begin = position;
+        while ((position < length) && (position - begin < 128)) {
+            if ((p_shuffle[position] == 0) && (position + 1 < length) && (p_shuffle[position + 1] == 0)) {
+                break;
+            }
+
+            position++;
+        }
+
+        p_output.push_back(static_cast<char>(position - begin - 1));
+        p_output.insert(p_output.end(), p_shuffle.begin() + begin, p_shuffle.begin() + position);
+    }
+}
+
+
+static void decode_delta(const char * p_input, const std::size_t p_bytes, const std::size_t p_size, const std::size_t p_steps, std::vector<char> & p_output) {
+    /* each input byte is decoded to 'MAXIMUM_ZERO_RUN' bytes at most, the size is checked step by step to avoid overflow */
+    const std::size_t limit = std::min(p_bytes, std::numeric_limits<std::size_t>::max() / MAXIMUM_ZERO_RUN) * MAXIMUM_ZERO_RUN / sizeof(std::uint32_t);
+    if ((p_steps != 0) && (p_size > limit / p_steps)) {
+        throw std::invalid_argument("dynamic file is corrupted (size of compressed channel is too big).");
+    }
+
+    const std::size_t amount = p_size * p_steps;
+    const std::size_t length = amount * sizeof(std::uint32_t);
+
+    std::vector<char> shuffle;
+    shuffle.reserve(length);
+
+    for (std::size_t position = 0; position < p_bytes; ) {
+        const auto control = static_cast<unsigned char>(p_input[position++]);
+        if (control >= 128) {
+            shuffle.insert(shuffle.end(), static_cast<std::size_t>(control) - 126, 0);
+        }
+        else {
+            const std::size_t literal = static_cast<std::size_t>(control) + 1;
+            if (position + literal > p_bytes) {
+                throw std::invalid_argument("dynamic file is corrupted (compressed channel is truncated).");
+            }
+
+            shuffle.insert(shuffle.end(), p_input + position, p_input + position + literal);
+            position += literal;
+        }
+
+        if (shuffle.size() > length) {
+            break;
+        }
+    }
+
+    if (shuffle.size() != length) {
+        throw std::invalid_argument("dynamic file is corrupted (unexpected size of compressed channel).");
+    }
+
+    p_output.resize(length);
+    for (std::size_t neuron = 0; neuron < p_size; neuron++) {
+        std::uint32_t previous = 0;
+        for (std::size_t step = 0; step < p_steps; step++) {
+            const std::size_t index = neuron * p_steps + step;
+
+            std::uint32_t word = 0;
+            for (std::size_t byte = 0; byte < sizeof(std::uint32_t); byte++) {
+                word |= static_cast<std::uint32_t>(static_cast<unsigned char>(shuffle[byte * amount + index])) << (8 * byte);
+            }
+
+            previous ^= word;
+            std::memcpy(p_output.data() + index * sizeof(std::uint32_t), &previous, sizeof(std::uint32_t));
+        }
+    }
+}
+
+
+dynamic_file_sink::dynamic_file_sink(const std::string & p_filename, const dynamic_compression p_compression, const std::size_t p_chunk_steps) :
+    m_filename(p_filename),
+    m_compression(p_compression),
+    m_chunk_steps(p_chunk_steps)
+{ }
+
+
+dynamic_file_sink::~dynamic_file_sink() {
+    try {
+        close();
+    }
+    catch (...) { }
+}
+
+
+void dynamic_file_sink::open(const dynamic_layout & p_layout) {
+    if (m_open) {
+        if (p_layout != m_layout) {
+            throw std::invalid_argument("dynamic sink: sink is already opened with another layout.");
+        }
+
+        return;
+    }
+
+    std::size_t width = 0;
+    for (const auto & channel : p_layout) {
+        width += channel.m_size;
+    }
+
+    const std::size_t capacity = (m_chunk_steps != 0) ? m_chunk_steps :
+        std::max(std::size_t(1), DEFAULT_CHUNK_BYTES / std::max(std::size_t(1), width * sizeof(float)));
+
+    m_stream.open(m_filename, std::ios::binary | std::ios::trunc);
+    if (!m_stream.is_open()) {
+        throw std::invalid_argument("dynamic sink: file '" + m_filename + "' cannot be created.");
+    }
+
+    write_values(FILE_SIGNATURE, sizeof(FILE_SIGNATURE), m_stream);
+    write_value(FILE_VERSION, m_stream);
+    write_value(static_cast<std::uint32_t>(m_compression), m_stream);
+    write_value(static_cast<std::uint64_t>(p_layout.size()), m_stream);
+    write_value(static_cast<std::uint64_t>(capacity), m_stream);
+
+    for (const auto & channel : p_layout) {
+        write_value(static_cast<std::uint64_t>(channel.m_size), m_stream);
+        write_value(static_cast<std::uint64_t>(channel.m_name.size()), m_stream);
+        write_values(channel.m_name.data(), channel.m_name.size(), m_stream);
+    }
+
+    if (!m_stream.good()) {
+        m_stream.close();
+        throw std::runtime_error("dynamic sink: header cannot be written to file '" + m_filename + "'.");
+    }
+
+    m_layout = p_layout;
+    m_width = width;
+    m_capacity = capacity;
+
+    m_chunk.m_time.clear();
+    m_chunk.m_time.reserve(m_capacity);
+    m_chunk.m_values.resize(m_capacity * m_width);
+
+    m_encodings.resize(m_layout.size());
+    m_payloads.resize(m_layout.size());
+
+    m_stop = false;
+    m_error = nullptr;
+    m_writer = std::thread(&dynamic_file_sink::run_writer, this);
+    m_open = true;
+}
+
+
+float * dynamic_file_sink::append(const double p_time) {
+    if (!m_open) {
+        throw std::runtime_error("dynamic sink: sink is not opened.");
+    }
+
+    if (m_chunk.m_time.size() == m_capacity) {
+        rethrow_error();
+        submit_chunk();
+    }
+
+    float * row = m_chunk.m_values.data() + m_chunk.m_time.size() * m_width;
+    m_chunk.m_time.push_back(p_time);
+
+    return row;
+}
+
+
+void dynamic_file_sink::close() {
+    if (!m_open) {
+        return;
+    }
+
+    if (!m_chunk.m_time.empty()) {
+        submit_chunk();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stop = true;
+    }
+
+    m_event.notify_all();
+    m_writer.join();
+
+    m_stream.close();
+    m_open = false;
+
+    m_chunk = dynamic_chunk();
+    m_queue.clear();
+    m_spare.clear();
+    m_words.clear();
+    m_shuffle.clear();
+    m_payloads.clear();
+
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+
+void dynamic_file_sink::submit_chunk() {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    m_event.wait(guard, [this]() { return m_queue.size() < MAXIMUM_QUEUE_SIZE; });
+
+    m_queue.push_back(std::move(m_chunk));
+
+    if (m_spare.empty()) {
+        m_chunk = dynamic_chunk();
+        m_chunk.m_values.resize(m_capacity * m_width);
+    }
+    else {
+        m_chunk = std::move(m_spare.back());
+        m_spare.pop_back();
+    }
+
+    guard.unlock();
+    m_event.notify_all();
+
+    m_chunk.m_time.clear();
+    m_chunk.m_time.reserve(m_capacity);
+}
+
+
+void dynamic_file_sink::run_writer() {
+    while (true) {
+        dynamic_chunk chunk;
+        bool failed = false;
+
+        {
+            std::unique_lock<std::mutex> guard(m_mutex);
+            m_event.wait(guard, [this]() { return !m_queue.empty() || m_stop; });
+
+            if (m_queue.empty()) {
+                return;     /* the sink is closed and everything is written */
+            }
+
+            chunk = std::move(m_queue.front());
+            m_queue.pop_front();
+            failed = (m_error != nullptr);
+        }
+
+        std::exception_ptr error = nullptr;
+        if (!failed) {
+            try {
+                write_chunk(chunk);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (error) {
+                m_error = error;
+            }
+
+            m_spare.push_back(std::move(chunk));
+        }
+
+        m_event.notify_all();
+    }
+}
+
+
+void dynamic_file_sink::write_chunk(const dynamic_chunk & p_chunk) {
+    const std::size_t steps = p_chunk.m_time.size();
+
+    std::size_t offset = 0;
+    for (std::size_t index_channel = 0; index_channel < m_layout.size(); index_channel++) {
+        const std::size_t size = m_layout[index_channel].m_size;
+        const std::size_t bytes = size * steps * sizeof(float);
+
+        /* values of a neuron are placed one after another */
+        m_words.resize(size * steps);
+        for (std::size_t step = 0; step < steps; step++) {
+            const float * row = p_chunk.m_values.data() + step * m_width + offset;
+            for (std::size_t neuron = 0; neuron < size; neuron++) {
+                std::memcpy(&m_words[neuron * steps + step], row + neuron, sizeof(float));
+            }
+        }
+
+        std::vector<char> & payload = m_payloads[index_channel];
+        m_encodings[index_channel] = ENCODING_RAW;
+
+        if (m_compression == dynamic_compression::DELTA) {
+            encode_delta(m_words.data(), size, steps, m_shuffle, payload);
+            if (payload.size() < bytes) {
+                m_encodings[index_channel] = ENCODING_DELTA;
+            }
+        }
+
+        if (m_encodings[index_channel] == ENCODING_RAW) {
+            payload.resize(bytes);
+            std::memcpy(payload.data(), m_words.data(), bytes);
+        }
+
+        offset += size;
+    }
+
+    write_value(static_cast<std::uint64_t>(steps), m_stream);
+    for (std::size_t index_channel = 0; index_channel < m_layout.size(); index_channel++) {
+        write_value(m_encodings[index_channel], m_stream);
+        write_value(static_cast<std::uint64_t>(m_payloads[index_channel].size()), m_stream);
+    }
+
+    write_values(p_chunk.m_time.data(), steps, m_stream);
+    for (const auto & payload : m_payloads) {
+        write_values(payload.data(), payload.size(), m_stream);
+    }
+
+    m_stream.flush();
+    if (!m_stream.good()) {
+        throw std::runtime_error("dynamic sink: chunk cannot be written to file '" + m_filename + "'.");
+    }
+}
+
+
+void dynamic_file_sink::rethrow_error() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+
+
+dynamic_file_reader::dynamic_file_reader(const std::string & p_filename) :
+    m_file(p_filename)
+{
+    const auto & signature = dynamic_file_sink::FILE_SIGNATURE;
+    if ((m_file.size() < sizeof(signature)) || !std::equal(std::begin(signature), std::end(signature), m_file.data())) {
+        throw std::invalid_argument("dynamic file '" + p_filename + "' does not have dynamic signature.");
+    }
+
+    std::size_t position = sizeof(signature);
+
+    const auto version = read_value<std::uint32_t>(m_file, position);
+    if (version != dynamic_file_sink::FILE_VERSION) {
+        throw std::invalid_argument("dynamic file: unsupported version of the file '" + std::to_string(version) + "'.");
+    }
+
+    read_value<std::uint32_t>(m_file, position);     /* compression is defined for each chunk channel */
+
+    const auto amount_channels = static_cast<std::size_t>(read_value<std::uint64_t>(m_file, position));
+    read_value<std::uint64_t>(m_file, position);     /* capacity of chunks is not required for reading */
+
+    if (amount_channels > m_file.size()) {
+        throw std::invalid_argument("dynamic file '" + p_filename + "' is corrupted (invalid header).");
+    }
+
+    for (std::size_t i = 0; i < amount_channels; i++) {
+        dynamic_channel channel;
+        channel.m_size = static_cast<std::size_t>(read_value<std::uint64_t>(m_file, position));
+
+        const auto length = static_cast<std::size_t>(read_value<std::uint64_t>(m_file, position));
+        if ((length > m_file.size() - position) || (channel.m_size > m_file.size())) {
+            throw std::invalid_argument("dynamic file '" + p_filename + "' is corrupted (invalid channel).");
+        }
+
+        channel.m_name.assign(m_file.data() + position, length);
+        position += length;
+
+        m_layout.push_back(std::move(channel));
+    }
+
+    /* the last chunk might be incomplete if writing was interrupted */
+    const std::size_t chunk_header = sizeof(std::uint64_t) + amount_channels * (sizeof(std::uint32_t) + sizeof(std::uint64_t));
+    while (m_file.size() - position >= chunk_header) {
+        chunk_index chunk;
+        chunk.m_steps = static_cast<std::size_t>(read_value<std::uint64_t>(m_file, position));
+
+        for (std::size_t i = 0; i < amount_channels; i++) {
+            chunk_channel channel;
+            channel.m_encoding = read_value<std::uint32_t>(m_file, position);
+            channel.m_bytes = static_cast<std::size_t>(read_value<std::uint64_t>(m_file, position));
+
+            /* size of decoded values is checked step by step to avoid overflow in case of corrupted file */
+            const std::size_t limit = (channel.m_encoding == ENCODING_RAW) ? std::numeric_limits<std::size_t>::max() / sizeof(float) :
+                std::min(channel.m_bytes, std::numeric_limits<std::size_t>::max() / MAXIMUM_ZERO_RUN) * MAXIMUM_ZERO_RUN / sizeof(float);
+
+            const bool size_overflow = (chunk.m_steps != 0) && (m_layout[i].m_size > limit / chunk.m_steps);
+            const bool raw_size_mismatch = (channel.m_encoding == ENCODING_RAW) && !size_overflow &&
+                (channel.m_bytes != m_layout[i].m_size * chunk.m_steps * sizeof(float));
+
+            if ((channel.m_encoding > ENCODING_DELTA) || size_overflow || raw_size_mismatch) {
+                throw std::invalid_argument("dynamic file '" + p_filename + "' is corrupted (invalid chunk).");
+            }
+
+            chunk.m_channels.push_back(channel);
+        }
+
+        if (chunk.m_steps > (m_file.size() - position) / sizeof(double)) {
+            break;
+        }
+
+        chunk.m_time = position;
+        position += chunk.m_steps * sizeof(double);
+
+        bool complete = true;
+        for (auto & channel : chunk.m_channels) {
+            if (channel.m_bytes > m_file.size() - position) {
+                complete = false;
+                break;
+            }
+
+            channel.m_position = position;
+            position += channel.m_bytes;
+        }
+
+        if (!complete) {
+            break;
+        }
+
+        m_size += chunk.m_steps;
+        m_chunks.push_back(std::move(chunk));
+    }
+}
+
+
+const dynamic_layout & dynamic_file_reader::layout() const {
+    return m_layout;
+}
+
+
+std::size_t dynamic_file_reader::size() const {
+    return m_size;
+}
+
+
+void dynamic_file_reader::read_time(std::vector<double> & p_time) const {
+    p_time.clear();
+    p_time.reserve(m_size);
+
+    std::vector<double> times;
+    for (const auto & chunk : m_chunks) {
+        read_chunk_time(chunk, times);
+        p_time.insert(p_time.end(), times.begin(), times.end());
+    }
+}
+
+
+void dynamic_file_reader::read(const std::string & p_channel, const double p_time_from, const double p_time_to, const std::size_t p_begin, const std::size_t p_end,
+                               std::vector<double> & p_time, std::vector<std::vector<double>> & p_values) const
+{
+    const std::size_t index_channel = find_channel(p_channel);
+    if ((p_begin > p_end) || (p_end > m_layout[index_channel].m_size)) {
+        throw std::invalid_argument("dynamic file: range of neurons [" + std::to_string(p_begin) + ", " + std::to_string(p_end) +
+            ") is out of channel '" + p_channel + "'.");
+    }
+
+    p_time.clear();
+    p_values.clear();
+
+    std::vector<double> times;
+    std::vector<char> buffer;
+
+    for (const auto & chunk : m_chunks) {
+        read_chunk_time(chunk, times);
+
+        const char * values = nullptr;
+        for (std::size_t step = 0; step < chunk.m_steps; step++) {
+            if ((times[step] < p_time_from) || (times[step] > p_time_to)) {
+                continue;
+            }
+
+            if (values == nullptr) {
+                values = decode_channel(chunk, index_channel, buffer);
+            }
+
+            std::vector<double> state(p_end - p_begin);
+            for (std::size_t neuron = p_begin; neuron < p_end; neuron++) {
+                float value = 0.0f;
+                std::memcpy(&value, values + (neuron * chunk.m_steps + step) * sizeof(float), sizeof(float));
+                state[neuron - p_begin] = value;
+            }
+
+            p_time.push_back(times[step]);
+            p_values.push_back(std::move(state));
+        }
+    }
+}
+
+
+void dynamic_file_reader::read_neuron(const std::string & p_channel, const std::size_t p_neuron, std::vector<double> & p_time, std::vector<double> & p_values) const {
+    const std::size_t index_channel = find_channel(p_channel);
+    if (p_neuron >= m_layout[index_channel].m_size) {
+        throw std::invalid_argument("dynamic file: neuron '" + std::to_string(p_neuron) + "' is out of channel '" + p_channel + "'.");
+    }
+
+    p_time.clear();
+    p_values.clear();
+    p_values.reserve(m_size);
+
+    std::vector<double> times;
+    std::vector<float> neuron_values;
+    std::vector<char> buffer;
+
+    for (const auto & chunk : m_chunks) {
+        read_chunk_time(chunk, times);
+        p_time.insert(p_time.end(), times.begin(), times.end());
+
+        const char * values = decode_channel(chunk, index_channel, buffer);
+
+        neuron_values.resize(chunk.m_steps);
+        std::memcpy(neuron_values.data(), values + p_neuron * chunk.m_steps * sizeof(float), chunk.m_steps * sizeof(float));
+        p_values.insert(p_values.end(), neuron_values.begin(), neuron_values.end());
+    }
+}
+
+
+std::size_t dynamic_file_reader::find_channel(const std::string & p_channel) const {
+    for (std::size_t i = 0; i < m_layout.size(); i++) {
+        if (m_layout[i].m_name == p_channel) {
+            return i;
+        }
+    }
+
+    throw std::invalid_argument("dynamic file: channel '" + p_channel + "' is not found.");
+}
+
+
+void dynamic_file_reader::read_chunk_time(const chunk_index & p_chunk, std::vector<double> & p_time) const {
+    p_time.resize(p_chunk.m_steps);
+    std::memcpy(p_time.data(), m_file.data() + p_chunk.m_time, p_chunk.m_steps * sizeof(double));
+}
+
+
+const char * dynamic_file_reader::decode_channel(const chunk_index & p_chunk, const std::size_t p_channel, std::vector<char> & p_buffer) const {
+    const chunk_channel & channel = p_chunk.m_channels[p_channel];
+    if (channel.m_encoding == ENCODING_RAW) {
+        return m_file.data() + channel.m_position;
+    }
+
+    decode_delta(m_file.data() + channel.m_position, channel.m_bytes, m_layout[p_channel].m_size, p_chunk.m_steps, p_buffer);
+    return p_buffer.data();
+}
+
+
+}
+
+}
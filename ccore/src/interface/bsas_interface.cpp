@@ -10,6 +10,7 @@
 #include <pyclustering/interface/bsas_interface.h>
 
 #include <pyclustering/cluster/bsas.hpp>
+#include <pyclustering/cluster/bsas_stream.hpp>
 
 #include <pyclustering/utils/metric.hpp>
 
@@ -46,4 +47,69 @@ pyclustering_package * bsas_algorithm(const pyclustering_package * const p_sampl
     ((pyclustering_package **) package->data)[BSAS_PACKAGE_INDEX_REPRESENTATIVES] = create_package(&output_result.representatives());
 
     return package;
-}
\ No newline at end of file
+}
+
+
+void * bsas_stream_create(const std::size_t p_amount,
+                          const double p_threshold,
+                          const void * const p_metric)
+{
+    const distance_metric<point> * metric = ((const distance_metric<point> *) p_metric);
+    if (!metric) {
+        return new pyclustering::clst::bsas_stream(p_amount, p_threshold, distance_metric_factory<point>::euclidean_square());
+    }
+
+    return new pyclustering::clst::bsas_stream(p_amount, p_threshold, *metric);
+}
+
+
+void bsas_stream_destroy(const void * p_pointer) {
+    delete (pyclustering::clst::bsas_stream *) p_pointer;
+}
+
+
+pyclustering_package * bsas_stream_push(const void * p_pointer, const pyclustering_package * const p_points) try {
+    dataset points;
+    p_points->extract(points);
+
+    pyclustering::clst::index_sequence labels;
+    ((pyclustering::clst::bsas_stream *) p_pointer)->push_batch(points, labels);
+
+    return create_package(&labels);
+}
+catch (std::exception &) {
+    return nullptr;
+}
+
+
+pyclustering_package * bsas_stream_get_representatives(const void * p_pointer) {
+    pyclustering::clst::representative_sequence representatives;
+    ((pyclustering::clst::bsas_stream *) p_pointer)->get_representatives(representatives);
+
+    return create_package(&representatives);
+}
+
+
+pyclustering_package * bsas_stream_get_sizes(const void * p_pointer) {
+    return create_package(&((pyclustering::clst::bsas_stream *) p_pointer)->cluster_sizes());
+}
+
+
+pyclustering_package * bsas_stream_save(const void * p_pointer) {
+    pyclustering::clst::bsas_stream_state state;
+    ((pyclustering::clst::bsas_stream *) p_pointer)->save(state);
+
+    return create_package(&state);
+}
+
+
+bool bsas_stream_load(const void * p_pointer, const pyclustering_package * const p_state) try {
+    pyclustering::clst::bsas_stream_state state;
+    p_state->extract(state);
+
+    ((pyclustering::clst::bsas_stream *) p_pointer)->load(state);
+    return true;
+}
+catch (std::exception &) {
+    return false;
+}
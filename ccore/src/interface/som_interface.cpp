@@ -8,6 +8,8 @@
 
 #include <pyclustering/interface/som_interface.h>
 
+#include <memory>
+
 
 using namespace pyclustering::nnet;
 
@@ -40,11 +42,36 @@ void som_load(const void * p_pointer, const pyclustering_package * p_weights, co
 }
 
 
+bool som_save(const void * p_pointer, const char * p_filename) try {
+    ((som *) p_pointer)->save(p_filename);
+    return true;
+}
+catch (std::exception &) {
+    return false;
+}
+
+
+void * som_load_file(const char * p_filename) try {
+    std::unique_ptr<som> network(new som(1, 1, som_conn_type::SOM_GRID_FOUR, som_parameters()));
+    network->load(p_filename);
+
+    return network.release();
+}
+catch (std::exception &) {
+    return nullptr;
+}
+
+
 size_t som_train(const void * pointer, const pyclustering_package * const sample, const size_t epochs, const bool autostop) {
+    return som_train_with_mode(pointer, sample, epochs, autostop, static_cast<size_t>(som_train_mode::SOM_ONLINE));
+}
+
+
+size_t som_train_with_mode(const void * pointer, const pyclustering_package * const sample, const size_t epochs, const bool autostop, const size_t p_mode) {
     pyclustering::dataset input_dataset;
     sample->extract(input_dataset);
 
-    size_t result = ((som *) pointer)->train(input_dataset, epochs, autostop);
+    size_t result = ((som *) pointer)->train(input_dataset, epochs, autostop, (som_train_mode) p_mode);
 
     return result;
 }
@@ -58,6 +85,17 @@ size_t som_simulate(const void * pointer, const pyclustering_package * const p_p
 }
 
 
+pyclustering_package * som_simulate_batch(const void * pointer, const pyclustering_package * const p_patterns) {
+    pyclustering::dataset input_patterns;
+    p_patterns->extract(input_patterns);
+
+    std::vector<std::size_t> winners;
+    ((som *) pointer)->simulate(input_patterns, winners);
+
+    return create_package(&winners);
+}
+
+
 size_t som_get_winner_number(const void * pointer) {
     return ((som *) pointer)->get_winner_number();
 }
@@ -0,0 +1,229 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/nnet/collection_policy.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include <pyclustering/nnet/sync.hpp>
+
+
+namespace pyclustering {
+
+namespace nnet {
+
+
+void sync_order_reduction::reset(const std::size_t) {
+    m_time.clear();
+    m_order.clear();
+}
+
+
+void sync_order_reduction::observe(const double p_time, const std::vector<double> & p_values) {
+    m_time.push_back(p_time);
+    m_order.push_back(sync_ordering::calculate_sync_order(p_values));
+}
+
+
+const std::vector<double> & sync_order_reduction::get_time() const {
+    return m_time;
+}
+
+
+const std::vector<double> & sync_order_reduction::get_order() const {
+    return m_order;
+}
+
+
+
+spike_count_reduction::spike_count_reduction(const double p_threshold) :
+    m_threshold(p_threshold)
+{ }
+
+
+void spike_count_reduction::reset(const std::size_t p_size) {
+    m_counts.assign(p_size, 0);
+    m_active.assign(p_size, false);
+}
+
+
+void spike_count_reduction::observe(const double, const std::vector<double> & p_values) {
+    if (p_values.size() != m_counts.size()) {
+        throw std::invalid_argument("Spike counter is reset for '" + std::to_string(m_counts.size()) +
+            "' oscillators, but state of '" + std::to_string(p_values.size()) + "' oscillators is observed.");
+    }
+
+    for (std::size_t i = 0; i < p_values.size(); i++) {
+        const bool active = (p_values[i] >= m_threshold);
+        if (active && !m_active[i]) {
+            m_counts[i]++;
+        }
+
+        m_active[i] = active;
+    }
+}
+
+
+const std::vector<std::size_t> & spike_count_reduction::get_counts() const {
+    return m_counts;
+}
+
+
+
+collection_policy::collection_policy(const collection_type p_type, const std::size_t p_parameter) :
+    m_type(p_type),
+    m_parameter(p_parameter)
+{
+    if ( ((m_type == collection_type::EVERY_NTH) || (m_type == collection_type::WINDOW)) && (m_parameter == 0) ) {
+        throw std::invalid_argument("Interval between stored steps and size of the window should be greater than 0.");
+    }
+}
+
+
+collection_policy collection_policy::last() {
+    return collection_policy(collection_type::LAST);
+}
+
+
+collection_policy collection_policy::all() {
+    return collection_policy(collection_type::ALL);
+}
+
+
+collection_policy collection_policy::every(const std::size_t p_step) {
+    return collection_policy(collection_type::EVERY_NTH, p_step);
+}
+
+
+collection_policy collection_policy::window(const std::size_t p_size) {
+    return collection_policy(collection_type::WINDOW, p_size);
+}
+
+
+collection_policy & collection_policy::add_reduction(const dynamic_reduction::ptr & p_reduction) {
+    m_reductions.push_back(p_reduction);
+    return *this;
+}
+
+
+collection_policy::collection_type collection_policy::get_type() const {
+    return m_type;
+}
+
+
+std::size_t collection_policy::get_parameter() const {
+    return m_parameter;
+}
+
+
+const std::vector<dynamic_reduction::ptr> & collection_policy::get_reductions() const {
+    return m_reductions;
+}
+
+
+std::size_t collection_policy::get_capacity(const std::size_t p_steps) const {
+    switch (m_type) {
+    case collection_type::LAST:
+        return std::min(p_steps, std::size_t(1));
+    case collection_type::EVERY_NTH:
+        return (p_steps + m_parameter - 1) / m_parameter;
+    case collection_type::WINDOW:
+        return std::min(p_steps, m_parameter);
+    default:
+        return p_steps;
+    }
+}
+
+
+bool collection_policy::is_recorded(const std::size_t p_step) const {
+    switch (m_type) {
+    case collection_type::LAST:
+        return false;
+    case collection_type::EVERY_NTH:
+        return (p_step % m_parameter) == 0;
+    default:
+        return true;
+    }
+}
+
+
+void collection_policy::reset(const std::size_t p_size) const {
+    for (const auto & reduction : m_reductions) {
+        reduction->reset(p_size);
+    }
+}
+
+
+void collection_policy::observe(const double p_time, const std::vector<double> & p_values) const {
+    for (const auto & reduction : m_reductions) {
+        reduction->observe(p_time, p_values);
+    }
+}
+
+
+
+dynamic_collector::dynamic_collector(const collection_policy & p_policy, const std::size_t p_stored, const bool p_sink) :
+    m_policy(p_policy),
+    m_last(p_sink || (p_policy.get_type() == collection_policy::collection_type::LAST)),
+    m_stored(p_stored)
+{
+    if (p_sink && (p_policy.get_type() == collection_policy::collection_type::LAST)) {
+        throw std::invalid_argument("Dynamic sink cannot be used with collection policy that stores only the last state.");
+    }
+}
+
+
+dynamic_collector::action dynamic_collector::next(std::size_t & p_position) {
+    const std::size_t step = m_step++;
+    m_recorded = m_policy.is_recorded(step);
+
+    if (m_last) {
+        p_position = 0;
+        if (m_stored == 0) {
+            m_stored++;
+            return action::APPEND;
+        }
+
+        return action::REPLACE;
+    }
+
+    if (!m_recorded) {
+        return action::SKIP;
+    }
+
+    if ( (m_policy.get_type() == collection_policy::collection_type::WINDOW) && (m_stored == m_policy.get_parameter()) ) {
+        p_position = m_position;
+        m_position = (m_position + 1) % m_stored;
+        return action::REPLACE;
+    }
+
+    m_stored++;
+    return action::APPEND;
+}
+
+
+bool dynamic_collector::is_recorded() const {
+    return m_recorded;
+}
+
+
+const collection_policy & dynamic_collector::get_policy() const {
+    return m_policy;
+}
+
+
+std::size_t dynamic_collector::get_first() const {
+    return m_position;
+}
+
+
+}
+
+}
@@ -9,16 +9,15 @@
 
 #include <pyclustering/nnet/hhn.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 
 #include <pyclustering/differential/differ_state.hpp>
 #include <pyclustering/differential/runge_kutta_4.hpp>
 #include <pyclustering/differential/runge_kutta_fehlberg_45.hpp>
-#include <pyclustering/parallel/parallel.hpp>
-
-
-using namespace std::placeholders;
 
 
 
@@ -27,6 +26,95 @@ namespace pyclustering {
 namespace nnet {
 
 
+const double hhn_gating_table::MINIMUM_POTENTIAL   = -100.0;
+const double hhn_gating_table::MAXIMUM_POTENTIAL   = 200.0;
+const double hhn_gating_table::RESOLUTION          = 0.1;
+
+
+hhn_gating_table::hhn_gating_table() {
+    const std::size_t amount_nodes = static_cast<std::size_t>(std::round((MAXIMUM_POTENTIAL - MINIMUM_POTENTIAL) / RESOLUTION)) + 1;
+    m_rates.resize(amount_nodes * RATE_AMOUNT);
+
+    for (std::size_t index = 0; index < amount_nodes; index++) {
+        const double potential = MINIMUM_POTENTIAL + static_cast<double>(index) * RESOLUTION;
+        calculate_rates(potential, m_rates.data() + index * RATE_AMOUNT);
+    }
+
+    m_scale = 1.0 / RESOLUTION;
+    m_last_position = static_cast<double>(amount_nodes - 1);
+}
+
+
+const hhn_gating_table & hhn_gating_table::get() {
+    static const hhn_gating_table table;
+    return table;
+}
+
+
+void hhn_gating_table::calculate_rates(const double p_potential, double * p_rates) {
+    /* 'exp(x) - 1' is replaced by 'expm1(x)', 'x / (exp(x) - 1)' tends to 1 when 'x' tends to 0 */
+    const double am_denominator = std::expm1(2.5 - 0.1 * p_potential);
+    const double an_denominator = std::expm1(1.0 - 0.1 * p_potential);
+
+    p_rates[RATE_AM] = (am_denominator != 0.0) ? (2.5 - 0.1 * p_potential) / am_denominator : 1.0;
+    p_rates[RATE_AH] = 0.07 * std::exp(-p_potential / 20.0);
+    p_rates[RATE_AN] = (an_denominator != 0.0) ? (0.1 - 0.01 * p_potential) / an_denominator : 0.1;
+
+    p_rates[RATE_BM] = 4.0 * std::exp(-p_potential / 18.0);
+    p_rates[RATE_BH] = 1.0 / (std::exp(3.0 - 0.1 * p_potential) + 1.0);
+    p_rates[RATE_BN] = 0.125 * std::exp(-p_potential / 80.0);
+}
+
+
+/* states that can be collected, it is also order of states in a row that is passed to the dynamic sink */
+static const hhn_dynamic::collect COLLECT_ORDER[] = {
+    hhn_dynamic::collect::MEMBRANE_POTENTIAL,
+    hhn_dynamic::collect::ACTIVE_COND_SODIUM,
+    hhn_dynamic::collect::INACTIVE_COND_SODIUM,
+    hhn_dynamic::collect::ACTIVE_COND_POTASSIUM
+};
+
+
+static std::string collect_name(const hhn_dynamic::collect p_type) {
+    switch (p_type) {
+    case hhn_dynamic::collect::MEMBRANE_POTENTIAL:
+        return "membrane_potential";
+    case hhn_dynamic::collect::ACTIVE_COND_SODIUM:
+        return "active_cond_sodium";
+    case hhn_dynamic::collect::INACTIVE_COND_SODIUM:
+        return "inactive_cond_sodium";
+    case hhn_dynamic::collect::ACTIVE_COND_POTASSIUM:
+        return "active_cond_potassium";
+    default:
+        throw std::invalid_argument("Unknown type of HHN state '" + std::to_string(static_cast<int>(p_type)) + "'.");
+    }
+}
+
+
+template <typename NeuronType>
+static double neuron_value(const NeuronType & p_neuron, const hhn_dynamic::collect p_type) {
+    switch (p_type) {
+    case hhn_dynamic::collect::MEMBRANE_POTENTIAL:
+        return p_neuron.m_membrane_potential;
+    case hhn_dynamic::collect::ACTIVE_COND_SODIUM:
+        return p_neuron.m_active_cond_sodium;
+    case hhn_dynamic::collect::INACTIVE_COND_SODIUM:
+        return p_neuron.m_inactive_cond_sodium;
+    default:
+        return p_neuron.m_active_cond_potassium;
+    }
+}
+
+
+template <typename NeuronType>
+static void assign_values(const std::vector<NeuronType> & p_neurons, const hhn_dynamic::collect p_type, std::vector<double> & p_values) {
+    p_values.resize(p_neurons.size());
+    for (std::size_t index = 0; index < p_neurons.size(); index++) {
+        p_values[index] = neuron_value(p_neurons[index], p_type);
+    }
+}
+
+
 hhn_dynamic::hhn_dynamic() {
     initialize_collection(*m_peripheral_dynamic);
     initialize_collection(*m_central_dynamic);
@@ -82,6 +170,16 @@ void hhn_dynamic::get_enabled(std::set<hhn_dynamic::collect> & p_enabled) const
 }
 
 
+void hhn_dynamic::set_sink(const container::dynamic_sink::ptr & p_sink) {
+    m_sink = p_sink;
+}
+
+
+const container::dynamic_sink::ptr & hhn_dynamic::get_sink() const {
+    return m_sink;
+}
+
+
 void hhn_dynamic::get_disabled(std::set<hhn_dynamic::collect> & p_disabled) const {
     get_collected_types(false, p_disabled);
 }
@@ -92,23 +190,28 @@ void hhn_dynamic::store(const double p_time, const std::vector<hhn_oscillator> &
         return;
     }
 
-    if (m_enable[collect::MEMBRANE_POTENTIAL]) {
-        store_membrane_potential(p_peripheral, p_central);
+    if (m_sink) {
+        store_sink(p_time, p_peripheral, p_central);
     }
+    else {
+        if (m_enable[collect::MEMBRANE_POTENTIAL]) {
+            store_membrane_potential(p_peripheral, p_central);
+        }
 
-    if (m_enable[collect::ACTIVE_COND_POTASSIUM]) {
-        store_active_cond_potassium(p_peripheral, p_central);
-    }
+        if (m_enable[collect::ACTIVE_COND_POTASSIUM]) {
+            store_active_cond_potassium(p_peripheral, p_central);
+        }
 
-    if (m_enable[collect::ACTIVE_COND_SODIUM]) {
-        store_active_cond_sodium(p_peripheral, p_central);
-    }
+        if (m_enable[collect::ACTIVE_COND_SODIUM]) {
+            store_active_cond_sodium(p_peripheral, p_central);
+        }
 
-    if (m_enable[collect::INACTIVE_COND_SODIUM]) {
-        store_inactive_cond_sodium(p_peripheral, p_central);
-    }
+        if (m_enable[collect::INACTIVE_COND_SODIUM]) {
+            store_inactive_cond_sodium(p_peripheral, p_central);
+        }
 
-    m_time->push_back(p_time);
+        m_time->push_back(p_time);
+    }
 
     if (m_size_network != 0) {
         if (m_size_network != p_peripheral.size()) {
@@ -123,7 +226,54 @@ void hhn_dynamic::store(const double p_time, const std::vector<hhn_oscillator> &
 }
 
 
+void hhn_dynamic::replace(const std::size_t p_iteration, const double p_time, const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central) {
+    if (!m_amount_collections) {
+        return;
+    }
+
+    if (m_sink || (p_iteration >= m_time->size())) {
+        throw std::out_of_range("Iteration '" + std::to_string(p_iteration) + "' that should be replaced is not stored in memory.");
+    }
+
+    if (m_size_network != p_peripheral.size()) {
+        throw std::invalid_argument("Amount of neurons on each iteration should be the same.");
+    }
+
+    for (const auto type : COLLECT_ORDER) {
+        if (m_enable[type]) {
+            assign_values(p_peripheral, type, m_peripheral_dynamic->at(type)[p_iteration]);
+            assign_values(p_central, type, m_central_dynamic->at(type)[p_iteration]);
+        }
+    }
+
+    (*m_time)[p_iteration] = p_time;
+}
+
+
+void hhn_dynamic::rotate(const std::size_t p_begin, const std::size_t p_iteration) {
+    if ((p_iteration <= p_begin) || (p_iteration >= m_time->size())) {
+        return;
+    }
+
+    for (const auto type : COLLECT_ORDER) {
+        if (m_enable[type]) {
+            auto & peripheral = m_peripheral_dynamic->at(type);
+            std::rotate(peripheral.begin() + p_begin, peripheral.begin() + p_iteration, peripheral.end());
+
+            auto & central = m_central_dynamic->at(type);
+            std::rotate(central.begin() + p_begin, central.begin() + p_iteration, central.end());
+        }
+    }
+
+    std::rotate(m_time->begin() + p_begin, m_time->begin() + p_iteration, m_time->end());
+}
+
+
 void hhn_dynamic::reserve(const std::size_t p_dynamic_size) {
+    if (m_sink) {
+        return;     /* states are not kept in memory */
+    }
+
     if (m_enable[collect::MEMBRANE_POTENTIAL]) {
         reserve_collection(collect::MEMBRANE_POTENTIAL, p_dynamic_size);
     }
@@ -215,6 +365,34 @@ void hhn_dynamic::reserve_dynamic_collection(const hhn_dynamic::collect p_state,
 }
 
 
+void hhn_dynamic::store_sink(const double p_time, const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central) {
+    if (m_size_dynamic == 0) {
+        container::dynamic_layout layout;
+        for (const auto type : COLLECT_ORDER) {
+            if (m_enable[type]) {
+                layout.push_back({ "peripheral." + collect_name(type), p_peripheral.size() });
+                layout.push_back({ "central." + collect_name(type), p_central.size() });
+            }
+        }
+
+        m_sink->open(layout);
+    }
+
+    float * row = m_sink->append(p_time);
+    for (const auto type : COLLECT_ORDER) {
+        if (m_enable[type]) {
+            for (const auto & neuron : p_peripheral) {
+                *(row++) = static_cast<float>(neuron_value(neuron, type));
+            }
+
+            for (const auto & neuron : p_central) {
+                *(row++) = static_cast<float>(neuron_value(neuron, type));
+            }
+        }
+    }
+}
+
+
 void hhn_dynamic::store_membrane_potential(const std::vector<hhn_oscillator> & p_peripheral, const std::vector<central_element> & p_central) {
     std::vector<double> peripheral_membrane_values(p_peripheral.size(), 0.0);
     for (std::size_t index = 0; index < p_peripheral.size(); index++) {
@@ -517,7 +695,15 @@ hhn_network::hhn_network(const std::size_t p_size, const hnn_parameters & p_para
 
 
 void hhn_network::simulate(const std::size_t p_steps, const double p_time, const solve_type p_solver, const hhn_stimulus & p_stimulus, hhn_dynamic & p_output_dynamic) {
-    p_output_dynamic.reserve(p_steps + 1);
+    simulate(p_steps, p_time, p_solver, p_stimulus, collection_policy::all(), p_output_dynamic);
+}
+
+
+void hhn_network::simulate(const std::size_t p_steps, const double p_time, const solve_type p_solver, const hhn_stimulus & p_stimulus, const collection_policy & p_policy, hhn_dynamic & p_output_dynamic) {
+    dynamic_collector collector(p_policy, 0, p_output_dynamic.get_sink() != nullptr);
+
+    p_output_dynamic.reserve(p_policy.get_capacity(p_steps + 1));
+    p_policy.reset(size());
 
     m_stimulus = (hhn_stimulus *) &p_stimulus;
 
@@ -526,7 +712,10 @@ void hhn_network::simulate(const std::size_t p_steps, const double p_time, const
 
     initialize_current();
 
-    store_dynamic(0.0, p_output_dynamic);
+    /* states of the previous simulations are kept, the collector places new states after them */
+    const std::size_t begin = p_output_dynamic.get_sink() ? 0 : p_output_dynamic.size_dynamic();
+
+    store_dynamic(0.0, begin, collector, p_output_dynamic);
 
     double cur_time = 0.0;
     for (std::size_t cur_step = 0; cur_step < p_steps; cur_step++) {
@@ -534,10 +723,12 @@ void hhn_network::simulate(const std::size_t p_steps, const double p_time, const
 
         cur_time += step;
 
-        store_dynamic(cur_time + step, p_output_dynamic);
+        store_dynamic(cur_time + step, begin, collector, p_output_dynamic);
 
         update_peripheral_current();
     }
+
+    p_output_dynamic.rotate(begin, begin + collector.get_first());
 }
 
 
@@ -546,27 +737,66 @@ std::size_t hhn_network::size() const {
 }
 
 
-void hhn_network::store_dynamic(const double p_time, hhn_dynamic & p_dynamic) {
-    p_dynamic.store(p_time, m_peripheral, m_central);
+void hhn_network::store_dynamic(const double p_time, const std::size_t p_begin, dynamic_collector & p_collector, hhn_dynamic & p_dynamic) {
+    std::size_t position = 0;
+    const auto action = p_collector.next(position);
+
+    const auto & policy = p_collector.get_policy();
+    if (!policy.get_reductions().empty()) {
+        std::vector<double> membrane_potential;
+        assign_values(m_peripheral, hhn_dynamic::collect::MEMBRANE_POTENTIAL, membrane_potential);
+        policy.observe(p_time, membrane_potential);
+    }
+
+    if (p_dynamic.get_sink()) {
+        if (p_collector.is_recorded()) {
+            p_dynamic.store(p_time, m_peripheral, m_central);
+        }
+
+        return;
+    }
+
+    switch (action) {
+    case dynamic_collector::action::APPEND:
+        p_dynamic.store(p_time, m_peripheral, m_central);
+        break;
+    case dynamic_collector::action::REPLACE:
+        p_dynamic.replace(p_begin + position, p_time, m_peripheral, m_central);
+        break;
+    default:
+        break;
+    }
 }
 
 
 void hhn_network::calculate_states(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step) {
-    hhn_states next_peripheral_states(m_peripheral.size());
-    calculate_peripheral_states(p_solver, p_time, p_step, p_int_step, next_peripheral_states);
+    hhn_states next_states(POSITION_AMOUNT, m_peripheral.size() + m_central.size());
+
+    m_peripheral_currents.resize(m_peripheral.size());
+    m_peripheral_weights.resize(m_peripheral.size());
+
+    for (std::size_t index = 0; index < m_peripheral.size(); index++) {
+        pack_equation_input(m_peripheral[index], index, next_states);
+
+        m_peripheral_currents[index] = m_peripheral[index].m_Iext;
+        m_peripheral_weights[index] = m_peripheral[index].m_link_weight3;
+    }
+
+    for (std::size_t index = 0; index < m_central.size(); index++) {
+        pack_equation_input(m_central[index], index + m_peripheral.size(), next_states);
+    }
 
-    hhn_states next_central_states(m_central.size());
-    calculate_central_states(p_solver, p_time, p_step, p_int_step, next_central_states);
+    perform_calculation(p_solver, p_time, p_step, p_int_step, next_states);
 
-    assign_neuron_states(p_time, p_step, next_peripheral_states, next_central_states);
+    assign_neuron_states(p_time, p_step, next_states);
 }
 
 
-void hhn_network::assign_neuron_states(const double p_time, const double p_step, const hhn_states & p_next_peripheral, const hhn_states & p_next_central) {
+void hhn_network::assign_neuron_states(const double p_time, const double p_step, const hhn_states & p_next_states) {
     for (std::size_t index = 0; index < m_peripheral.size(); index++) {
         hhn_oscillator & oscillator = m_peripheral[index];
 
-        unpack_equation_output(p_next_peripheral[index], oscillator);
+        unpack_equation_output(p_next_states, index, oscillator);
 
         if (!oscillator.m_pulse_generation) {
             if (oscillator.m_membrane_potential >= 0.0) {
@@ -595,7 +825,7 @@ void hhn_network::assign_neuron_states(const double p_time, const double p_step,
     }
 
     for (std::size_t index = 0; index < m_central.size(); index++) {
-        unpack_equation_output(p_next_central[index], m_central[index]);
+        unpack_equation_output(p_next_states, index + m_peripheral.size(), m_central[index]);
 
         central_element & elem = m_central[index];
         if (!elem.m_pulse_generation) {
@@ -611,36 +841,10 @@ void hhn_network::assign_neuron_states(const double p_time, const double p_step,
 }
 
 
-void hhn_network::calculate_peripheral_states(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, hhn_states & p_next_states) {
-    parallel::parallel_for(std::size_t(0), m_peripheral.size(), [this, &p_solver, p_time, p_step, p_int_step, &p_next_states](const std::size_t p_index) {
-        std::vector<void *> argv(1, nullptr);
-        argv[0] = (void *) p_index;
-
-        differ_state<double> inputs;
-        pack_equation_input(m_peripheral[p_index], inputs);
-
-        perform_calculation(p_solver, p_time, p_step, p_int_step, inputs, argv, p_next_states[p_index]);
-    });
-}
-
-
-void hhn_network::calculate_central_states(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, hhn_states & p_next_states) {
-    parallel::parallel_for(std::size_t(0), m_central.size(), [this, &p_solver, p_time, p_step, p_int_step, &p_next_states](const std::size_t p_index) {
-        std::vector<void *> argv(1, nullptr);
-
-        std::size_t index_central = p_index + m_peripheral.size();
-        argv[0] = (void *) index_central;
-
-        differ_state<double> inputs;
-        pack_equation_input(m_central[p_index], inputs);
-
-        perform_calculation(p_solver, p_time, p_step, p_int_step, inputs, argv, p_next_states[p_index]);
-    });
-}
-
-
-void hhn_network::perform_calculation(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, const differ_state<double> & p_inputs, const differ_extra<> & p_extra, hhn_state & p_next_states) {
-    equation<double> peripheral_equation = std::bind(&hhn_network::neuron_states, this, _1, _2, _3, _4);
+void hhn_network::perform_calculation(const solve_type p_solver, const double p_time, const double p_step, const double p_int_step, hhn_states & p_states) const {
+    auto neuron_equation = [this](const std::vector<double> & p_times, const hhn_states & p_inputs, const std::size_t p_begin, const std::size_t p_end, hhn_states & p_outputs) {
+        neuron_states(p_times, p_inputs, p_begin, p_end, p_outputs);
+    };
 
     switch(p_solver) {
         case solve_type::FORWARD_EULER: {
@@ -649,12 +853,12 @@ void hhn_network::perform_calculation(const solve_type p_solver, const double p_
 
         case solve_type::RUNGE_KUTTA_4: {
             std::size_t number_int_steps = (std::size_t) (p_step / p_int_step);
-            runge_kutta_4(peripheral_equation, p_inputs, p_time, p_time + p_step, number_int_steps, false, p_extra, p_next_states);
+            runge_kutta_4(neuron_equation, p_states, p_time, p_time + p_step, number_int_steps);
             break;
         }
 
         case solve_type::RUNGE_KUTTA_FEHLBERG_45: {
-            runge_kutta_fehlberg_45(peripheral_equation, p_inputs, p_time, p_time + p_step, 0.00001, false, p_extra, p_next_states);
+            runge_kutta_fehlberg_45(neuron_equation, p_states, p_time, p_time + p_step, 0.00001);
             break;
         }
 
@@ -665,13 +869,102 @@ void hhn_network::perform_calculation(const solve_type p_solver, const double p_
 }
 
 
-void hhn_network::neuron_states(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) const {
-    std::size_t index = (std::size_t) argv[0];
+void hhn_network::neuron_states(const std::vector<double> & p_times, const hhn_states & p_inputs, const std::size_t p_begin, const std::size_t p_end, hhn_states & p_outputs) const {
+    const std::size_t peripheral_end = std::min(p_end, size());
+    if (p_begin < peripheral_end) {
+        peripheral_states(p_times, p_inputs, p_begin, peripheral_end, p_outputs);
+    }
+
+    for (std::size_t index = std::max(p_begin, size()); index < p_end; index++) {
+        central_states(p_times[index], index, p_inputs, p_outputs);
+    }
+}
+
+
+void hhn_network::peripheral_states(const std::vector<double> & p_times, const hhn_states & p_inputs, const std::size_t p_begin, const std::size_t p_end, hhn_states & p_outputs) const {
+    const hhn_gating_table & table = hhn_gating_table::get();
+
+    const double * vs = p_inputs[POSITION_MEMBRAN_POTENTIAL];       /* membrane potential (v)                               */
+    const double * ms = p_inputs[POSITION_ACTIVE_COND_SODIUM];      /* activation conductance of the sodium channel (m)     */
+    const double * hs = p_inputs[POSITION_INACTIVE_COND_SODIUM];    /* inactivaton conductance of the sodium channel (h)    */
+    const double * ns = p_inputs[POSITION_ACTIVE_COND_POTASSIUM];   /* activation conductance of the potassium channel (n)  */
+
+    double * dvs = p_outputs[POSITION_MEMBRAN_POTENTIAL];
+    double * dms = p_outputs[POSITION_ACTIVE_COND_SODIUM];
+    double * dhs = p_outputs[POSITION_INACTIVE_COND_SODIUM];
+    double * dns = p_outputs[POSITION_ACTIVE_COND_POTASSIUM];
+
+    /* impact of central elements on peripheral neurons depends on time only, it is reused while time is the same */
+    double impact_time = std::numeric_limits<double>::quiet_NaN();
+    double memory_impact1 = 0.0;
+    double memory_impact2 = 0.0;
+
+    std::array<double, hhn_states::BLOCK_SIZE> impacts1, impacts2, currents;
+
+    for (std::size_t block_begin = p_begin; block_begin < p_end; block_begin += hhn_states::BLOCK_SIZE) {
+        const std::size_t block_end = std::min(block_begin + hhn_states::BLOCK_SIZE, p_end);
+
+        /* Memory impacts of central elements */
+        for (std::size_t index = block_begin; index < block_end; index++) {
+            const double t = p_times[index];
+            if (t != impact_time) {
+                memory_impact1 = central_memory_impact(0, t);
+                memory_impact2 = central_memory_impact(1, t);
+                impact_time = t;
+            }
+
+            impacts1[index - block_begin] = memory_impact1;
+            impacts2[index - block_begin] = memory_impact2;
+        }
+
+        /* External and synaptic currents */
+        for (std::size_t index = block_begin; index < block_end; index++) {
+            const double inhibitory_potential = vs[index] - m_params.m_Vsyninh;
+            const double synaptic_current = m_params.m_w2 * inhibitory_potential * impacts1[index - block_begin] + m_peripheral_weights[index] * inhibitory_potential * impacts2[index - block_begin];
+
+            currents[index - block_begin] = m_peripheral_currents[index] - synaptic_current;
+        }
+
+        /* Ion currents and gating variables, rates are interpolated using the table (inline function, the loop does not contain calls) */
+        for (std::size_t index = block_begin; index < block_end; index++) {
+            const double v = vs[index], m = ms[index], h = hs[index], n = ns[index];
+
+            const double active_sodium_part = m_params.m_gNa * m * m * m * h * (v - m_params.m_vNa);
+            const double inactive_sodium_part = m_params.m_gK * n * n * n * n * (v - m_params.m_vK);
+            const double active_potassium_part = m_params.m_gL * (v - m_params.m_vL);
+
+            dvs[index] = -(active_sodium_part + inactive_sodium_part + active_potassium_part) + currents[index - block_begin];
+
+            double rates[hhn_gating_table::RATE_AMOUNT];
+            table.interpolate(v - m_params.m_vRest, rates);
 
-    double v = inputs[POSITION_MEMBRAN_POTENTIAL];       /* membrane potential (v)                               */
-    double m = inputs[POSITION_ACTIVE_COND_SODIUM];      /* activation conductance of the sodium channel (m)     */
-    double h = inputs[POSITION_INACTIVE_COND_SODIUM];    /* inactivaton conductance of the sodium channel (h)    */
-    double n = inputs[POSITION_ACTIVE_COND_POTASSIUM];   /* activation conductance of the potassium channel (n)  */
+            dms[index] = rates[hhn_gating_table::RATE_AM] * (1.0 - m) - rates[hhn_gating_table::RATE_BM] * m;
+            dhs[index] = rates[hhn_gating_table::RATE_AH] * (1.0 - h) - rates[hhn_gating_table::RATE_BH] * h;
+            dns[index] = rates[hhn_gating_table::RATE_AN] * (1.0 - n) - rates[hhn_gating_table::RATE_BN] * n;
+        }
+
+        /* Potential out of the table (strong transients) - rates are calculated analytically */
+        for (std::size_t index = block_begin; index < block_end; index++) {
+            const double potential = vs[index] - m_params.m_vRest;
+            if (!table.contains(potential)) {
+                double exact_rates[hhn_gating_table::RATE_AMOUNT];
+                hhn_gating_table::calculate_rates(potential, exact_rates);
+
+                const double m = ms[index], h = hs[index], n = ns[index];
+                dms[index] = exact_rates[hhn_gating_table::RATE_AM] * (1.0 - m) - exact_rates[hhn_gating_table::RATE_BM] * m;
+                dhs[index] = exact_rates[hhn_gating_table::RATE_AH] * (1.0 - h) - exact_rates[hhn_gating_table::RATE_BH] * h;
+                dns[index] = exact_rates[hhn_gating_table::RATE_AN] * (1.0 - n) - exact_rates[hhn_gating_table::RATE_BN] * n;
+            }
+        }
+    }
+}
+
+
+void hhn_network::central_states(const double p_time, const std::size_t p_index, const hhn_states & p_inputs, hhn_states & p_outputs) const {
+    double v = p_inputs(POSITION_MEMBRAN_POTENTIAL, p_index);       /* membrane potential (v)                               */
+    double m = p_inputs(POSITION_ACTIVE_COND_SODIUM, p_index);      /* activation conductance of the sodium channel (m)     */
+    double h = p_inputs(POSITION_INACTIVE_COND_SODIUM, p_index);    /* inactivaton conductance of the sodium channel (h)    */
+    double n = p_inputs(POSITION_ACTIVE_COND_POTASSIUM, p_index);   /* activation conductance of the potassium channel (n)  */
 
     /* Calculate ion current */
     double active_sodium_part = m_params.m_gNa * std::pow(m, 3.0) * h * (v - m_params.m_vNa);
@@ -680,40 +973,30 @@ void hhn_network::neuron_states(const double t, const differ_state<double> & inp
 
     double Iion = active_sodium_part + inactive_sodium_part + active_potassium_part;
 
-    double Iext = 0.0;
-    double Isyn = 0.0;
-
     /* External and internal currents */
-    if (index < size()) {
-        Iext = m_peripheral[index].m_Iext;
-        Isyn = peripheral_synaptic_current(index, t, v);
-    }
-    else {
-        std::size_t central_index = index - size();
-        Iext = m_central[central_index].m_Iext;
-        if (central_index == 0) {
-            Isyn = central_first_synaptic_current(t, v);
-        }
+    std::size_t central_index = p_index - size();
+
+    double Iext = m_central[central_index].m_Iext;
+    double Isyn = 0.0;
+    if (central_index == 0) {
+        Isyn = central_first_synaptic_current(p_time, v);
     }
 
     /* Membrane potential */
     double dv = -Iion + Iext - Isyn;
 
     /* Calculate variables */
-    double potential = v - m_params.m_vRest;
-    double am = (2.5 - 0.1 * potential) / (std::expm1(2.5 - 0.1 * potential)); /* 'exp(x) - 1' can be replaced by 'expm1(x)' */
-    double ah = 0.07 * std::exp(-potential / 20.0);
-    double an = (0.1 - 0.01 * potential) / (std::expm1(1.0 - 0.1 * potential)); /* 'exp(x) - 1' can be replaced by 'expm1(x)' */
-
-    double bm = 4.0 * std::exp(-potential / 18.0);
-    double bh = 1.0 / (std::exp(3.0 - 0.1 * potential) + 1.0);
-    double bn = 0.125 * std::exp(-potential / 80.0);
+    double rates[hhn_gating_table::RATE_AMOUNT];
+    hhn_gating_table::calculate_rates(v - m_params.m_vRest, rates);
 
-    double dm = am * (1.0 - m) - bm * m;
-    double dh = ah * (1.0 - h) - bh * h;
-    double dn = an * (1.0 - n) - bn * n;
+    double dm = rates[hhn_gating_table::RATE_AM] * (1.0 - m) - rates[hhn_gating_table::RATE_BM] * m;
+    double dh = rates[hhn_gating_table::RATE_AH] * (1.0 - h) - rates[hhn_gating_table::RATE_BH] * h;
+    double dn = rates[hhn_gating_table::RATE_AN] * (1.0 - n) - rates[hhn_gating_table::RATE_BN] * n;
 
-    outputs = { dv, dm, dh, dn };
+    p_outputs(POSITION_MEMBRAN_POTENTIAL, p_index)     = dv;
+    p_outputs(POSITION_ACTIVE_COND_SODIUM, p_index)    = dm;
+    p_outputs(POSITION_INACTIVE_COND_SODIUM, p_index)  = dh;
+    p_outputs(POSITION_ACTIVE_COND_POTASSIUM, p_index) = dn;
 }
 
 
@@ -722,18 +1005,13 @@ double hhn_network::peripheral_external_current(const std::size_t p_index) const
 }
 
 
-double hhn_network::peripheral_synaptic_current(const std::size_t p_index, const double p_time, const double p_membrane) const {
-    double memory_impact1 = 0.0;
-    for (auto & pulse_time : m_central[0].m_pulse_generation_time) {
-        memory_impact1 += alpha_function(p_time - pulse_time, m_params.m_alfa_inhibitory, m_params.m_betta_inhibitory);
-    }
-
-    double memory_impact2 = 0.0;
-    for (auto & pulse_time : m_central[1].m_pulse_generation_time) {
-        memory_impact2 += alpha_function(p_time - pulse_time, m_params.m_alfa_inhibitory, m_params.m_betta_inhibitory);
+double hhn_network::central_memory_impact(const std::size_t p_central_index, const double p_time) const {
+    double memory_impact = 0.0;
+    for (auto & pulse_time : m_central[p_central_index].m_pulse_generation_time) {
+        memory_impact += alpha_function(p_time - pulse_time, m_params.m_alfa_inhibitory, m_params.m_betta_inhibitory);
     }
 
-    return m_params.m_w2 * (p_membrane - m_params.m_Vsyninh) * memory_impact1 + m_peripheral[p_index].m_link_weight3 * (p_membrane - m_params.m_Vsyninh) * memory_impact2;
+    return memory_impact;
 }
 
 
@@ -8,6 +8,7 @@
 
 #include <pyclustering/nnet/legion.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <stdexcept>
 
@@ -19,8 +20,6 @@
 #include <pyclustering/utils/metric.hpp>
 
 
-using namespace std::placeholders;
-
 using namespace pyclustering::utils::math;
 
 
@@ -29,6 +28,31 @@ namespace pyclustering {
 namespace nnet {
 
 
+template <typename EquationType, typename StateType>
+static void integrate(const solve_type solver, const EquationType & equation, StateType & state, const double t, const double step, const std::size_t number_int_steps) {
+    switch(solver) {
+        case solve_type::FORWARD_EULER: {
+            throw std::invalid_argument("Forward Euler first-order method is not supported due to low accuracy.");
+        }
+
+        case solve_type::RUNGE_KUTTA_4: {
+            runge_kutta_4(equation, state, t, t + step, number_int_steps);
+            break;
+        }
+
+        case solve_type::RUNGE_KUTTA_FEHLBERG_45: {
+            runge_kutta_fehlberg_45(equation, state, t, t + step, 0.00001);
+            break;
+        }
+
+        default: {
+            throw std::invalid_argument("Not supported solver is used.");
+        }
+    }
+}
+
+
+
 const size_t legion_network::MAXIMUM_MATRIX_REPRESENTATION_SIZE = 4096;
 
 
@@ -59,6 +83,17 @@ void legion_network::simulate(const unsigned int steps,
                               const legion_stimulus & stimulus, 
                               legion_dynamic & output_dynamic) {
 
+    simulate(steps, time, solver, collect_dynamic ? collection_policy::all() : collection_policy::last(), stimulus, output_dynamic);
+}
+
+
+void legion_network::simulate(const unsigned int steps,
+                              const double time,
+                              const solve_type solver,
+                              const collection_policy & policy,
+                              const legion_stimulus & stimulus,
+                              legion_dynamic & output_dynamic) {
+
     output_dynamic.clear();
 
     m_stimulus = (legion_stimulus *) &stimulus;
@@ -67,13 +102,18 @@ void legion_network::simulate(const unsigned int steps,
     const double step = time / (double) steps;
     const double int_step = step / 10.0;
 
-    store_dynamic(0.0, collect_dynamic, output_dynamic);  /* store initial state */
+    policy.reset(size());
+    dynamic_collector collector(policy, 0, output_dynamic.get_sink() != nullptr);
+
+    store_dynamic(0.0, collector, output_dynamic);  /* store initial state */
 
     for (double cur_time = step; cur_time < time; cur_time += step) {
         calculate_states(stimulus, solver, cur_time, step, int_step);
 
-        store_dynamic(cur_time, collect_dynamic, output_dynamic);	/* store initial state */
+        store_dynamic(cur_time, collector, output_dynamic);	/* store initial state */
     }
+
+    collector.arrange(output_dynamic);
 }
 
 void legion_network::create_dynamic_connections(const legion_stimulus & stimulus) {
@@ -104,7 +144,17 @@ void legion_network::create_dynamic_connections(const legion_stimulus & stimulus
     }
 }
 
-void legion_network::store_dynamic(const double time, const bool collect_dynamic, legion_dynamic & dynamic) const {
+void legion_network::store_dynamic(const double time, dynamic_collector & collector, legion_dynamic & dynamic) const {
+    std::size_t position = 0;
+    const dynamic_collector::action action = collector.next(position);
+
+    const dynamic_sink::ptr sink = collector.is_recorded() ? dynamic.get_sink() : nullptr;
+    const bool reduce = !collector.get_policy().get_reductions().empty();
+
+    if ( (action == dynamic_collector::action::SKIP) && !sink && !reduce ) {
+        return;
+    }
+
     legion_network_state state(size());
 
     for (std::size_t index = 0; index < size(); index++) {
@@ -114,67 +164,51 @@ void legion_network::store_dynamic(const double time, const bool collect_dynamic
     state.m_inhibitor = m_global_inhibitor;
     state.m_time = time;
 
-    if ( (collect_dynamic == false) && (!dynamic.empty()) ) {
-        dynamic[0] = state;
+    if (reduce) {
+        collector.get_policy().observe(time, state.m_output);
     }
-    else {
-        dynamic.push_back(state);
+
+    if (sink) {
+        if (dynamic.empty()) {
+            sink->open({ { "output", size() }, { "inhibitor", 1 } });
+        }
+
+        float * row = sink->append(time);
+        std::copy(state.m_output.begin(), state.m_output.end(), row);
+        row[size()] = static_cast<float>(state.m_inhibitor);
+    }
+
+    if (action == dynamic_collector::action::APPEND) {
+        dynamic.push_back(std::move(state));
+    }
+    else if (action == dynamic_collector::action::REPLACE) {
+        dynamic[position] = std::move(state);
     }
 }
 
 void legion_network::calculate_states(const legion_stimulus & stimulus, const solve_type solver, const double t, const double step, const double int_step) {
-    std::vector< differ_result<double> > next_states(size());
-    std::vector<void *> argv(1, nullptr);
-
     std::size_t number_int_steps = static_cast<std::size_t>(step / int_step);
 
-    for (std::size_t index = 0; index < size(); index++) {
-        argv[0] = (void *) index;
+    legion_states next_states(m_params.ENABLE_POTENTIAL ? 3 : 2, size());
+    std::vector<double> potentials(size(), 0.0);
 
-        differ_state<double> inputs { m_oscillators[index].m_excitatory, m_oscillators[index].m_inhibitory };
-        if (m_params.ENABLE_POTENTIAL) {
-            inputs.push_back(m_oscillators[index].m_potential);
-        }
+    std::vector<size_t> neighbors;
 
-        switch(solver) {
-            case solve_type::FORWARD_EULER: {
-                throw std::invalid_argument("Forward Euler first-order method is not supported due to low accuracy.");
-            }
-
-            case solve_type::RUNGE_KUTTA_4: {
-                if (m_params.ENABLE_POTENTIAL) {
-                    equation<double> neuron_equation = std::bind(&legion_network::neuron_states, this, _1, _2, _3, _4);
-                    runge_kutta_4(neuron_equation, inputs, t, t + step, number_int_steps, false /* only last states */, argv, next_states[index]);
-                }
-                else {
-                    equation<double> neuron_simplify_equation = std::bind(&legion_network::neuron_simplify_states, this, _1, _2, _3, _4);
-                    runge_kutta_4(neuron_simplify_equation, inputs, t, t + step, number_int_steps, false /* only last states */, argv, next_states[index]);
-                }
-
-                break;
-            }
+    for (std::size_t index = 0; index < size(); index++) {
+        next_states(0, index) = m_oscillators[index].m_excitatory;
+        next_states(1, index) = m_oscillators[index].m_inhibitory;
 
-            case solve_type::RUNGE_KUTTA_FEHLBERG_45: {
-                if (m_params.ENABLE_POTENTIAL) {
-                    equation<double> neuron_equation = std::bind(&legion_network::neuron_states, this, _1, _2, _3, _4);
-                    runge_kutta_fehlberg_45(neuron_equation, inputs, t, t + step, 0.00001, false /* only last states */, argv, next_states[index]);
-                }
-                else {
-                    equation<double> neuron_simplify_equation = std::bind(&legion_network::neuron_simplify_states, this, _1, _2, _3, _4);
-                    runge_kutta_fehlberg_45(neuron_simplify_equation, inputs, t, t + step, 0.00001, false /* only last states */, argv, next_states[index]);
-                }
+        m_static_connections->get_neighbors(index, neighbors);
 
-                break;
-            }
+        if (m_params.ENABLE_POTENTIAL) {
+            next_states(2, index) = m_oscillators[index].m_potential;
 
-            default: {
-                throw std::invalid_argument("Not supported solver is used.");
+            /* excitatory states of neighbors are not changed during the step, so lateral potential is calculated once */
+            for (auto index_neighbor : neighbors) {
+                potentials[index] += m_params.T * heaviside(m_oscillators[index_neighbor].m_excitatory - m_params.teta_x);
             }
         }
 
-        std::vector<size_t> neighbors;
-        m_static_connections->get_neighbors(index, neighbors);
-
         double coupling = 0.0;
 
         for (auto & index_neighbor : neighbors) {
@@ -184,32 +218,37 @@ void legion_network::calculate_states(const legion_stimulus & stimulus, const so
         m_oscillators[index].m_buffer_coupling_term = coupling - m_params.Wz * heaviside(m_global_inhibitor - m_params.teta_xz);
     }
 
-    differ_result<double> inhibitor_next_state;
-    differ_state<double> inhibitor_input { m_global_inhibitor };
+    auto neuron_equation = [this, &potentials](const std::vector<double> & times, const legion_states & inputs, const std::size_t begin, const std::size_t end, legion_states & outputs) {
+        neuron_states(times, inputs, begin, end, potentials, outputs);
+    };
 
-    equation<double> inhibitor_equation = std::bind(&legion_network::inhibitor_state, this, _1, _2, _3, _4);
+    integrate(solver, neuron_equation, next_states, t, step, number_int_steps);
 
-    switch (solver) {
-        case solve_type::RUNGE_KUTTA_4: {
-            runge_kutta_4(inhibitor_equation, inhibitor_input, t, t + step, number_int_steps, false /* only last states */, argv, inhibitor_next_state);
-            break;
-        }
-        case solve_type::RUNGE_KUTTA_FEHLBERG_45: {
-            runge_kutta_fehlberg_45(inhibitor_equation, inhibitor_input, t, t + step, 0.00001, false /* only last states */, argv, inhibitor_next_state);
+    /* the same for the global inhibitor: excitatory states of oscillators are constant during the step */
+    double sigma = 0.0;
+    for (std::size_t index = 0; index < size(); index++) {
+        if (m_oscillators[index].m_excitatory > m_params.teta_zx) {
+            sigma = 1.0;
             break;
         }
-        default:
-            throw std::invalid_argument("Not supported solver is used.");
     }
 
-    m_global_inhibitor = inhibitor_next_state[0].state[0];
+    legion_inhibitor_state inhibitor { m_global_inhibitor };
+
+    auto inhibitor_equation = [this, sigma](const double time, const legion_inhibitor_state & inputs, legion_inhibitor_state & outputs) {
+        inhibitor_state(time, sigma, inputs, outputs);
+    };
+
+    integrate(solver, inhibitor_equation, inhibitor, t, step, number_int_steps);
+
+    m_global_inhibitor = inhibitor[0];
 
     for (std::size_t i = 0; i < size(); i++) {
-        m_oscillators[i].m_excitatory = next_states[i][0].state[0];
-        m_oscillators[i].m_inhibitory = next_states[i][0].state[1];
+        m_oscillators[i].m_excitatory = next_states(0, i);
+        m_oscillators[i].m_inhibitory = next_states(1, i);
 
         if (m_params.ENABLE_POTENTIAL) {
-            m_oscillators[i].m_potential = next_states[i][0].state[2];
+            m_oscillators[i].m_potential = next_states(2, i);
         }
 
         m_oscillators[i].m_coupling_term = m_oscillators[i].m_buffer_coupling_term;
@@ -218,76 +257,37 @@ void legion_network::calculate_states(const legion_stimulus & stimulus, const so
 }
 
 
-void legion_network::neuron_states(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) {
-    std::size_t index = (std::size_t) argv[0];
-
-    const double x = inputs[0];
-    const double y = inputs[1];
-    const double p = inputs[2];
-
-    double potential_influence = heaviside(p + std::exp(-m_params.alpha * t) - m_params.teta);
+void legion_network::neuron_states(const std::vector<double> & times, const legion_states & inputs, const std::size_t begin, const std::size_t end, const std::vector<double> & potentials, legion_states & outputs) const {
+    const double * x = inputs[0];
+    const double * y = inputs[1];
 
-    double stumulus = 0.0;
-    if ((*m_stimulus)[index] > 0) {
-        stumulus = m_params.I;
-    }
-
-    double dx = 3.0 * x - std::pow(x, 3) + 2.0 - y + stumulus * potential_influence + m_oscillators[index].m_coupling_term + m_oscillators[index].m_noise;
-    double dy = m_params.eps * (m_params.gamma * (1.0 + std::tanh(x / m_params.betta)) - y);
-
-    std::vector<std::size_t> neighbors;
-    m_static_connections->get_neighbors(index, neighbors);
-
-    double potential = 0.0;
-
-    for (auto index_neighbor : neighbors) {
-        potential += m_params.T * heaviside(m_oscillators[index_neighbor].m_excitatory - m_params.teta_x);
-    }
+    double * dx = outputs[0];
+    double * dy = outputs[1];
 
-    double dp = m_params.lamda * (1 - p) * heaviside(potential - m_params.teta_p) - m_params.mu * p;
-
-    outputs.clear();
-    outputs.push_back(dx);
-    outputs.push_back(dy);
-    outputs.push_back(dp);
-}
+    for (std::size_t index = begin; index < end; index++) {
+        double stumulus = 0.0;
+        if ((*m_stimulus)[index] > 0) {
+            stumulus = m_params.I;
+        }
 
+        if (m_params.ENABLE_POTENTIAL) {
+            const double p = inputs(2, index);
 
-void legion_network::neuron_simplify_states(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) {
-    std::size_t index = *(std::size_t *) argv[0];
+            double potential_influence = heaviside(p + std::exp(-m_params.alpha * times[index]) - m_params.teta);
+            stumulus *= potential_influence;
 
-    const double x = inputs[0];
-    const double y = inputs[1];
+            outputs(2, index) = m_params.lamda * (1 - p) * heaviside(potentials[index] - m_params.teta_p) - m_params.mu * p;
+        }
 
-    double stumulus = 0.0;
-    if ((*m_stimulus)[index] > 0) {
-        stumulus = m_params.I;
+        dx[index] = 3.0 * x[index] - std::pow(x[index], 3) + 2.0 - y[index] + stumulus + m_oscillators[index].m_coupling_term + m_oscillators[index].m_noise;
+        dy[index] = m_params.eps * (m_params.gamma * (1.0 + std::tanh(x[index] / m_params.betta)) - y[index]);
     }
-
-    double dx = 3.0 * x - std::pow(x, 3) + 2.0 - y + stumulus + m_oscillators[index].m_coupling_term + m_oscillators[index].m_noise;
-    double dy = m_params.eps * (m_params.gamma * (1.0 + std::tanh(x / m_params.betta)) - y);
-
-    outputs.clear();
-    outputs.push_back(dx);
-    outputs.push_back(dy);
 }
 
 
-void legion_network::inhibitor_state(const double t, const differ_state<double> & inputs, const differ_extra<void *> & argv, differ_state<double> & outputs) const {
+void legion_network::inhibitor_state(const double t, const double sigma, const legion_inhibitor_state & inputs, legion_inhibitor_state & outputs) const {
     const double z = inputs[0];
-
-    double sigma = 0.0;
-    for (std::size_t index = 0; index < size(); index++) {
-        if (m_oscillators[index].m_excitatory > m_params.teta_zx) {
-            sigma = 1.0;
-            break;
-        }
-    }
-
-    double dz = m_params.fi * (sigma - z);
-
-    outputs.clear();
-    outputs.push_back(dz);
+    outputs[0] = m_params.fi * (sigma - z);
 }
 
 
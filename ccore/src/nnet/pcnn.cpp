@@ -9,6 +9,8 @@
 
 #include <pyclustering/nnet/pcnn.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -16,6 +18,11 @@
 #include <pyclustering/container/adjacency_connector.hpp>
 #include <pyclustering/container/adjacency_matrix.hpp>
 
+#include <pyclustering/parallel/parallel.hpp>
+
+
+using namespace pyclustering::parallel;
+
 
 namespace pyclustering {
 
@@ -24,12 +31,298 @@ namespace nnet {
 
 const std::size_t pcnn::MAXIMUM_MATRIX_REPRESENTATION_SIZE = 4096;
 
+const std::size_t pcnn_grid_kernel::BAND_SIZE = 16384;
+
+
+static const std::size_t WORD_BITS = 64;
+
+
+static std::size_t lowest_bit(const std::uint64_t p_word) {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(p_word));
+#else
+    std::size_t index = 0;
+    for (std::uint64_t word = p_word; (word & 1U) == 0; word >>= 1U) {
+        index++;
+    }
+
+    return index;
+#endif
+}
+
 
 std::size_t pcnn_network_state::size() const {
     return m_output.size();
 }
 
 
+
+pcnn_grid_kernel::pcnn_grid_kernel(const std::size_t p_width, const std::size_t p_height, const connection_t p_structure, const pcnn_parameters & p_parameters) :
+    m_width(p_width),
+    m_height(p_height),
+    m_stride((p_width + WORD_BITS - 1) / WORD_BITS),
+    m_diagonal(p_structure == connection_t::CONNECTION_GRID_EIGHT),
+    m_params(p_parameters)
+{
+    if ((p_structure != connection_t::CONNECTION_GRID_FOUR) && (p_structure != connection_t::CONNECTION_GRID_EIGHT)) {
+        throw std::invalid_argument("Grid structure of connection is expected.");
+    }
+
+    if (m_width != 0) {
+        m_band_rows = std::max(std::size_t(1), (BAND_SIZE + m_width - 1) / m_width);
+    }
+
+    /* influence is accumulated neighbor by neighbor like in case of arbitrary connections */
+    const std::size_t maximum_neighbors = m_diagonal ? 8 : 4;
+    double feeding_influence = 0.0, linking_influence = 0.0;
+    for (std::size_t amount = 0; amount <= maximum_neighbors; amount++) {
+        m_feeding_influence.push_back(feeding_influence * m_params.VF);
+        m_linking_influence.push_back(linking_influence * m_params.VL);
+
+        feeding_influence += m_params.M;
+        linking_influence += m_params.W;
+    }
+
+    m_feeding.assign(size(), 0.0);
+    m_linking.assign(size(), 0.0);
+    m_threshold.assign(size(), 0.0);
+
+    m_output.assign(m_stride * m_height, 0);
+    m_next.assign(m_stride * m_height, 0);
+    m_changed.assign(m_stride * m_height, 0);
+    m_next_changed.assign(m_stride * m_height, 0);
+    m_row_changed.assign(m_height, 0);
+    m_next_row_changed.assign(m_height, 0);
+}
+
+
+void pcnn_grid_kernel::calculate_states(const pcnn_stimulus & p_stimulus) {
+    if (p_stimulus.size() != size()) {
+        throw std::out_of_range("pcnn_grid_kernel::calculate_states: length of stimulus should be equal to amount of oscillators in the network.");
+    }
+
+    process_bands([this, &p_stimulus](const std::size_t p_row) {
+        const std::uint64_t * upper = (p_row > 0) ? &m_output[(p_row - 1) * m_stride] : nullptr;
+        const std::uint64_t * current = &m_output[p_row * m_stride];
+        const std::uint64_t * lower = (p_row + 1 < m_height) ? &m_output[(p_row + 1) * m_stride] : nullptr;
+
+        for (std::size_t word = 0; word < m_stride; word++) {
+            /* oscillators without active neighbors in the word are processed without the stencil */
+            std::uint64_t neighborhood = 0;
+            for (std::size_t neighbor_word = (word > 0) ? word - 1 : 0; neighbor_word < std::min(word + 2, m_stride); neighbor_word++) {
+                neighborhood |= current[neighbor_word];
+                neighborhood |= upper ? upper[neighbor_word] : 0;
+                neighborhood |= lower ? lower[neighbor_word] : 0;
+            }
+
+            std::uint64_t outputs = 0;
+            const std::size_t column_end = std::min(m_width, (word + 1) * WORD_BITS);
+            for (std::size_t column = word * WORD_BITS; column < column_end; column++) {
+                const std::size_t index = p_row * m_width + column;
+                const std::size_t active = (neighborhood != 0) ? count_active_neighbors(m_output, p_row, column) : 0;
+
+                m_feeding[index] = m_params.AF * m_feeding[index] + p_stimulus[index] + m_feeding_influence[active];
+                m_linking[index] = m_params.AL * m_linking[index] + m_linking_influence[active];
+
+                /* calculate internal activity */
+                const double internal_activity = m_feeding[index] * (1.0 + m_params.B * m_linking[index]);
+                if (internal_activity > m_threshold[index]) {
+                    outputs |= std::uint64_t(1) << (column % WORD_BITS);
+                }
+            }
+
+            m_next[p_row * m_stride + word] = outputs;
+        }
+    });
+
+    if (m_params.FAST_LINKING) {
+        fast_linking();
+    }
+
+    process_bands([this](const std::size_t p_row) {
+        for (std::size_t column = 0; column < m_width; column++) {
+            const std::size_t index = p_row * m_width + column;
+            const bool active = ((m_next[p_row * m_stride + column / WORD_BITS] >> (column % WORD_BITS)) & 1U) != 0;
+
+            m_threshold[index] = m_params.AT * m_threshold[index] + m_params.VT * (active ? OUTPUT_ACTIVE_STATE : OUTPUT_INACTIVE_STATE);
+        }
+    });
+
+    std::swap(m_output, m_next);
+}
+
+
+double pcnn_grid_kernel::get_output(const std::size_t p_index) const {
+    const std::size_t row = p_index / m_width;
+    const std::size_t column = p_index % m_width;
+
+    const bool active = ((m_output[row * m_stride + column / WORD_BITS] >> (column % WORD_BITS)) & 1U) != 0;
+    return active ? OUTPUT_ACTIVE_STATE : OUTPUT_INACTIVE_STATE;
+}
+
+
+template <typename TypeAction>
+void pcnn_grid_kernel::process_bands(const TypeAction & p_action) {
+    const std::size_t amount_bands = (m_height + m_band_rows - 1) / m_band_rows;
+
+    parallel_for(std::size_t(0), amount_bands, [this, &p_action](const std::size_t p_band) {
+        const std::size_t row_end = std::min(m_height, (p_band + 1) * m_band_rows);
+        for (std::size_t row = p_band * m_band_rows; row < row_end; row++) {
+            p_action(row);
+        }
+    });
+}
+
+
+std::size_t pcnn_grid_kernel::count_active_neighbors(const bit_row & p_outputs, const std::size_t p_row, const std::size_t p_column) const {
+    const auto is_active = [this, &p_outputs](const std::size_t p_neighbor_row, const std::size_t p_neighbor_column) {
+        return static_cast<std::size_t>((p_outputs[p_neighbor_row * m_stride + p_neighbor_column / WORD_BITS] >> (p_neighbor_column % WORD_BITS)) & 1U);
+    };
+
+    const bool has_left = (p_column > 0);
+    const bool has_right = (p_column + 1 < m_width);
+
+    std::size_t active = 0;
+    if (has_left) {
+        active += is_active(p_row, p_column - 1);
+    }
+
+    if (has_right) {
+        active += is_active(p_row, p_column + 1);
+    }
+
+    for (const std::size_t neighbor_row : { p_row - 1, p_row + 1 }) {
+        if (neighbor_row >= m_height) {
+            continue;   /* out of the grid, including wrapped 'p_row - 1' */
+        }
+
+        active += is_active(neighbor_row, p_column);
+        if (m_diagonal) {
+            active += has_left ? is_active(neighbor_row, p_column - 1) : 0;
+            active += has_right ? is_active(neighbor_row, p_column + 1) : 0;
+        }
+    }
+
+    return active;
+}
+
+
+bool pcnn_grid_kernel::calculate_fast_linking(const std::size_t p_row, const std::size_t p_column) {
+    const std::size_t index = p_row * m_width + p_column;
+
+    m_linking[index] = m_linking_influence[count_active_neighbors(m_next, p_row, p_column)];
+
+    const double internal_activity = m_feeding[index] * (1.0 + m_params.B * m_linking[index]);
+    const bool active = (internal_activity > m_threshold[index]);
+    const bool previous = ((m_next[p_row * m_stride + p_column / WORD_BITS] >> (p_column % WORD_BITS)) & 1U) != 0;
+
+    return active != previous;
+}
+
+
+void pcnn_grid_kernel::fast_linking() {
+    /* the first iteration visits each oscillator because linking is calculated without the previous linking */
+    process_bands([this](const std::size_t p_row) { fast_linking_row(p_row); });
+
+    while (true) {
+        /* outputs are updated after the iteration, so each oscillator uses outputs of the previous iteration */
+        process_bands([this](const std::size_t p_row) {
+            if (m_next_row_changed[p_row]) {
+                for (std::size_t word = 0; word < m_stride; word++) {
+                    m_next[p_row * m_stride + word] ^= m_next_changed[p_row * m_stride + word];
+                }
+            }
+        });
+
+        std::swap(m_changed, m_next_changed);
+        std::swap(m_row_changed, m_next_row_changed);
+
+        if (std::none_of(m_row_changed.begin(), m_row_changed.end(), [](const char p_changed) { return p_changed != 0; })) {
+            break;
+        }
+
+        process_bands([this](const std::size_t p_row) { fast_linking_frontier_row(p_row); });
+    }
+}
+
+
+void pcnn_grid_kernel::fast_linking_row(const std::size_t p_row) {
+    bool row_changed = false;
+    for (std::size_t word = 0; word < m_stride; word++) {
+        std::uint64_t changed = 0;
+
+        const std::size_t column_end = std::min(m_width, (word + 1) * WORD_BITS);
+        for (std::size_t column = word * WORD_BITS; column < column_end; column++) {
+            if (calculate_fast_linking(p_row, column)) {
+                changed |= std::uint64_t(1) << (column % WORD_BITS);
+            }
+        }
+
+        m_next_changed[p_row * m_stride + word] = changed;
+        row_changed |= (changed != 0);
+    }
+
+    m_next_row_changed[p_row] = row_changed ? 1 : 0;
+}
+
+
+void pcnn_grid_kernel::fast_linking_frontier_row(const std::size_t p_row) {
+    const bool upper_changed = (p_row > 0) && m_row_changed[p_row - 1];
+    const bool lower_changed = (p_row + 1 < m_height) && m_row_changed[p_row + 1];
+
+    if (!upper_changed && !m_row_changed[p_row] && !lower_changed) {
+        m_next_row_changed[p_row] = 0;
+        return;
+    }
+
+    bool row_changed = false;
+    for (std::size_t word = 0; word < m_stride; word++) {
+        std::uint64_t changed = 0;
+        for (std::uint64_t candidates = candidate_word(p_row, word); candidates != 0; candidates &= candidates - 1) {
+            const std::size_t column = word * WORD_BITS + lowest_bit(candidates);
+            if (calculate_fast_linking(p_row, column)) {
+                changed |= std::uint64_t(1) << (column % WORD_BITS);
+            }
+        }
+
+        m_next_changed[p_row * m_stride + word] = changed;
+        row_changed |= (changed != 0);
+    }
+
+    m_next_row_changed[p_row] = row_changed ? 1 : 0;
+}
+
+
+std::uint64_t pcnn_grid_kernel::candidate_word(const std::size_t p_row, const std::size_t p_word) const {
+    const auto changed = [this](const std::size_t p_changed_row, const std::size_t p_changed_word) -> std::uint64_t {
+        if ((p_changed_row >= m_height) || (p_changed_word >= m_stride) || !m_row_changed[p_changed_row]) {
+            return 0;
+        }
+
+        return m_changed[p_changed_row * m_stride + p_changed_word];
+    };
+
+    /* oscillator is a candidate if its left or right neighbor is changed */
+    const auto horizontal = [&changed, p_word](const std::size_t p_changed_row) -> std::uint64_t {
+        const std::uint64_t left = (changed(p_changed_row, p_word) << 1U) | ((p_word > 0) ? (changed(p_changed_row, p_word - 1) >> (WORD_BITS - 1)) : 0);
+        const std::uint64_t right = (changed(p_changed_row, p_word) >> 1U) | (changed(p_changed_row, p_word + 1) << (WORD_BITS - 1));
+        return left | right;
+    };
+
+    std::uint64_t candidates = horizontal(p_row) | changed(p_row - 1, p_word) | changed(p_row + 1, p_word);
+    if (m_diagonal) {
+        candidates |= horizontal(p_row - 1) | horizontal(p_row + 1);
+    }
+
+    const std::size_t tail = m_width % WORD_BITS;
+    if ((p_word + 1 == m_stride) && (tail != 0)) {
+        candidates &= (std::uint64_t(1) << tail) - 1;
+    }
+
+    return candidates;
+}
+
+
 pcnn::pcnn() : m_oscillators(0), m_connection(), m_params() { }
 
 
@@ -43,24 +336,62 @@ pcnn::pcnn(const size_t p_size, const connection_t p_structure, const size_t p_h
 }
 
 
+pcnn::pcnn(const pcnn & p_other) {
+    operator=(p_other);
+}
+
+
+pcnn & pcnn::operator=(const pcnn & p_other) {
+    if (&p_other == this) {
+        return *this;
+    }
+
+    m_oscillators = p_other.m_oscillators;
+    m_connection = p_other.m_connection;
+    m_grid = p_other.m_grid ? std::make_unique<pcnn_grid_kernel>(*p_other.m_grid) : nullptr;
+    m_params = p_other.m_params;
+
+    return *this;
+}
+
+
 void pcnn::simulate(const std::size_t steps, const pcnn_stimulus & stimulus, pcnn_dynamic & output_dynamic) {
-    output_dynamic.resize(steps, size());
+    simulate(steps, stimulus, collection_policy::all(), output_dynamic);
+}
+
+
+void pcnn::simulate(const std::size_t steps, const pcnn_stimulus & stimulus, const collection_policy & policy, pcnn_dynamic & output_dynamic) {
+    output_dynamic.clear();
+
+    /* only the last state is kept in memory when the dynamic is passed to the sink */
+    const bool sink_attached = (output_dynamic.get_sink() != nullptr);
+    output_dynamic.reserve(sink_attached ? 1 : policy.get_capacity(steps));
+
+    policy.reset(size());
+    dynamic_collector collector(policy, 0, sink_attached);
 
     for (std::size_t i = 0; i < steps; i++) {
         calculate_states(stimulus);
-        store_dynamic(i, output_dynamic);
+        store_dynamic(i, collector, output_dynamic);
     }
+
+    collector.arrange(output_dynamic);
 }
 
 void pcnn::calculate_states(const pcnn_stimulus & stimulus) {
-    std::vector<double> feeding(size(), 0.0);
-    std::vector<double> linking(size(), 0.0);
-    std::vector<double> outputs(size(), 0.0);
-
     if (stimulus.size() != size()) {
         throw std::out_of_range("pcnn::calculate_states: length of stimulus should be equal to amount of oscillators in the network.");
     }
 
+    if (m_grid) {
+        m_grid->calculate_states(stimulus);
+        return;
+    }
+
+    std::vector<double> feeding(size(), 0.0);
+    std::vector<double> linking(size(), 0.0);
+    std::vector<double> outputs(size(), 0.0);
+
     for (std::size_t index = 0; index < size(); index++) {
         pcnn_oscillator & current_oscillator = m_oscillators[index];
         std::vector<size_t> neighbors;
@@ -157,18 +488,75 @@ void pcnn::fast_linking(const std::vector<double> & feeding, std::vector<double>
 }
 
 
-void pcnn::store_dynamic(const std::size_t step, pcnn_dynamic & dynamic) const {
-    pcnn_network_state & current_state = (pcnn_network_state &) dynamic[step];
+void pcnn::store_dynamic(const std::size_t step, dynamic_collector & collector, pcnn_dynamic & dynamic) const {
+    std::size_t position = 0;
+    const dynamic_collector::action action = collector.next(position);
+
+    const dynamic_sink::ptr sink = collector.is_recorded() ? dynamic.get_sink() : nullptr;
+    const bool reduce = !collector.get_policy().get_reductions().empty();
+
+    if ( (action == dynamic_collector::action::SKIP) && !sink && !reduce ) {
+        return;
+    }
+
+    pcnn_network_state current_state;
     current_state.m_output.resize(size());
 
     current_state.m_time = (double) step;
-    for (size_t i = 0; i < m_oscillators.size(); i++) {
-        current_state.m_output[i] = m_oscillators[i].output;
+    if (m_grid) {
+        for (size_t i = 0; i < size(); i++) {
+            current_state.m_output[i] = m_grid->get_output(i);
+        }
+    }
+    else {
+        for (size_t i = 0; i < m_oscillators.size(); i++) {
+            current_state.m_output[i] = m_oscillators[i].output;
+        }
+    }
+
+    if (reduce) {
+        collector.get_policy().observe(current_state.m_time, current_state.m_output);
+    }
+
+    if (sink) {
+        if (dynamic.empty()) {
+            sink->open({ { "output", size() } });
+        }
+
+        float * row = sink->append(current_state.m_time);
+        std::copy(current_state.m_output.begin(), current_state.m_output.end(), row);
+    }
+
+    if (action == dynamic_collector::action::APPEND) {
+        dynamic.push_back(std::move(current_state));
+    }
+    else if (action == dynamic_collector::action::REPLACE) {
+        dynamic[position] = std::move(current_state);
     }
 }
 
 
 void pcnn::initilize(const size_t p_size, const connection_t p_structure, const size_t p_height, const size_t p_width, const pcnn_parameters & p_parameters) {
+    if ((p_structure == connection_t::CONNECTION_GRID_FOUR) || (p_structure == connection_t::CONNECTION_GRID_EIGHT)) {
+        /* grid connections are not stored, states are calculated by the stencil of the grid kernel */
+        std::size_t width = p_width, height = p_height;
+        if ((width == 0) || (height == 0)) {
+            const double side_size = std::sqrt((double) p_size);
+            if (side_size - std::floor(side_size) > 0) {
+                throw std::runtime_error("Invalid number of nodes in the adjacency for the square grid structure.");
+            }
+
+            width = height = (std::size_t) side_size;
+        }
+        else if (width * height != p_size) {
+            throw std::runtime_error("Invalid number of nodes in the adjacency for the grid structure.");
+        }
+
+        m_grid = std::make_unique<pcnn_grid_kernel>(width, height, p_structure, p_parameters);
+        m_params = p_parameters;
+        return;
+    }
+
     m_oscillators = std::vector<pcnn_oscillator>(p_size, pcnn_oscillator());
     
     if (p_size > MAXIMUM_MATRIX_REPRESENTATION_SIZE) {
@@ -8,15 +8,23 @@
 
 #include <pyclustering/nnet/som.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <climits>
+#include <cstring>
 #include <exception>
+#include <fstream>
 #include <random>
+#include <stdexcept>
+#include <string>
+
+#include <pyclustering/parallel/parallel.hpp>
 
 #include <pyclustering/utils/metric.hpp>
 
 
+using namespace pyclustering::parallel;
 using namespace pyclustering::utils::metric;
 
 
@@ -38,6 +46,41 @@ som_parameters & som_parameters::operator=(const som_parameters & p_other) {
 }
 
 
+const std::size_t som::INDEX_MINIMUM_SIZE = 64;
+
+const std::size_t som::INDEX_MAXIMUM_DIMENSION = 16;
+
+const char som::FILE_SIGNATURE[4] = { 'S', 'O', 'M', 'B' };
+
+const std::uint32_t som::FILE_VERSION = 1;
+
+
+template <typename TypeValue>
+static void write_values(const TypeValue * p_values, const std::size_t p_amount, std::ostream & p_stream) {
+    p_stream.write(reinterpret_cast<const char *>(p_values), static_cast<std::streamsize>(p_amount * sizeof(TypeValue)));
+}
+
+
+template <typename TypeValue>
+static void write_value(const TypeValue & p_value, std::ostream & p_stream) {
+    write_values(&p_value, 1, p_stream);
+}
+
+
+template <typename TypeValue>
+static TypeValue read_value(const utils::mapped_file & p_file, std::size_t & p_position) {
+    if (p_position + sizeof(TypeValue) > p_file.size()) {
+        throw std::invalid_argument("som: file is corrupted (unexpected end of the file at position '" + std::to_string(p_position) + "').");
+    }
+
+    TypeValue value;
+    std::memcpy(&value, p_file.data() + p_position, sizeof(TypeValue));
+    p_position += sizeof(TypeValue);
+
+    return value;
+}
+
+
 som::som(const size_t num_rows, const size_t num_cols, const som_conn_type type_conn, const som_parameters & parameters) :
     m_rows(num_rows),
     m_cols(num_cols),
@@ -46,7 +89,6 @@ som::som(const size_t num_rows, const size_t num_cols, const som_conn_type type_
     m_awards(m_size, 0),
     m_data(nullptr),
     m_location(m_size),
-    m_sqrt_distances(m_size, std::vector<double>(m_size, 0)),
     m_capture_objects(m_size),
     m_params(parameters) 
 {
@@ -65,25 +107,13 @@ som::som(const size_t num_rows, const size_t num_cols, const som_conn_type type_
         }
     }
 
-    /* distances */
-    for (std::size_t i = 0; i < m_size; i++) {
-        std::vector<double> column_distances(m_size, 0);
-        m_sqrt_distances[i] = column_distances;
-    }
-
-    for (std::size_t i = 0; i < m_size; i++) {
-        m_sqrt_distances[i][i] = 0.0;
-        for (std::size_t j = i + 1; j < m_size; j++) {
-            double distance = euclidean_distance_square(m_location[i], m_location[j]);
-            m_sqrt_distances[i][j] = distance;
-            m_sqrt_distances[j][i] = distance;
-        }
-    }
-
     /* connections */
     if (type_conn != som_conn_type::SOM_FUNC_NEIGHBOR) {
         create_connections(type_conn);
     }
+    else {
+        create_offsets();
+    }
 }
 
 
@@ -190,6 +220,54 @@ void som::create_connections(const som_conn_type type) {
 }
 
 
+void som::create_offsets() {
+    const double initial_radius = m_params.init_radius * m_params.init_radius;
+    const long long rows = static_cast<long long>(m_rows);
+    const long long cols = static_cast<long long>(m_cols);
+
+    m_offsets.clear();
+    for (long long row = -(rows - 1); row < rows; row++) {
+        for (long long col = -(cols - 1); col < cols; col++) {
+            const std::size_t distance = static_cast<std::size_t>(row * row + col * col);
+            if (static_cast<double>(distance) < initial_radius) {
+                m_offsets.push_back({ row, col, distance });
+            }
+        }
+    }
+
+    std::stable_sort(m_offsets.begin(), m_offsets.end(), [](const grid_offset & p_offset1, const grid_offset & p_offset2) {
+        return p_offset1.distance < p_offset2.distance;
+    });
+}
+
+
+void som::update_neighborhood() {
+    auto border = std::partition_point(m_offsets.begin(), m_offsets.end(), [this](const grid_offset & p_offset) {
+        return static_cast<double>(p_offset.distance) < m_local_radius;
+    });
+
+    m_offsets_in_radius = static_cast<std::size_t>(std::distance(m_offsets.begin(), border));
+
+    const std::size_t maximum_distance = (m_rows - 1) * (m_rows - 1) + (m_cols - 1) * (m_cols - 1);
+
+    m_influences.clear();
+    for (std::size_t distance = 0; (distance <= maximum_distance) && (static_cast<double>(distance) < m_local_radius); distance++) {
+        m_influences.push_back(std::exp( -( static_cast<double>(distance) / (2.0 * m_local_radius) ) ));
+    }
+}
+
+
+std::size_t som::grid_distance_square(const std::size_t p_neuron1, const std::size_t p_neuron2) const {
+    const std::size_t row_difference = (p_neuron1 / m_cols > p_neuron2 / m_cols) ?
+        p_neuron1 / m_cols - p_neuron2 / m_cols : p_neuron2 / m_cols - p_neuron1 / m_cols;
+
+    const std::size_t col_difference = (p_neuron1 % m_cols > p_neuron2 % m_cols) ?
+        p_neuron1 % m_cols - p_neuron2 % m_cols : p_neuron2 % m_cols - p_neuron1 % m_cols;
+
+    return row_difference * row_difference + col_difference * col_difference;
+}
+
+
 void som::create_initial_weights(const som_init_type type) {
     size_t dimension = (*m_data)[0].size();
 
@@ -325,24 +403,57 @@ size_t som::competition(const pattern & input_pattern) const {
 }
 
 
+std::size_t som::competition(const double * p_weight_matrix, const pattern & p_pattern) const {
+    static thread_local std::vector<double> distances;
+    distances.assign(m_size, 0.0);
+
+    /* distances are accumulated dimension by dimension in the same order as by 'euclidean_distance_square' */
+    for (std::size_t dim = 0; dim < p_pattern.size(); dim++) {
+        const double coordinate = p_pattern[dim];
+        const double * const weights = p_weight_matrix + dim * m_size;
+
+        for (std::size_t i = 0; i < m_size; i++) {
+            const double difference = coordinate - weights[i];
+            distances[i] += difference * difference;
+        }
+    }
+
+    std::size_t index = 0;
+    for (std::size_t i = 1; i < m_size; i++) {
+        if (distances[i] < distances[index]) {
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+
 size_t som::adaptation(const size_t index_winner, const pattern & input_pattern) {
     size_t dimensions = m_weights[0].size();
     size_t number_adapted_neurons = 0;
 
     if (m_conn_type == som_conn_type::SOM_FUNC_NEIGHBOR) {
-        for (size_t neuron_index = 0; neuron_index < m_size; neuron_index++) {
-            double distance = m_sqrt_distances[index_winner][neuron_index];
+        const long long winner_row = static_cast<long long>(index_winner / m_cols);
+        const long long winner_col = static_cast<long long>(index_winner % m_cols);
 
-            if (distance < m_local_radius) {
-                double influence = std::exp( -( distance / (2.0 * m_local_radius) ) );
+        for (std::size_t index_offset = 0; index_offset < m_offsets_in_radius; index_offset++) {
+            const grid_offset & offset = m_offsets[index_offset];
+            const long long row = winner_row + offset.row;
+            const long long col = winner_col + offset.col;
 
-                std::vector<double> & neuron_weight = m_weights[neuron_index];
-                for (size_t dim = 0; dim < dimensions; dim++) {
-                    neuron_weight[dim] += m_learn_rate * influence * (input_pattern[dim] - m_weights[neuron_index][dim]);
-                }
+            if ( (row < 0) || (col < 0) || (row >= (long long) m_rows) || (col >= (long long) m_cols) ) {
+                continue;
+            }
 
-                number_adapted_neurons++;
+            const double influence = m_influences[offset.distance];
+
+            std::vector<double> & neuron_weight = m_weights[static_cast<std::size_t>(row) * m_cols + static_cast<std::size_t>(col)];
+            for (size_t dim = 0; dim < dimensions; dim++) {
+                neuron_weight[dim] += m_learn_rate * influence * (input_pattern[dim] - neuron_weight[dim]);
             }
+
+            number_adapted_neurons++;
         }
     }
     else {
@@ -353,10 +464,10 @@ size_t som::adaptation(const size_t index_winner, const pattern & input_pattern)
 
         std::vector<size_t> & winner_neighbors = m_neighbors[index_winner];
         for (auto & neighbor_index : winner_neighbors) {
-            double distance = m_sqrt_distances[index_winner][neighbor_index];
+            const std::size_t distance = grid_distance_square(index_winner, neighbor_index);
 
-            if (distance < m_local_radius) {
-                double influence = std::exp( -( distance / (2.0 * m_local_radius) ) );
+            if (distance < m_influences.size()) {
+                const double influence = m_influences[distance];
 
                 std::vector<double> & neighbor_weight = m_weights[neighbor_index];
                 for (size_t dim = 0; dim < dimensions; dim++) {
@@ -373,6 +484,11 @@ size_t som::adaptation(const size_t index_winner, const pattern & input_pattern)
 
 
 size_t som::train(const dataset & input_data, const size_t num_epochs, bool autostop) {
+    return train(input_data, num_epochs, autostop, som_train_mode::SOM_ONLINE);
+}
+
+
+size_t som::train(const dataset & input_data, const size_t num_epochs, bool autostop, const som_train_mode p_mode) {
     for (size_t i = 0; i < m_capture_objects.size(); i++) {
         m_capture_objects[i].clear();
         m_awards[i] = 0;
@@ -384,6 +500,11 @@ size_t som::train(const dataset & input_data, const size_t num_epochs, bool auto
     /* store pointer to data (we are not owners, we don't need them after training) */
     m_data = &input_data;
 
+    /* weights are not taken from the binary file anymore */
+    m_file.reset();
+    m_mapped_weights = nullptr;
+    m_mapped_dimension = 0;
+
     /* create weights */
     create_initial_weights(m_params.init_type);
 
@@ -393,6 +514,8 @@ size_t som::train(const dataset & input_data, const size_t num_epochs, bool auto
         m_local_radius = std::pow( ( m_params.init_radius * std::exp(-( (double) epouch / (double) m_epouchs)) ), 2);
         m_learn_rate = m_params.init_learn_rate * std::exp(-( (double) epouch / (double) m_epouchs));
 
+        update_neighborhood();
+
         if (autostop == true) {
             for (size_t i = 0; i < m_size; i++) {
                 m_awards[i] = 0;
@@ -400,24 +523,18 @@ size_t som::train(const dataset & input_data, const size_t num_epochs, bool auto
             }
         }
 
-        for (size_t i = 0; i < m_data->size(); i++) {
-            /* Step 1: Competition */
-            size_t index_winner = competition((*m_data)[i]);
-
-            /* Step 2: Adaptation */
-            adaptation(index_winner, (*m_data)[i]);
-
-            /* Update statistics */
-            if ( (autostop == true) || (epouch == m_epouchs) ) {
-                m_awards[index_winner]++;
-                m_capture_objects[index_winner].push_back(i);
-            }
+        const bool collect = (autostop == true) || (epouch == m_epouchs);
+        if (p_mode == som_train_mode::SOM_BATCH) {
+            train_batch_epoch(collect);
+        }
+        else {
+            train_online_epoch(collect);
         }
 
         if (autostop == true) {
             double maximal_adaptation = calculate_maximal_adaptation();
             if (maximal_adaptation < m_params.adaptation_threshold) {
-                return epouch;
+                break;
             }
 
             for (size_t i = 0; i < m_weights.size(); i++) {
@@ -426,10 +543,121 @@ size_t som::train(const dataset & input_data, const size_t num_epochs, bool auto
         }
     }
 
+    build_index();
+
     return epouch;
 }
 
 
+void som::train_online_epoch(const bool p_collect) {
+    for (size_t i = 0; i < m_data->size(); i++) {
+        /* Step 1: Competition */
+        size_t index_winner = competition((*m_data)[i]);
+
+        /* Step 2: Adaptation */
+        adaptation(index_winner, (*m_data)[i]);
+
+        /* Update statistics */
+        if (p_collect) {
+            m_awards[index_winner]++;
+            m_capture_objects[index_winner].push_back(i);
+        }
+    }
+}
+
+
+void som::train_batch_epoch(const bool p_collect) {
+    const std::size_t dimensions = m_weights[0].size();
+    const std::size_t amount_patterns = m_data->size();
+
+    /* Step 1: Competition for all patterns using weights that are stored dimension by dimension */
+    std::vector<double> weight_matrix(dimensions * m_size);
+    for (std::size_t i = 0; i < m_size; i++) {
+        for (std::size_t dim = 0; dim < dimensions; dim++) {
+            weight_matrix[dim * m_size + i] = m_weights[i][dim];
+        }
+    }
+
+    std::vector<std::size_t> winners(amount_patterns);
+    parallel_for(std::size_t(0), amount_patterns, [this, &weight_matrix, &winners](const std::size_t p_index) {
+        winners[p_index] = competition(weight_matrix.data(), (*m_data)[p_index]);
+    });
+
+    /* Step 2: Sum of captured patterns by each neuron */
+    std::vector<double> pattern_sums(m_size * dimensions, 0.0);
+    std::vector<std::size_t> pattern_amounts(m_size, 0);
+
+    for (std::size_t i = 0; i < amount_patterns; i++) {
+        const std::size_t index_winner = winners[i];
+        const pattern & input_pattern = (*m_data)[i];
+
+        double * const sum = pattern_sums.data() + index_winner * dimensions;
+        for (std::size_t dim = 0; dim < dimensions; dim++) {
+            sum[dim] += input_pattern[dim];
+        }
+
+        pattern_amounts[index_winner]++;
+
+        if (p_collect) {
+            m_awards[index_winner]++;
+            m_capture_objects[index_winner].push_back(i);
+        }
+    }
+
+    /* Step 3: Adaptation - each weight is neighborhood-weighted average of captured patterns */
+    parallel_for(std::size_t(0), m_size, [this, dimensions, &pattern_sums, &pattern_amounts](const std::size_t p_neuron) {
+        std::vector<double> numerator(dimensions, 0.0);
+        double denominator = 0.0;
+
+        auto accumulate = [dimensions, &pattern_sums, &pattern_amounts, &numerator, &denominator](const std::size_t p_winner, const double p_influence) {
+            if (pattern_amounts[p_winner] == 0) {
+                return;
+            }
+
+            const double * const sum = pattern_sums.data() + p_winner * dimensions;
+            for (std::size_t dim = 0; dim < dimensions; dim++) {
+                numerator[dim] += p_influence * sum[dim];
+            }
+
+            denominator += p_influence * static_cast<double>(pattern_amounts[p_winner]);
+        };
+
+        if (m_conn_type == som_conn_type::SOM_FUNC_NEIGHBOR) {
+            const long long neuron_row = static_cast<long long>(p_neuron / m_cols);
+            const long long neuron_col = static_cast<long long>(p_neuron % m_cols);
+
+            for (std::size_t index_offset = 0; index_offset < m_offsets_in_radius; index_offset++) {
+                const grid_offset & offset = m_offsets[index_offset];
+                const long long row = neuron_row + offset.row;
+                const long long col = neuron_col + offset.col;
+
+                if ( (row >= 0) && (col >= 0) && (row < (long long) m_rows) && (col < (long long) m_cols) ) {
+                    accumulate(static_cast<std::size_t>(row) * m_cols + static_cast<std::size_t>(col), m_influences[offset.distance]);
+                }
+            }
+        }
+        else {
+            accumulate(p_neuron, 1.0);
+
+            /* connections are symmetric, so neighbors of the neuron are winners that adapt it */
+            for (const std::size_t index_winner : m_neighbors[p_neuron]) {
+                const std::size_t distance = grid_distance_square(index_winner, p_neuron);
+                if (distance < m_influences.size()) {
+                    accumulate(index_winner, m_influences[distance]);
+                }
+            }
+        }
+
+        if (denominator > 0.0) {
+            std::vector<double> & neuron_weight = m_weights[p_neuron];
+            for (std::size_t dim = 0; dim < dimensions; dim++) {
+                neuron_weight[dim] = numerator[dim] / denominator;
+            }
+        }
+    });
+}
+
+
 void som::load(const dataset & p_weights, const som_award_sequence & p_awards, const som_gain_sequence & p_capture_objects) {
     if (p_weights.size() != m_size) {
         throw std::invalid_argument("Provided weights (" + std::to_string(p_weights.size()) + 
@@ -438,6 +666,10 @@ void som::load(const dataset & p_weights, const som_award_sequence & p_awards, c
 
     m_weights = p_weights;
 
+    m_file.reset();
+    m_mapped_weights = nullptr;
+    m_mapped_dimension = 0;
+
     if (!p_capture_objects.empty()) {
         if (p_capture_objects.size() != m_size) {
             throw std::invalid_argument("Provided capture objects (size '" + std::to_string(p_capture_objects.size()) + 
@@ -455,11 +687,216 @@ void som::load(const dataset & p_weights, const som_award_sequence & p_awards, c
 
         m_awards = p_awards;
     }
+
+    build_index();
+}
+
+
+void som::save(const std::string & p_filename) const {
+    std::ofstream stream(p_filename, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        throw std::invalid_argument("som: file '" + p_filename + "' cannot be created.");
+    }
+
+    const dataset & weights = get_weights();
+    const std::size_t dimension = weights.empty() ? 0 : weights[0].size();
+
+    std::vector<std::uint64_t> capture_offsets(m_size + 1, 0);
+    for (std::size_t i = 0; i < m_size; i++) {
+        capture_offsets[i + 1] = capture_offsets[i] + m_capture_objects[i].size();
+    }
+
+    /* header is aligned to 8 bytes, so weights in the mapped file are aligned too */
+    write_values(FILE_SIGNATURE, sizeof(FILE_SIGNATURE), stream);
+    write_value(FILE_VERSION, stream);
+    write_value(static_cast<std::uint64_t>(m_rows), stream);
+    write_value(static_cast<std::uint64_t>(m_cols), stream);
+    write_value(static_cast<std::uint32_t>(m_conn_type), stream);
+    write_value(static_cast<std::uint32_t>(m_params.init_type), stream);
+    write_value(m_params.init_radius, stream);
+    write_value(m_params.init_learn_rate, stream);
+    write_value(m_params.adaptation_threshold, stream);
+    write_value(static_cast<std::int64_t>(m_params.random_state), stream);
+    write_value(static_cast<std::uint64_t>(dimension), stream);
+    write_value(capture_offsets.back(), stream);
+
+    std::vector<double> coordinates(m_size);
+    for (std::size_t dim = 0; dim < dimension; dim++) {
+        for (std::size_t i = 0; i < m_size; i++) {
+            coordinates[i] = weights[i][dim];
+        }
+
+        write_values(coordinates.data(), coordinates.size(), stream);
+    }
+
+    const std::vector<std::uint64_t> awards(m_awards.begin(), m_awards.end());
+    write_values(awards.data(), awards.size(), stream);
+    write_values(capture_offsets.data(), capture_offsets.size(), stream);
+
+    for (const auto & objects : m_capture_objects) {
+        const std::vector<std::uint64_t> indexes(objects.begin(), objects.end());
+        write_values(indexes.data(), indexes.size(), stream);
+    }
+
+    if (!stream.good()) {
+        throw std::runtime_error("som: network cannot be written to file '" + p_filename + "'.");
+    }
+}
+
+
+void som::load(const std::string & p_filename) {
+    auto file = std::make_shared<const utils::mapped_file>(p_filename);
+
+    if ((file->size() < sizeof(FILE_SIGNATURE)) || !std::equal(std::begin(FILE_SIGNATURE), std::end(FILE_SIGNATURE), file->data())) {
+        throw std::invalid_argument("som: file '" + p_filename + "' does not have SOM signature.");
+    }
+
+    std::size_t position = sizeof(FILE_SIGNATURE);
+
+    const auto version = read_value<std::uint32_t>(*file, position);
+    if (version != FILE_VERSION) {
+        throw std::invalid_argument("som: unsupported version of the file '" + std::to_string(version) + "'.");
+    }
+
+    const auto rows = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+    const auto cols = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+    const auto conn_type = read_value<std::uint32_t>(*file, position);
+
+    som_parameters params;
+    params.init_type = static_cast<som_init_type>(read_value<std::uint32_t>(*file, position));
+    params.init_radius = read_value<double>(*file, position);
+    params.init_learn_rate = read_value<double>(*file, position);
+    params.adaptation_threshold = read_value<double>(*file, position);
+    params.random_state = static_cast<long long>(read_value<std::int64_t>(*file, position));
+
+    const auto dimension = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+    const auto amount_captured = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+
+    /* sizes are checked step by step to avoid overflow in case of corrupted file */
+    const std::size_t limit = file->size() / sizeof(std::uint64_t);
+    if ( (rows == 0) || (cols == 0) || (rows > limit) || (cols > limit / rows) || (dimension > limit / (rows * cols)) ||
+         (amount_captured > limit) || (conn_type > static_cast<std::uint32_t>(som_conn_type::SOM_FUNC_NEIGHBOR)) ||
+         (params.init_type > som_init_type::SOM_UNIFORM_GRID) )
+    {
+        throw std::invalid_argument("som: file '" + p_filename + "' is corrupted (invalid header).");
+    }
+
+    const std::size_t size = rows * cols;
+    const std::size_t weights_position = position;
+    const std::size_t expected_size = position + (size * dimension + 2 * size + 1 + amount_captured) * sizeof(std::uint64_t);
+    if (expected_size != file->size()) {
+        throw std::invalid_argument("som: size of the file '" + std::to_string(file->size()) +
+            "' does not correspond to its content (expected '" + std::to_string(expected_size) + "').");
+    }
+
+    som network(rows, cols, static_cast<som_conn_type>(conn_type), params);
+
+    position += size * dimension * sizeof(double);
+    for (std::size_t i = 0; i < size; i++) {
+        network.m_awards[i] = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+    }
+
+    std::vector<std::size_t> capture_offsets(size + 1);
+    for (std::size_t i = 0; i < size + 1; i++) {
+        capture_offsets[i] = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+        if ( ((i > 0) && (capture_offsets[i] < capture_offsets[i - 1])) || (capture_offsets[i] > amount_captured) ) {
+            throw std::invalid_argument("som: file '" + p_filename + "' is corrupted (invalid captured objects).");
+        }
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+        auto & objects = network.m_capture_objects[i];
+        objects.resize(capture_offsets[i + 1] - capture_offsets[i]);
+
+        for (auto & index_object : objects) {
+            index_object = static_cast<std::size_t>(read_value<std::uint64_t>(*file, position));
+        }
+    }
+
+    network.m_file = file;
+    network.m_mapped_weights = (dimension > 0) ? reinterpret_cast<const double *>(file->data() + weights_position) : nullptr;
+    network.m_mapped_dimension = dimension;
+
+    *this = network;
+    build_index();
+}
+
+
+const dataset & som::get_weights() const {
+    std::lock_guard<std::mutex> guard(m_weights_lock);
+
+    if ((m_mapped_weights != nullptr) && m_weights.empty()) {
+        m_weights.assign(m_size, std::vector<double>(m_mapped_dimension));
+        for (std::size_t dim = 0; dim < m_mapped_dimension; dim++) {
+            for (std::size_t i = 0; i < m_size; i++) {
+                m_weights[i][dim] = m_mapped_weights[dim * m_size + i];
+            }
+        }
+    }
+
+    return m_weights;
 }
 
 
 size_t som::simulate(const pattern & input_pattern) const {
-    return competition(input_pattern);
+    if (m_index.get_root() == nullptr) {
+        return (m_mapped_weights != nullptr) ? competition(m_mapped_weights, input_pattern) : competition(input_pattern);
+    }
+
+    std::size_t index_winner = 0;
+    double distance = std::numeric_limits<double>::max();
+    find_winner(m_index.get_root(), input_pattern, index_winner, distance);
+
+    return index_winner;
+}
+
+
+void som::simulate(const dataset & p_patterns, std::vector<std::size_t> & p_winners) const {
+    p_winners.resize(p_patterns.size());
+    parallel_for(std::size_t(0), p_patterns.size(), [this, &p_patterns, &p_winners](const std::size_t p_index) {
+        p_winners[p_index] = simulate(p_patterns[p_index]);
+    });
+}
+
+
+void som::build_index() {
+    const std::size_t dimension = m_weights.empty() ? 0 : m_weights[0].size();
+
+    /* mapped weights are not indexed: nodes of the tree would keep a private copy of the shared weights */
+    if ((m_mapped_weights != nullptr) || (m_size < INDEX_MINIMUM_SIZE) || (dimension == 0) || (dimension > INDEX_MAXIMUM_DIMENSION)) {
+        m_index = container::kdtree_balanced();
+        return;
+    }
+
+    std::vector<void *> payloads(m_size);
+    for (std::size_t i = 0; i < m_size; i++) {
+        payloads[i] = (void *) i;
+    }
+
+    m_index = container::kdtree_balanced(m_weights, payloads);
+}
+
+
+void som::find_winner(const container::kdnode::ptr & p_node, const pattern & p_pattern, std::size_t & p_winner, double & p_distance) const {
+    const double candidate = euclidean_distance_square(p_node->get_data(), p_pattern);
+    const std::size_t index_candidate = (std::size_t) p_node->get_payload();
+    if ( (candidate < p_distance) || ((candidate == p_distance) && (index_candidate < p_winner)) ) {
+        p_winner = index_candidate;
+        p_distance = candidate;
+    }
+
+    /* left subtree contains neurons with smaller coordinate, right - with bigger or equal */
+    const double difference = p_pattern[p_node->get_discriminator()] - p_node->get_value();
+    const container::kdnode::ptr nearest = (difference < 0.0) ? p_node->get_left() : p_node->get_right();
+    const container::kdnode::ptr farthest = (difference < 0.0) ? p_node->get_right() : p_node->get_left();
+
+    if (nearest != nullptr) {
+        find_winner(nearest, p_pattern, p_winner, p_distance);
+    }
+
+    if ( (farthest != nullptr) && (difference * difference <= p_distance) ) {
+        find_winner(farthest, p_pattern, p_winner, p_distance);
+    }
 }
 
 
@@ -515,7 +952,7 @@ std::ostream & operator<<(std::ostream & p_stream, const som & p_network) {
     p_stream << static_cast<std::uint64_t>(p_network.m_rows) << "\n";
     p_stream << static_cast<std::uint64_t>(p_network.m_cols) << "\n";
     p_stream << static_cast<std::uint64_t>(p_network.m_conn_type) << "\n";
-    p_stream << pyclustering::to_string(p_network.m_weights) << "\n";
+    p_stream << pyclustering::to_string(p_network.get_weights()) << "\n";
     p_stream << pyclustering::to_string(p_network.m_awards) << "\n";
     p_stream << pyclustering::to_string(p_network.m_location) << "\n";
     p_stream << pyclustering::to_string(p_network.m_capture_objects) << "\n";
@@ -536,14 +973,26 @@ som & som::operator=(const som & p_other) {
 
     m_conn_type = p_other.m_conn_type;
 
-    m_weights = p_other.m_weights;
+    {
+        std::lock_guard<std::mutex> guard(p_other.m_weights_lock);
+        m_weights = p_other.m_weights;
+    }
+
     m_previous_weights = p_other.m_previous_weights;
     m_awards = p_other.m_awards;
 
     m_location = p_other.m_location;
-    m_sqrt_distances = p_other.m_sqrt_distances;
     m_capture_objects = p_other.m_capture_objects;
     m_neighbors = p_other.m_neighbors;
+    m_index = p_other.m_index;
+
+    m_file = p_other.m_file;
+    m_mapped_weights = p_other.m_mapped_weights;
+    m_mapped_dimension = p_other.m_mapped_dimension;
+
+    m_offsets = p_other.m_offsets;
+    m_offsets_in_radius = p_other.m_offsets_in_radius;
+    m_influences = p_other.m_influences;
 
     m_epouchs = p_other.m_epouchs;
     m_params = p_other.m_params;
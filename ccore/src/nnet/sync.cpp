@@ -8,6 +8,7 @@
 
 #include <pyclustering/nnet/sync.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <complex>
@@ -16,6 +17,7 @@
 
 #include <pyclustering/container/adjacency_bit_matrix.hpp>
 #include <pyclustering/container/adjacency_connector.hpp>
+#include <pyclustering/container/adjacency_list.hpp>
 #include <pyclustering/container/adjacency_matrix.hpp>
 
 #include <pyclustering/differential/runge_kutta_4.hpp>
@@ -48,6 +50,20 @@ const std::size_t sync_network::PARALLEL_RROCESSING_THRESHOLD           = 64;
 
 
 
+static bool is_all_to_all(const adjacency_collection & p_connections) {
+    for (std::size_t i = 0; i < p_connections.size(); i++) {
+        for (std::size_t j = 0; j < p_connections.size(); j++) {
+            if (p_connections.has_connection(i, j) != (i != j)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+
 double sync_ordering::calculate_sync_order(const std::vector<double> & p_phases) {
     phase_getter getter = [&p_phases](std::size_t index){ return p_phases[index]; };
     return calculate_sync_order_parameter(p_phases, getter);
@@ -91,8 +107,24 @@ double sync_ordering::calculate_local_sync_order(const std::shared_ptr<adjacency
 }
 
 
+double sync_ordering::calculate_local_sync_order_all_to_all(const std::vector<double> & p_phases) {
+    phase_getter getter = [&p_phases](std::size_t index){ return p_phases[index]; };
+    return calculate_all_to_all_local_sync_order_parameter(p_phases.size(), getter);
+}
+
+
+double sync_ordering::calculate_local_sync_order_all_to_all(const std::vector<sync_oscillator> & p_oscillators) {
+    phase_getter getter = [&p_oscillators](std::size_t index){ return p_oscillators[index].phase; };
+    return calculate_all_to_all_local_sync_order_parameter(p_oscillators.size(), getter);
+}
+
+
 template <class TypeContainer>
 double sync_ordering::calculate_local_sync_order_parameter(const std::shared_ptr<adjacency_collection> & p_connections, const TypeContainer & p_container, const phase_getter & p_getter) {
+    if (is_all_to_all(*p_connections)) {
+        return calculate_all_to_all_local_sync_order_parameter(p_container.size(), p_getter);
+    }
+
     double exp_amount = 0.0;
     double number_neighbors = 0.0;
 
@@ -118,6 +150,32 @@ double sync_ordering::calculate_local_sync_order_parameter(const std::shared_ptr
 }
 
 
+double sync_ordering::calculate_all_to_all_local_sync_order_parameter(const std::size_t p_size, const phase_getter & p_getter) {
+    if (p_size < 2) {
+        return 0.0;
+    }
+
+    std::vector<double> phases(p_size);
+    for (std::size_t i = 0; i < p_size; i++) {
+        phases[i] = p_getter(i);
+    }
+
+    std::sort(phases.begin(), phases.end());
+
+    /* in sorted order exp(-|phase_j - phase_i|) = exp(phase_i - phase_j) for i < j, so the sum over previous
+       oscillators is updated from the previous one: S(j) = (S(j - 1) + 1) * exp(phase_(j-1) - phase_j) */
+    double exp_amount = 0.0;
+    double exp_previous = 0.0;
+    for (std::size_t j = 1; j < p_size; j++) {
+        exp_previous = (exp_previous + 1.0) * std::exp(phases[j - 1] - phases[j]);
+        exp_amount += exp_previous;
+    }
+
+    const double number_neighbors = static_cast<double>(p_size) * static_cast<double>(p_size - 1);
+    return 2.0 * exp_amount / number_neighbors;
+}
+
+
 
 sync_network::sync_network(const size_t size, const double weight_factor, const double frequency_factor, const connection_t connection_type, const initial_type initial_phases) {
     initialize(size, weight_factor, frequency_factor, connection_type, 0, 0, initial_phases);
@@ -135,7 +193,10 @@ sync_network::~sync_network() { }
 void sync_network::initialize(const std::size_t size, const double weight_factor, const double frequency_factor, const connection_t connection_type, const std::size_t height, const std::size_t width, const initial_type initial_phases) {
     m_oscillators = std::vector<sync_oscillator>(size, sync_oscillator());
     
-    if (size > MAXIMUM_MATRIX_REPRESENTATION_SIZE) {
+    if (connection_type == connection_t::CONNECTION_NONE) {
+        m_connections = std::make_shared<adjacency_list>(size);     /* connections might be added later, but they are sparse as a rule */
+    }
+    else if (size > MAXIMUM_MATRIX_REPRESENTATION_SIZE) {
         m_connections = std::make_shared<adjacency_bit_matrix>(size);
     }
     else {
@@ -188,12 +249,25 @@ double sync_network::sync_order() const {
 
 
 double sync_network::sync_local_order() const {
+    if (m_mean_field) {
+        return sync_ordering::calculate_local_sync_order_all_to_all(m_oscillators);
+    }
+
     return sync_ordering::calculate_local_sync_order(m_connections, m_oscillators);
 }
 
 
 void sync_network::set_equation(const equation<double> & solver) {
     m_equation = solver;
+    m_network_integration = false;
+    m_kuramoto_equation = false;
+    m_mean_field = false;
+}
+
+
+void sync_network::disable_network_integration() {
+    m_network_integration = false;
+    m_mean_field = false;
 }
 
 
@@ -205,6 +279,12 @@ void sync_network::phase_kuramoto_equation(const double t, const differ_state<do
 
 double sync_network::phase_kuramoto(const double t, const double teta, const std::vector<void *> & argv) const {
     std::size_t index = *(std::size_t *) argv[0];
+
+    if (m_mean_field) {
+        const double current_phase = m_oscillators[index].phase;
+        return phase_kuramoto_mean_field(index, teta, m_sum_sin - std::sin(current_phase), m_sum_cos - std::cos(current_phase));
+    }
+
     double phase = 0.0;
 
     std::vector<size_t> neighbors;
@@ -220,28 +300,56 @@ double sync_network::phase_kuramoto(const double t, const double teta, const std
 
 
 void sync_network::simulate_static(const std::size_t steps, const double time, const solve_type solver, const bool collect_dynamic, sync_dynamic & output_dynamic) {
+    simulate_static(steps, time, solver, collect_dynamic ? collection_policy::all() : collection_policy::last(), output_dynamic);
+}
+
+
+void sync_network::simulate_static(const std::size_t steps, const double time, const solve_type solver, const collection_policy & policy, sync_dynamic & output_dynamic) {
     output_dynamic.clear();
+    if (!output_dynamic.get_sink()) {
+        output_dynamic.reserve(policy.get_capacity(steps + 1));
+    }
+
+    if (m_network_integration) {
+        create_neighbor_arrays();   /* connections might be changed since the last simulation */
+    }
 
     const double step = time / (double) steps;
     const double int_step = step / 10.0;
 
-    store_dynamic(0.0, collect_dynamic, output_dynamic);    /* store initial state */
+    policy.reset(size());
+    dynamic_collector collector(policy, 0, output_dynamic.get_sink() != nullptr);
+
+    store_dynamic(0.0, collector, output_dynamic);    /* store initial state */
 
     double cur_time = step;
     for (std::size_t cur_step = 0; cur_step < steps; cur_step++) {
         calculate_phases(solver, cur_time, step, int_step);
 
-        store_dynamic(cur_time, collect_dynamic, output_dynamic);
+        store_dynamic(cur_time, collector, output_dynamic);
 
         cur_time += step;
     }
+
+    collector.arrange(output_dynamic);
 }
 
 
 void sync_network::simulate_dynamic(const double order, const double step, const solve_type solver, const bool collect_dynamic, sync_dynamic & output_dynamic) {
+    simulate_dynamic(order, step, solver, collect_dynamic ? collection_policy::all() : collection_policy::last(), output_dynamic);
+}
+
+
+void sync_network::simulate_dynamic(const double order, const double step, const solve_type solver, const collection_policy & policy, sync_dynamic & output_dynamic) {
     output_dynamic.clear();
+    if (m_network_integration) {
+        create_neighbor_arrays();   /* connections might be changed since the last simulation */
+    }
+
+    policy.reset(size());
+    dynamic_collector collector(policy, 0, output_dynamic.get_sink() != nullptr);
 
-    store_dynamic(0, collect_dynamic, output_dynamic);     /* store initial state */
+    store_dynamic(0, collector, output_dynamic);     /* store initial state */
 
     double current_order = sync_local_order();
 
@@ -250,7 +358,7 @@ void sync_network::simulate_dynamic(const double order, const double step, const
     for (double time_counter = step; current_order < order; time_counter += step) {
         calculate_phases(solver, time_counter, step, integration_step);
 
-        store_dynamic(time_counter, collect_dynamic, output_dynamic);
+        store_dynamic(time_counter, collector, output_dynamic);
 
         double previous_order = current_order;
         current_order = sync_local_order();
@@ -260,10 +368,30 @@ void sync_network::simulate_dynamic(const double order, const double step, const
             break;
         }
     }
+
+    collector.arrange(output_dynamic);
 }
 
 
 void sync_network::store_dynamic(const double time, const bool collect_dynamic, sync_dynamic & output_dynamic) const {
+    const collection_policy policy = collect_dynamic ? collection_policy::all() : collection_policy::last();
+    dynamic_collector collector(policy, output_dynamic.size(), output_dynamic.get_sink() != nullptr);
+
+    store_dynamic(time, collector, output_dynamic);
+}
+
+
+void sync_network::store_dynamic(const double time, dynamic_collector & collector, sync_dynamic & output_dynamic) const {
+    std::size_t position = 0;
+    const dynamic_collector::action action = collector.next(position);
+
+    const dynamic_sink::ptr sink = collector.is_recorded() ? output_dynamic.get_sink() : nullptr;
+    const bool reduce = !collector.get_policy().get_reductions().empty();
+
+    if ( (action == dynamic_collector::action::SKIP) && !sink && !reduce ) {
+        return;     /* state is not required, the step is not stored */
+    }
+
     sync_network_state state(size());
 
     for (std::size_t index = 0; index < size(); index++) {
@@ -272,16 +400,44 @@ void sync_network::store_dynamic(const double time, const bool collect_dynamic,
 
     state.m_time = time;
 
-    if ( (collect_dynamic == false) && (!output_dynamic.empty()) ) {
-        output_dynamic[0] = state;
+    if (reduce) {
+        collector.get_policy().observe(time, state.m_phase);
     }
-    else {
-        output_dynamic.push_back(state);
+
+    if (sink) {
+        if (output_dynamic.empty()) {
+            sink->open({ { "phase", size() } });
+        }
+
+        float * row = sink->append(time);
+        std::copy(state.m_phase.begin(), state.m_phase.end(), row);
+    }
+
+    if (action == dynamic_collector::action::APPEND) {
+        output_dynamic.push_back(std::move(state));
+    }
+    else if (action == dynamic_collector::action::REPLACE) {
+        output_dynamic[position] = std::move(state);
     }
 }
 
 
 void sync_network::calculate_phases(const solve_type solver, const double t, const double step, const double int_step) {
+    if (m_network_integration) {
+        if (m_neighbor_offsets.size() != size() + 1) {
+            create_neighbor_arrays();
+        }
+
+        if (m_mean_field) {
+            calculate_mean_field();
+        }
+
+        if (solver == solve_type::RUNGE_KUTTA_4) {
+            calculate_phases_network(t, step, int_step);
+            return;
+        }
+    }
+
     std::vector<double> next_phases(size(), 0.0);
 
     if (size() < PARALLEL_RROCESSING_THRESHOLD) {
@@ -302,6 +458,107 @@ void sync_network::calculate_phases(const solve_type solver, const double t, con
 }
 
 
+void sync_network::create_neighbor_arrays() {
+    m_neighbor_offsets.assign(size() + 1, 0);
+    m_neighbor_indexes.clear();
+
+    m_mean_field = is_all_to_all(*m_connections);
+    if (m_mean_field) {
+        m_neighbor_indexes.shrink_to_fit();
+        return;
+    }
+
+    std::vector<std::size_t> neighbors;
+    for (std::size_t index = 0; index < size(); index++) {
+        m_connections->get_neighbors(index, neighbors);
+        m_neighbor_indexes.insert(m_neighbor_indexes.end(), neighbors.begin(), neighbors.end());
+        m_neighbor_offsets[index + 1] = m_neighbor_indexes.size();
+    }
+}
+
+
+void sync_network::calculate_phases_network(const double t, const double step, const double int_step) {
+    m_current_phases.resize(size());
+    m_next_phases.resize(size());
+    for (std::size_t index = 0; index < size(); index++) {
+        m_current_phases[index] = m_oscillators[index].phase;
+    }
+
+    /* the same amount of steps and the same step length as in case of the generic solver */
+    const std::size_t number_int_steps = (std::size_t) (step / int_step);
+    const double int_step_length = ((t + step) - t) / (double) number_int_steps;
+
+    auto integrate = [this, number_int_steps, int_step_length](const std::size_t p_index) {
+        double phase = m_current_phases[p_index];
+
+        double neighbors_sin = 0.0, neighbors_cos = 0.0;
+        if (m_mean_field) {
+            neighbors_sin = m_sum_sin - std::sin(phase);
+            neighbors_cos = m_sum_cos - std::cos(phase);
+        }
+
+        auto derivative = [this, p_index, neighbors_sin, neighbors_cos](const double p_teta) {
+            return m_mean_field ? phase_kuramoto_mean_field(p_index, p_teta, neighbors_sin, neighbors_cos)
+                                : phase_kuramoto_network(p_index, p_teta);
+        };
+
+        for (std::size_t i = 0; i < number_int_steps; i++) {
+            const double k1 = derivative(phase) * int_step_length;
+            const double k2 = derivative(phase + k1 / 2.0) * int_step_length;
+            const double k3 = derivative(phase + k2 / 2.0) * int_step_length;
+            const double k4 = derivative(phase + k3) * int_step_length;
+
+            phase += (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
+        }
+
+        m_next_phases[p_index] = phase_normalization(phase);
+    };
+
+    if (size() < PARALLEL_RROCESSING_THRESHOLD) {
+        for (std::size_t index = 0; index < size(); index++) {
+            integrate(index);
+        }
+    }
+    else {
+        parallel_for(std::size_t(0), size(), integrate);
+    }
+
+    for (std::size_t index = 0; index < size(); index++) {
+        m_oscillators[index].phase = m_next_phases[index];
+    }
+}
+
+
+double sync_network::phase_kuramoto_network(const std::size_t p_index, const double p_teta) const {
+    const std::size_t * const neighbors = m_neighbor_indexes.data();
+    const double * const phases = m_current_phases.data();
+
+    double phase = 0.0;
+    for (std::size_t k = m_neighbor_offsets[p_index]; k < m_neighbor_offsets[p_index + 1]; k++) {
+        phase += std::sin(phases[neighbors[k]] - p_teta);
+    }
+
+    return m_oscillators[p_index].frequency + (phase * weight / static_cast<double>(size()));
+}
+
+
+void sync_network::calculate_mean_field() {
+    m_sum_sin = 0.0;
+    m_sum_cos = 0.0;
+
+    for (const auto & oscillator : m_oscillators) {
+        m_sum_sin += std::sin(oscillator.phase);
+        m_sum_cos += std::cos(oscillator.phase);
+    }
+}
+
+
+double sync_network::phase_kuramoto_mean_field(const std::size_t p_index, const double p_teta, const double p_neighbors_sin, const double p_neighbors_cos) const {
+    const double phase = p_neighbors_sin * std::cos(p_teta) - p_neighbors_cos * std::sin(p_teta);
+    return m_oscillators[p_index].frequency + (phase * weight / static_cast<double>(size()));
+}
+
+
 void sync_network::calculate_phase(const solve_type solver,
                                    const double t,
                                    const double step,
@@ -331,11 +588,24 @@ void sync_network::calculate_phase(const solve_type solver,
             break;
         }
         case solve_type::RUNGE_KUTTA_FEHLBERG_45: {
-            differ_state<double> inputs(1, m_oscillators[index].phase);
-            differ_result<double> outputs;
+            if (m_kuramoto_equation) {
+                /* built-in equation is integrated without 'std::function' and allocation of stage states */
+                differ_fixed_state<double, 1> state { m_oscillators[index].phase };
 
-            runge_kutta_fehlberg_45(m_equation, inputs, t, t + step, 0.00001, false, argv, outputs);
-            p_next_phases[index] = phase_normalization( outputs[0].state[0] );
+                auto phase_equation = [this, &argv](const double time, const differ_fixed_state<double, 1> & inputs, differ_fixed_state<double, 1> & outputs) {
+                    outputs[0] = phase_kuramoto(time, inputs[0], argv);
+                };
+
+                runge_kutta_fehlberg_45(phase_equation, state, t, t + step, 0.00001);
+                p_next_phases[index] = phase_normalization(state[0]);
+            }
+            else {
+                differ_state<double> inputs(1, m_oscillators[index].phase);
+                differ_result<double> outputs;
+
+                runge_kutta_fehlberg_45(m_equation, inputs, t, t + step, 0.00001, false, argv, outputs);
+                p_next_phases[index] = phase_normalization( outputs[0].state[0] );
+            }
 
             break;
         }
@@ -15,8 +15,6 @@
 #include <pyclustering/utils/metric.hpp>
 
 
-using namespace std::placeholders;
-
 using namespace pyclustering::utils::math;
 using namespace pyclustering::utils::metric;
 
@@ -43,8 +41,7 @@ syncpr::syncpr(const unsigned int num_osc,
     m_increase_strength2(increase_strength2),
     m_coupling(num_osc, std::vector<double>(num_osc, 0.0))
 {
-    equation<double> oscillator_equation = std::bind(&syncpr::phase_kuramoto_equation, this, _1, _2, _3, _4);
-    set_equation(oscillator_equation);
+    disable_network_integration();
 }
 
 
@@ -59,8 +56,7 @@ syncpr::syncpr(const unsigned int num_osc,
     m_increase_strength2(increase_strength2),
     m_coupling(num_osc, std::vector<double>(num_osc, 0.0))
 {
-    equation<double> oscillator_equation = std::bind(&syncpr::phase_kuramoto_equation, this, _1, _2, _3, _4);
-    set_equation(oscillator_equation);
+    disable_network_integration();
 }
 
 
@@ -176,26 +172,61 @@ double syncpr::calculate_memory_order(const syncpr_pattern & input_pattern) cons
 }
 
 
-double syncpr::phase_kuramoto(const double t, const double teta, const std::vector<void *> & argv) const {
-    std::size_t oscillator_index = *(std::size_t *)argv[0];
+void syncpr::calculate_phases(const solve_type solver, const double t, const double step, const double int_step) {
+    calculate_derivatives();
+    sync_network::calculate_phases(solver, t, step, int_step);
+}
+
 
-    double phase = 0.0;
-    double term = 0.0;
+void syncpr::calculate_derivatives() {
+    const std::size_t number_oscillators = size();
 
-    for (std::size_t neighbor_index = 0; neighbor_index < size(); neighbor_index++) {
-        if (oscillator_index != neighbor_index) {
-            double phase_delta = m_oscillators[neighbor_index].phase - m_oscillators[oscillator_index].phase;
+    std::vector<double> phase_sin(number_oscillators), phase_cos(number_oscillators);
 
-            phase += m_coupling[oscillator_index][neighbor_index] * std::sin(phase_delta);
+    double sum_sin2 = 0.0, sum_cos2 = 0.0;
+    double sum_sin3 = 0.0, sum_cos3 = 0.0;
+
+    for (std::size_t i = 0; i < number_oscillators; i++) {
+        const double phase = m_oscillators[i].phase;
+
+        phase_sin[i] = std::sin(phase);
+        phase_cos[i] = std::cos(phase);
+
+        sum_sin2 += std::sin(2.0 * phase);
+        sum_cos2 += std::cos(2.0 * phase);
+        sum_sin3 += std::sin(3.0 * phase);
+        sum_cos3 += std::cos(3.0 * phase);
+    }
 
-            double term1 = m_increase_strength1 * std::sin(2.0 * phase_delta);
-            double term2 = m_increase_strength2 * std::sin(3.0 * phase_delta);
+    m_derivatives.resize(number_oscillators);
 
-            term += (term1 - term2);
+    /* sin(phase_j - phase_i) = sin(phase_j) * cos(phase_i) - cos(phase_j) * sin(phase_i), therefore sums over
+       neighbors do not require trigonometric functions for each pair of oscillators, terms of the second and the
+       third harmonics do not depend on coupling and they are calculated using mean field (term for 'j = i' is 0) */
+    for (std::size_t i = 0; i < number_oscillators; i++) {
+        const std::vector<double> & coupling = m_coupling[i];
+
+        double coupling_sin = 0.0, coupling_cos = 0.0;
+        for (std::size_t j = 0; j < number_oscillators; j++) {
+            coupling_sin += coupling[j] * phase_sin[j];
+            coupling_cos += coupling[j] * phase_cos[j];
         }
+
+        const double phase = m_oscillators[i].phase;
+        const double coupling_term = coupling_sin * phase_cos[i] - coupling_cos * phase_sin[i];
+
+        const double term1 = m_increase_strength1 * (sum_sin2 * std::cos(2.0 * phase) - sum_cos2 * std::sin(2.0 * phase));
+        const double term2 = m_increase_strength2 * (sum_sin3 * std::cos(3.0 * phase) - sum_cos3 * std::sin(3.0 * phase));
+
+        m_derivatives[i] = coupling_term + (term1 - term2) / ((double) number_oscillators);
     }
+}
+
 
-    return ( phase + term / ((double) size()) );
+double syncpr::phase_kuramoto(const double t, const double teta, const std::vector<void *> & argv) const {
+    /* the derivative depends only on phases at the beginning of the step, so it is calculated once per step */
+    std::size_t oscillator_index = *(std::size_t *)argv[0];
+    return m_derivatives[oscillator_index];
 }
 
 
@@ -0,0 +1,115 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <pyclustering/utils/mapped_file.hpp>
+
+#include <stdexcept>
+
+#if defined(WIN32) || (_WIN32) || (_WIN64)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace pyclustering {
+
+namespace utils {
+
+
+#if defined(WIN32) || (_WIN32) || (_WIN64)
+
+mapped_file::mapped_file(const std::string & p_filename) {
+    HANDLE file = CreateFileA(p_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::invalid_argument("File '" + p_filename + "' cannot be opened.");
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (size.QuadPart == 0)) {
+        CloseHandle(file);
+        throw std::invalid_argument("File '" + p_filename + "' is empty or its size cannot be obtained.");
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        throw std::runtime_error("File '" + p_filename + "' cannot be mapped to memory.");
+    }
+
+    void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("File '" + p_filename + "' cannot be mapped to memory.");
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const char *>(data);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+}
+
+
+mapped_file::~mapped_file() {
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+}
+
+#else
+
+mapped_file::mapped_file(const std::string & p_filename) {
+    const int descriptor = open(p_filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::invalid_argument("File '" + p_filename + "' cannot be opened.");
+    }
+
+    struct stat status;
+    if ((fstat(descriptor, &status) != 0) || (status.st_size == 0)) {
+        close(descriptor);
+        throw std::invalid_argument("File '" + p_filename + "' is empty or its size cannot be obtained.");
+    }
+
+    void * data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);  /* mapping is kept after closing the descriptor */
+
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("File '" + p_filename + "' cannot be mapped to memory.");
+    }
+
+    m_data = static_cast<const char *>(data);
+    m_size = static_cast<std::size_t>(status.st_size);
+}
+
+
+mapped_file::~mapped_file() {
+    munmap(const_cast<char *>(m_data), m_size);
+}
+
+#endif
+
+
+const char * mapped_file::data() const {
+    return m_data;
+}
+
+
+std::size_t mapped_file::size() const {
+    return m_size;
+}
+
+
+}
+
+}
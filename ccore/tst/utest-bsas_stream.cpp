@@ -0,0 +1,173 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <pyclustering/cluster/bsas_stream.hpp>
+
+#include "samples.hpp"
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+
+
+static void
+template_bsas_stream_length_process_data(const dataset_ptr p_data,
+        const std::size_t p_amount,
+        const double p_threshold,
+        const std::vector<std::size_t> & p_expected_cluster_length,
+        const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean())
+{
+    bsas_stream stream(p_amount, p_threshold, p_metric);
+
+    index_sequence labels;
+    stream.push_batch(*p_data, labels);
+
+    ASSERT_EQ(p_data->size(), labels.size());
+    ASSERT_EQ(p_expected_cluster_length.size(), stream.size());
+
+    std::vector<std::size_t> sizes(stream.size(), 0);
+    for (const auto label : labels) {
+        ASSERT_LT(label, stream.size());
+        sizes[label]++;
+    }
+
+    ASSERT_EQ(sizes, stream.cluster_sizes());
+
+    std::sort(sizes.begin(), sizes.end());
+    std::vector<std::size_t> expected_sizes = p_expected_cluster_length;
+    std::sort(expected_sizes.begin(), expected_sizes.end());
+    ASSERT_EQ(expected_sizes, sizes);
+
+    representative_sequence representatives;
+    stream.get_representatives(representatives);
+    ASSERT_EQ(stream.size(), representatives.size());
+}
+
+
+TEST(utest_bsas_stream, allocation_sample_simple_01) {
+    template_bsas_stream_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 2, 1.0, { 5, 5 });
+}
+
+TEST(utest_bsas_stream, allocation_sample_simple_01_manhattan) {
+    template_bsas_stream_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 2, 1.0, { 5, 5 }, distance_metric_factory<point>::manhattan());
+}
+
+TEST(utest_bsas_stream, allocation_one_cluster_sample_simple_01) {
+    template_bsas_stream_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 2, 10.0, { 10 });
+}
+
+TEST(utest_bsas_stream, allocation_sample_simple_02) {
+    template_bsas_stream_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 3, 1.0, { 5, 8, 10 });
+}
+
+TEST(utest_bsas_stream, representative_is_mean) {
+    bsas_stream stream(1, 0.5);
+    stream.push({ 1.0 });
+    stream.push({ 2.0 });
+    stream.push({ 6.0 });
+
+    representative_sequence representatives;
+    stream.get_representatives(representatives);
+
+    ASSERT_EQ(1U, representatives.size());
+    ASSERT_DOUBLE_EQ(3.0, representatives[0][0]);
+}
+
+TEST(utest_bsas_stream, push_and_batch_are_equal) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    bsas_stream stream_points(4, 1.0), stream_batch(4, 1.0);
+
+    index_sequence expected_labels;
+    for (const auto & p : *data) {
+        expected_labels.push_back(stream_points.push(p));
+    }
+
+    index_sequence actual_labels;
+    stream_batch.push_batch(*data, actual_labels);
+
+    ASSERT_EQ(expected_labels, actual_labels);
+}
+
+TEST(utest_bsas_stream, save_and_load) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    const std::size_t half = data->size() / 2;
+
+    bsas_stream stream(4, 1.0);
+    bsas_stream restored(1, 100.0);
+
+    for (std::size_t i = 0; i < half; i++) {
+        stream.push(data->at(i));
+    }
+
+    bsas_stream_state state;
+    stream.save(state);
+    restored.load(state);
+
+    ASSERT_EQ(stream.cluster_sizes(), restored.cluster_sizes());
+
+    for (std::size_t i = half; i < data->size(); i++) {
+        ASSERT_EQ(stream.push(data->at(i)), restored.push(data->at(i)));
+    }
+
+    representative_sequence expected, actual;
+    stream.get_representatives(expected);
+    restored.get_representatives(actual);
+
+    ASSERT_EQ(expected, actual);
+}
+
+TEST(utest_bsas_stream, load_corrupted_state) {
+    bsas_stream stream(2, 1.0);
+    stream.push({ 1.0, 2.0 });
+
+    bsas_stream_state state;
+    stream.save(state);
+
+    bsas_stream_state truncated(state.begin(), state.end() - 1);
+    ASSERT_THROW(bsas_stream(2, 1.0).load(truncated), std::invalid_argument);
+
+    bsas_stream_state wrong_signature = state;
+    wrong_signature[0] = 'X';
+    ASSERT_THROW(bsas_stream(2, 1.0).load(wrong_signature), std::invalid_argument);
+
+    ASSERT_THROW(bsas_stream(2, 1.0, distance_metric_factory<point>::manhattan()).load(state), std::invalid_argument);
+}
+
+TEST(utest_bsas_stream, load_corrupted_state_size_overflow) {
+    bsas_stream_state state;
+    bsas_stream(2, 1.0).save(state);
+
+    /* dimension and amount of clusters are the last values of the state without clusters, their
+       product with sizes of values is wrapped around to zero that is expected for the empty state */
+    const std::uint64_t dimension = (std::uint64_t(1) << 60) - 1;
+    const std::uint64_t amount_clusters = 2;
+
+    std::memcpy(state.data() + state.size() - 2 * sizeof(std::uint64_t), &dimension, sizeof(std::uint64_t));
+    std::memcpy(state.data() + state.size() - sizeof(std::uint64_t), &amount_clusters, sizeof(std::uint64_t));
+
+    ASSERT_THROW(bsas_stream(2, 1.0).load(state), std::invalid_argument);
+
+    const std::uint64_t huge_clusters = std::numeric_limits<std::uint64_t>::max();
+    std::memcpy(state.data() + state.size() - sizeof(std::uint64_t), &huge_clusters, sizeof(std::uint64_t));
+
+    ASSERT_THROW(bsas_stream(2, 1.0).load(state), std::invalid_argument);
+}
+
+TEST(utest_bsas_stream, incorrect_dimension) {
+    bsas_stream stream(2, 1.0);
+    stream.push({ 1.0, 2.0 });
+
+    ASSERT_THROW(stream.push({ 1.0 }), std::invalid_argument);
+}
@@ -172,3 +172,128 @@ TEST(utest_clique, allocation_fcps_wingnut) {
 TEST(utest_clique, allocation_fcps_target) {
     template_clique_length_process_data(fcps_sample_factory::create_sample(FCPS_SAMPLE::TARGET), 10, 0, { 3, 3, 3, 3, 363, 395 }, 0);
 }
+
+TEST(utest_clique, allocation_sparse_grid) {
+    /* 10^7 blocks - grid is sparse */
+    const std::size_t dimension = 7;
+
+    dataset data;
+    for (std::size_t i = 0; i < 6; i++) {
+        point first(dimension, 0.0), second(dimension, 1.0);
+        first[0] = 0.05 * static_cast<double>(i);
+        second[1] = 1.0 + 0.05 * static_cast<double>(i);
+
+        data.push_back(first);
+        data.push_back(second);
+    }
+
+    clique_data output_result;
+    clique(10, 0).process(data, output_result);
+
+    ASSERT_CLUSTER_NOISE_SIZES(data, output_result.clusters(), { 6, 6 }, output_result.noise(), 0);
+
+    const clique_block_sequence & blocks = output_result.blocks();
+    ASSERT_LE(blocks.size(), data.size());
+    for (auto & block : blocks) {
+        ASSERT_TRUE(block.is_visited());
+        ASSERT_FALSE(block.get_points().empty());
+    }
+}
+
+TEST(utest_clique, incorrect_intervals) {
+    ASSERT_THROW(clique(0, 0), std::invalid_argument);
+}
+
+TEST(utest_clique, too_big_grid) {
+    dataset data = { point(20, 0.0), point(20, 1.0) };
+
+    clique_data output_result;
+    ASSERT_THROW(clique(10, 0).process(data, output_result), std::invalid_argument);
+}
+
+TEST(utest_clique, subspaces_sample_simple_01) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    clique_data output_result;
+    clique(8, 0, clique_mode::SUBSPACES).process(*data, output_result);
+
+    ASSERT_CLUSTER_NOISE_SIZES(*data, output_result.clusters(), { 5, 5 }, output_result.noise(), 0);
+    ASSERT_TRUE(output_result.blocks().empty());
+
+    const std::vector<std::size_t> expected_dimensions = { 0, 1 };
+    ASSERT_EQ(expected_dimensions, output_result.subspace_clusters().back().dimensions);
+}
+
+TEST(utest_clique, subspaces_one_dimensional_data) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_07);
+
+    clique_data output_result;
+    clique(10, 0, clique_mode::SUBSPACES).process(*data, output_result);
+
+    ASSERT_CLUSTER_NOISE_SIZES(*data, output_result.clusters(), { 10, 10 }, output_result.noise(), 0);
+}
+
+TEST(utest_clique, subspaces_cluster_in_projection) {
+    /* clusters are dense only in the subspace of the first two dimensions, the third is uniformly distributed */
+    dataset data;
+    for (std::size_t i = 0; i < 20; i++) {
+        const double shift_x = 0.01 * static_cast<double>(i % 3);
+        const double shift_y = 0.01 * static_cast<double>(i % 2);
+        const double z = static_cast<double>(i) / 19.0;
+
+        data.push_back({ shift_x, shift_y, z });
+        data.push_back({ 1.0 - shift_x, 1.0 - shift_y, z });
+    }
+
+    clique_data output_result;
+    clique(5, 5, clique_mode::SUBSPACES).process(data, output_result);
+
+    ASSERT_CLUSTER_NOISE_SIZES(data, output_result.clusters(), { 20, 20 }, output_result.noise(), 0);
+
+    std::size_t amount_full_space_clusters = 0;
+    for (const auto & subspace_cluster : output_result.subspace_clusters()) {
+        ASSERT_FALSE(subspace_cluster.points.empty());
+        if (subspace_cluster.dimensions.size() == 2) {
+            const std::vector<std::size_t> expected_dimensions = { 0, 1 };
+            ASSERT_EQ(expected_dimensions, subspace_cluster.dimensions);
+        }
+
+        if (subspace_cluster.dimensions.size() == 3) {
+            amount_full_space_clusters++;
+        }
+    }
+
+    ASSERT_EQ(0U, amount_full_space_clusters);
+
+    clique_data full_space_result;
+    clique(5, 5).process(data, full_space_result);
+    ASSERT_TRUE(full_space_result.clusters().empty());
+}
+
+TEST(utest_clique, subspaces_overlapping_clusters) {
+    /* the first cluster is dense in dimensions (0, 1), the second one is dense in dimensions (0, 2) - both subspaces
+       have the same dimensionality, spread coordinates of both clusters form one more cluster in dimensions (1, 2) */
+    dataset data;
+    for (std::size_t i = 0; i < 20; i++) {
+        const double shift = 0.01 * static_cast<double>(i % 3);
+        const double spread = static_cast<double>(i) / 19.0;
+
+        data.push_back({ shift, shift, spread });
+        data.push_back({ 1.0 - shift, spread, 1.0 - shift });
+    }
+
+    clique_data output_result;
+    clique(5, 5, clique_mode::SUBSPACES).process(data, output_result);
+
+    std::size_t amount_overlapping_clusters = 0;
+    for (const auto & subspace_cluster : output_result.subspace_clusters()) {
+        if (subspace_cluster.dimensions.size() == 2) {
+            amount_overlapping_clusters++;
+        }
+    }
+
+    ASSERT_EQ(3U, amount_overlapping_clusters);
+
+    /* clusters are disjoint and noise is their complement */
+    ASSERT_CLUSTER_NOISE_SIZES(data, output_result.clusters(), { 20, 20 }, output_result.noise(), 0);
+}
@@ -7,10 +7,16 @@
 */
 
 
+#include <pyclustering/differential/differ_batch_state.hpp>
+#include <pyclustering/differential/differ_fixed_state.hpp>
 #include <pyclustering/differential/differ_state.hpp>
+#include <pyclustering/differential/runge_kutta_4.hpp>
+#include <pyclustering/differential/runge_kutta_fehlberg_45.hpp>
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 
 using namespace pyclustering::differential;
 
@@ -132,3 +138,154 @@ TEST(utest_differential, assign_operations) {
     state1 = state2;
     ASSERT_TRUE(state1 == state2);
 }
+
+TEST(utest_differential, fixed_state_operations) {
+    differ_fixed_state<double, 3> state1 { -2, 0, 2 };
+    differ_fixed_state<double, 3> state2 { 1, 1, 1 };
+
+    ASSERT_EQ(3U, state1.size());
+    ASSERT_TRUE(state1 != state2);
+
+    differ_fixed_state<double, 3> expected_result1 { -1, 1, 3 };
+    ASSERT_TRUE(expected_result1 == state1 + state2);
+
+    differ_fixed_state<double, 3> expected_result2 { -3, -1, 1 };
+    ASSERT_TRUE(expected_result2 == state1 - state2);
+
+    differ_fixed_state<double, 3> expected_result3 { -4, 0, 4 };
+    ASSERT_TRUE(expected_result3 == state1 * 2);
+    ASSERT_TRUE(expected_result3 == 2 * state1);
+
+    differ_fixed_state<double, 3> expected_result4 { -1, 0, 1 };
+    ASSERT_TRUE(expected_result4 == state1 / 2);
+
+    state1 += state2;
+    state1 *= 2;
+    differ_fixed_state<double, 3> expected_result5 { -2, 2, 6 };
+    ASSERT_TRUE(expected_result5 == state1);
+
+    differ_fixed_state<double, 3> empty_state;
+    differ_fixed_state<double, 3> zero_state(0.0);
+    ASSERT_TRUE(zero_state == empty_state);
+
+    using wrong_state = differ_fixed_state<double, 2>;
+    ASSERT_THROW(wrong_state({ 1, 2, 3 }), std::runtime_error);
+}
+
+
+static void template_fixed_solver(const solve_type p_solver) {
+    /* damped oscillator with external force */
+    const double damping = 0.3;
+
+    equation<double> generic_equation = [damping](const double t, const differ_state<double> & inputs, const differ_extra<void *> &, differ_state<double> & outputs) {
+        outputs = { inputs[1], -inputs[0] - damping * inputs[1] + std::sin(t) };
+    };
+
+    auto fixed_equation = [damping](const double t, const differ_fixed_state<double, 2> & inputs, differ_fixed_state<double, 2> & outputs) {
+        outputs = { inputs[1], -inputs[0] - damping * inputs[1] + std::sin(t) };
+    };
+
+    differ_state<double> generic_state { 1.0, 0.0 };
+    differ_fixed_state<double, 2> fixed_state { 1.0, 0.0 };
+
+    for (double t = 0.0; t < 5.0; t += 0.5) {
+        differ_result<double> outputs;
+
+        if (p_solver == solve_type::RUNGE_KUTTA_4) {
+            runge_kutta_4(generic_equation, generic_state, t, t + 0.5, 10, false, differ_extra<void *>(), outputs);
+            runge_kutta_4(fixed_equation, fixed_state, t, t + 0.5, 10);
+        }
+        else {
+            runge_kutta_fehlberg_45(generic_equation, generic_state, t, t + 0.5, 0.00001, false, differ_extra<void *>(), outputs);
+            runge_kutta_fehlberg_45(fixed_equation, fixed_state, t, t + 0.5, 0.00001);
+        }
+
+        generic_state = outputs[0].state;
+
+        ASSERT_EQ(generic_state[0], fixed_state[0]);
+        ASSERT_EQ(generic_state[1], fixed_state[1]);
+    }
+}
+
+TEST(utest_differential, fixed_state_runge_kutta_4) {
+    template_fixed_solver(solve_type::RUNGE_KUTTA_4);
+}
+
+TEST(utest_differential, fixed_state_runge_kutta_fehlberg_45) {
+    template_fixed_solver(solve_type::RUNGE_KUTTA_FEHLBERG_45);
+}
+
+
+static void template_batch_solver(const solve_type p_solver, const std::size_t p_size) {
+    /* damped oscillators with various stiffness, so adaptive steps of systems are different */
+    std::vector<double> stiffness(p_size);
+    for (std::size_t i = 0; i < p_size; i++) {
+        stiffness[i] = 1.0 + static_cast<double>(i % 17) * 10.0;
+    }
+
+    auto batch_equation = [&stiffness](const std::vector<double> & times, const differ_batch_state<double> & inputs, const std::size_t begin, const std::size_t end, differ_batch_state<double> & outputs) {
+        for (std::size_t i = begin; i < end; i++) {
+            outputs(0, i) = inputs(1, i);
+            outputs(1, i) = -stiffness[i] * inputs(0, i) - 0.3 * inputs(1, i) + std::sin(times[i]);
+        }
+    };
+
+    differ_batch_state<double> batch_state(2, p_size);
+    std::vector<differ_fixed_state<double, 2>> fixed_states(p_size);
+    for (std::size_t i = 0; i < p_size; i++) {
+        batch_state(0, i) = 1.0 - static_cast<double>(i) / static_cast<double>(p_size);
+        batch_state(1, i) = 0.0;
+
+        fixed_states[i] = { batch_state(0, i), batch_state(1, i) };
+    }
+
+    for (double t = 0.0; t < 2.0; t += 0.5) {
+        if (p_solver == solve_type::RUNGE_KUTTA_4) {
+            runge_kutta_4(batch_equation, batch_state, t, t + 0.5, 10);
+        }
+        else {
+            runge_kutta_fehlberg_45(batch_equation, batch_state, t, t + 0.5, 0.00001);
+        }
+
+        for (std::size_t i = 0; i < p_size; i++) {
+            auto fixed_equation = [&stiffness, i](const double time, const differ_fixed_state<double, 2> & inputs, differ_fixed_state<double, 2> & outputs) {
+                outputs = { inputs[1], -stiffness[i] * inputs[0] - 0.3 * inputs[1] + std::sin(time) };
+            };
+
+            if (p_solver == solve_type::RUNGE_KUTTA_4) {
+                runge_kutta_4(fixed_equation, fixed_states[i], t, t + 0.5, 10);
+            }
+            else {
+                runge_kutta_fehlberg_45(fixed_equation, fixed_states[i], t, t + 0.5, 0.00001);
+            }
+
+            ASSERT_EQ(fixed_states[i][0], batch_state(0, i));
+            ASSERT_EQ(fixed_states[i][1], batch_state(1, i));
+        }
+    }
+}
+
+TEST(utest_differential, batch_state_runge_kutta_4_one_system) {
+    template_batch_solver(solve_type::RUNGE_KUTTA_4, 1);
+}
+
+TEST(utest_differential, batch_state_runge_kutta_4) {
+    template_batch_solver(solve_type::RUNGE_KUTTA_4, 150);
+}
+
+TEST(utest_differential, batch_state_runge_kutta_fehlberg_45_one_system) {
+    template_batch_solver(solve_type::RUNGE_KUTTA_FEHLBERG_45, 1);
+}
+
+TEST(utest_differential, batch_state_runge_kutta_fehlberg_45) {
+    template_batch_solver(solve_type::RUNGE_KUTTA_FEHLBERG_45, 150);
+}
+
+TEST(utest_differential, batch_state_empty) {
+    differ_batch_state<double> state(3, 0);
+    runge_kutta_4([](const std::vector<double> &, const differ_batch_state<double> &, const std::size_t, const std::size_t, differ_batch_state<double> &) { }, state, 0.0, 1.0, 10);
+    runge_kutta_fehlberg_45([](const std::vector<double> &, const differ_batch_state<double> &, const std::size_t, const std::size_t, differ_batch_state<double> &) { }, state, 0.0, 1.0, 0.00001);
+
+    ASSERT_EQ(0U, state.size());
+    ASSERT_EQ(3U, state.variables());
+}
@@ -0,0 +1,242 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/container/dynamic_sink.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+
+using namespace pyclustering::container;
+
+
+static float expected_value(const std::size_t p_step, const std::size_t p_neuron) {
+    return static_cast<float>(std::sin(0.01 * static_cast<double>(p_step)) + static_cast<double>(p_neuron));
+}
+
+
+static void write_dynamic(const std::string & p_filename, const dynamic_compression p_compression, const std::size_t p_steps, const std::size_t p_chunk_steps) {
+    dynamic_file_sink sink(p_filename, p_compression, p_chunk_steps);
+    sink.open({ { "output", 5 }, { "inhibitor", 1 } });
+
+    for (std::size_t step = 0; step < p_steps; step++) {
+        float * row = sink.append(static_cast<double>(step) * 0.5);
+        for (std::size_t neuron = 0; neuron < 6; neuron++) {
+            row[neuron] = expected_value(step, neuron);
+        }
+    }
+
+    sink.close();
+}
+
+
+static void template_round_trip(const dynamic_compression p_compression, const std::size_t p_steps, const std::size_t p_chunk_steps) {
+    const std::string filename = "utest_dynamic_sink.bin";
+    write_dynamic(filename, p_compression, p_steps, p_chunk_steps);
+
+    {
+        dynamic_file_reader reader(filename);
+
+        ASSERT_EQ(2U, reader.layout().size());
+        ASSERT_EQ("output", reader.layout()[0].m_name);
+        ASSERT_EQ(5U, reader.layout()[0].m_size);
+        ASSERT_EQ("inhibitor", reader.layout()[1].m_name);
+        ASSERT_EQ(1U, reader.layout()[1].m_size);
+        ASSERT_EQ(p_steps, reader.size());
+
+        std::vector<double> time;
+        reader.read_time(time);
+        ASSERT_EQ(p_steps, time.size());
+        for (std::size_t step = 0; step < p_steps; step++) {
+            ASSERT_EQ(static_cast<double>(step) * 0.5, time[step]);
+        }
+
+        std::vector<std::vector<double>> values;
+        reader.read("output", 0.0, static_cast<double>(p_steps), 0, 5, time, values);
+        ASSERT_EQ(p_steps, values.size());
+        for (std::size_t step = 0; step < p_steps; step++) {
+            for (std::size_t neuron = 0; neuron < 5; neuron++) {
+                ASSERT_EQ(expected_value(step, neuron), values[step][neuron]);
+            }
+        }
+
+        /* slice by time and neurons: steps [4, 10] and neurons [1, 3) */
+        reader.read("output", 2.0, 5.0, 1, 3, time, values);
+        ASSERT_EQ(7U, time.size());
+        ASSERT_EQ(7U, values.size());
+        for (std::size_t i = 0; i < values.size(); i++) {
+            ASSERT_EQ(static_cast<double>(i + 4) * 0.5, time[i]);
+            ASSERT_EQ(2U, values[i].size());
+            ASSERT_EQ(expected_value(i + 4, 1), values[i][0]);
+            ASSERT_EQ(expected_value(i + 4, 2), values[i][1]);
+        }
+
+        std::vector<double> neuron_values;
+        reader.read_neuron("inhibitor", 0, time, neuron_values);
+        ASSERT_EQ(p_steps, neuron_values.size());
+        for (std::size_t step = 0; step < p_steps; step++) {
+            ASSERT_EQ(expected_value(step, 5), neuron_values[step]);
+        }
+
+        reader.read("output", -2.0, -1.0, 0, 5, time, values);
+        ASSERT_TRUE(time.empty());
+        ASSERT_TRUE(values.empty());
+
+        ASSERT_THROW(reader.read("unknown", 0.0, 1.0, 0, 1, time, values), std::invalid_argument);
+        ASSERT_THROW(reader.read("output", 0.0, 1.0, 0, 6, time, values), std::invalid_argument);
+        ASSERT_THROW(reader.read_neuron("inhibitor", 1, time, neuron_values), std::invalid_argument);
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_dynamic_sink, round_trip_raw) {
+    template_round_trip(dynamic_compression::NONE, 100, 16);
+}
+
+TEST(utest_dynamic_sink, round_trip_raw_one_chunk) {
+    template_round_trip(dynamic_compression::NONE, 20, 0);
+}
+
+TEST(utest_dynamic_sink, round_trip_delta) {
+    template_round_trip(dynamic_compression::DELTA, 100, 16);
+}
+
+TEST(utest_dynamic_sink, round_trip_delta_step_chunks) {
+    template_round_trip(dynamic_compression::DELTA, 30, 1);
+}
+
+
+TEST(utest_dynamic_sink, delta_compression_ratio) {
+    const std::string filename = "utest_dynamic_sink.bin";
+    const std::size_t steps = 1000;
+
+    for (const auto compression : { dynamic_compression::NONE, dynamic_compression::DELTA }) {
+        dynamic_file_sink sink(filename, compression, 100);
+        sink.open({ { "output", 50 } });
+
+        for (std::size_t step = 0; step < steps; step++) {
+            float * row = sink.append(static_cast<double>(step));
+            for (std::size_t neuron = 0; neuron < 50; neuron++) {
+                row[neuron] = (step / 100 + neuron) % 2 == 0 ? 1.0f : 0.0f;     /* outputs are changed rarely */
+            }
+        }
+
+        sink.close();
+
+        std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+        const auto file_size = static_cast<std::size_t>(stream.tellg());
+        if (compression == dynamic_compression::NONE) {
+            ASSERT_GT(file_size, steps * 50 * sizeof(float));
+        }
+        else {
+            ASSERT_LT(file_size, steps * 50 * sizeof(float) / 10);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_dynamic_sink, open_layout) {
+    const std::string filename = "utest_dynamic_sink.bin";
+
+    {
+        dynamic_file_sink sink(filename);
+        sink.open({ { "phase", 3 } });
+        sink.append(0.0)[0] = 1.0f;
+
+        ASSERT_NO_THROW(sink.open({ { "phase", 3 } }));
+        ASSERT_THROW(sink.open({ { "phase", 4 } }), std::invalid_argument);
+        ASSERT_THROW(sink.open({ { "output", 3 } }), std::invalid_argument);
+
+        sink.close();
+        ASSERT_THROW(sink.append(1.0), std::runtime_error);
+    }
+
+    {
+        dynamic_file_reader reader(filename);
+        ASSERT_EQ(1U, reader.size());
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_dynamic_sink, incomplete_chunk) {
+    const std::string filename = "utest_dynamic_sink.bin";
+    write_dynamic(filename, dynamic_compression::DELTA, 50, 20);
+
+    std::vector<char> content;
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    {
+        std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+        stream.write(content.data(), static_cast<std::streamsize>(content.size() - 3));
+    }
+
+    {
+        dynamic_file_reader reader(filename);
+        ASSERT_EQ(40U, reader.size());
+
+        std::vector<double> time, values;
+        reader.read_neuron("output", 4, time, values);
+        ASSERT_EQ(40U, values.size());
+        for (std::size_t step = 0; step < values.size(); step++) {
+            ASSERT_EQ(expected_value(step, 4), values[step]);
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_dynamic_sink, corrupted_chunk_steps) {
+    const std::string filename = "utest_dynamic_sink.bin";
+
+    for (const auto compression : { dynamic_compression::NONE, dynamic_compression::DELTA }) {
+        write_dynamic(filename, compression, 16, 16);
+
+        {
+            /* amount of steps of the first chunk is replaced by a value whose size in bytes wraps to the real size of channels */
+            const std::size_t header_size = 4 + 2 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t);
+            const std::size_t channels_size = 4 * sizeof(std::uint64_t) + std::string("output").size() + std::string("inhibitor").size();
+            const std::uint64_t corrupted_steps = (std::uint64_t(1) << 62) + 16;
+
+            std::fstream stream(filename, std::ios::binary | std::ios::in | std::ios::out);
+            stream.seekp(static_cast<std::streamoff>(header_size + channels_size));
+            stream.write(reinterpret_cast<const char *>(&corrupted_steps), sizeof(corrupted_steps));
+        }
+
+        ASSERT_THROW(dynamic_file_reader reader(filename), std::invalid_argument);
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_dynamic_sink, wrong_signature) {
+    const std::string filename = "utest_dynamic_sink.bin";
+
+    {
+        std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+        stream << "not a dynamic file";
+    }
+
+    ASSERT_THROW(dynamic_file_reader reader(filename), std::invalid_argument);
+
+    std::remove(filename.c_str());
+}
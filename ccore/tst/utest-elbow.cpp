@@ -93,6 +93,26 @@ TEST(utest_elbow, simple_12) {
   elbow_template(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_12), 3, 1, 10);
 }
 
+TEST(utest_elbow, shared_initialization_simple_01) {
+    elbow_shared_initialization_template(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 1, 10);
+}
+
+TEST(utest_elbow, shared_initialization_simple_01_step_3) {
+    elbow_shared_initialization_template(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 1, 10, 3);
+}
+
+TEST(utest_elbow, shared_initialization_simple_03) {
+    elbow_shared_initialization_template(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 1, 20);
+}
+
+TEST(utest_elbow, shared_initialization_simple_03_random_initializer) {
+    elbow_shared_initialization_template<random_center_initializer>(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 1, 20);
+}
+
+TEST(utest_elbow, shared_initialization_simple_05_step_2) {
+    elbow_shared_initialization_template(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_05), 2, 20, 2);
+}
+
 TEST(utest_elbow, exception_kmin_zero) {
     EXPECT_THROW({ 
         elbow<kmeans_plus_plus>(0, 10); 
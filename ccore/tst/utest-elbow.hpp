@@ -43,3 +43,23 @@ void elbow_template(const dataset_ptr p_data,
         ASSERT_EQ(result.get_amount(), p_amount_clusters);
     }
 }
+
+
+template <class type_initializer = kmeans_plus_plus>
+void elbow_shared_initialization_template(const dataset_ptr p_data,
+                                          const std::size_t p_kmin,
+                                          const std::size_t p_kmax,
+                                          const std::size_t p_step = 1)
+{
+    elbow_data expected_result;
+    elbow<type_initializer>(p_kmin, p_kmax, p_step, 1000).process(*p_data, expected_result);
+
+    elbow<type_initializer> instance(p_kmin, p_kmax, p_step, 1000);
+    instance.set_shared_initialization(true);
+
+    elbow_data result;
+    instance.process(*p_data, result);
+
+    ASSERT_EQ(expected_result.get_amount(), result.get_amount());
+    ASSERT_EQ(expected_result.get_wce(), result.get_wce());
+}
@@ -14,6 +14,8 @@
 
 #include <pyclustering/cluster/fcm.hpp>
 
+#include <pyclustering/utils/metric.hpp>
+
 #include "utenv_check.hpp"
 
 #include <cmath>
@@ -22,6 +24,7 @@
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
+using namespace pyclustering::utils::metric;
 
 
 static void template_fcm_data_processing(
@@ -241,6 +244,59 @@ TEST(utest_fcm, itermax_10_simple02) {
 }
 
 
+static void template_fcm_membership_one_step(const dataset_ptr & p_data, const dataset & p_start_centers, const double p_m) {
+    fcm_data output_result;
+    fcm(p_start_centers, p_m, fcm::DEFAULT_TOLERANCE, 1).process(*p_data, output_result);
+
+    const double degree = 2.0 / (p_m - 1.0);
+    for (std::size_t i = 0; i < p_data->size(); i++) {
+        for (std::size_t j = 0; j < p_start_centers.size(); j++) {
+            const double distance_j = euclidean_distance_square(p_data->at(i), p_start_centers[j]);
+
+            double divider = 0.0;
+            for (std::size_t k = 0; k < p_start_centers.size(); k++) {
+                const double distance_k = euclidean_distance_square(p_data->at(i), p_start_centers[k]);
+                if (distance_k != 0.0) {
+                    divider += std::pow(distance_j / distance_k, degree);
+                }
+            }
+
+            const double expected = (divider == 0.0) ? 1.0 : 1.0 / divider;
+            ASSERT_NEAR(expected, output_result.membership()[i][j], 1e-12);
+        }
+    }
+}
+
+TEST(utest_fcm, membership_one_step_hyper_2) {
+    dataset start_centers = { { 3.5, 4.8 },{ 6.9, 7.0 },{ 7.5, 0.5 } };
+    template_fcm_membership_one_step(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), start_centers, 2.0);
+}
+
+TEST(utest_fcm, membership_one_step_hyper_3) {
+    dataset start_centers = { { 3.5, 4.8 },{ 6.9, 7.0 },{ 7.5, 0.5 } };
+    template_fcm_membership_one_step(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), start_centers, 3.0);
+}
+
+TEST(utest_fcm, membership_one_step_centers_are_points) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    dataset start_centers = { data->at(0), data->at(7) };
+    template_fcm_membership_one_step(data, start_centers, 2.0);
+}
+
+TEST(utest_fcm, tiny_scale_data) {
+    auto data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    for (auto & p : *data) {
+        for (auto & coordinate : p) {
+            coordinate *= 1e-100;
+        }
+    }
+
+    dataset start_centers = { { 3.7e-100, 5.5e-100 },{ 6.7e-100, 7.5e-100 } };
+    std::vector<size_t> expected_clusters_length = { 5, 5 };
+    template_fcm_data_processing(data, start_centers, 2, expected_clusters_length);
+}
+
+
 #ifdef UT_PERFORMANCE_SESSION
 #include <chrono>
 
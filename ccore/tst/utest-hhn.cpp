@@ -7,7 +7,11 @@
 */
 
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
+#include <limits>
 
 #include <gtest/gtest.h>
 
@@ -230,6 +234,219 @@ TEST(utest_hhn, two_sync_ensembles_02) {
 #endif
 
 
+TEST(utest_hhn, gating_table_accuracy) {
+    const hhn_gating_table & table = hhn_gating_table::get();
+
+    for (double potential = -90.0; potential < 190.0; potential += 0.037) {
+        double expected[hhn_gating_table::RATE_AMOUNT];
+        double actual[hhn_gating_table::RATE_AMOUNT];
+
+        hhn_gating_table::calculate_rates(potential, expected);
+        table.interpolate(potential, actual);
+
+        for (std::size_t i = 0; i < hhn_gating_table::RATE_AMOUNT; i++) {
+            ASSERT_NEAR(expected[i], actual[i], 1e-4 * std::max(1.0, std::abs(expected[i])));
+        }
+    }
+}
+
+TEST(utest_hhn, gating_table_singularities) {
+    const hhn_gating_table & table = hhn_gating_table::get();
+
+    /* 'am' and 'an' have removable singularities at 25 mV and 10 mV */
+    for (const double potential : { 10.0, 25.0 }) {
+        double rates[hhn_gating_table::RATE_AMOUNT];
+
+        table.interpolate(potential, rates);
+        for (const double rate : rates) {
+            ASSERT_TRUE(std::isfinite(rate));
+        }
+
+        hhn_gating_table::calculate_rates(potential, rates);
+        for (const double rate : rates) {
+            ASSERT_TRUE(std::isfinite(rate));
+        }
+    }
+
+    double rates[hhn_gating_table::RATE_AMOUNT];
+
+    table.interpolate(25.0, rates);
+    ASSERT_NEAR(1.0, rates[hhn_gating_table::RATE_AM], 1e-6);
+
+    table.interpolate(10.0, rates);
+    ASSERT_NEAR(0.1, rates[hhn_gating_table::RATE_AN], 1e-6);
+
+    ASSERT_TRUE(table.contains(0.0));
+    ASSERT_FALSE(table.contains(hhn_gating_table::MINIMUM_POTENTIAL - 1.0));
+    ASSERT_FALSE(table.contains(hhn_gating_table::MAXIMUM_POTENTIAL + 1.0));
+}
+
+TEST(utest_hhn, gating_table_out_of_range) {
+    const hhn_gating_table & table = hhn_gating_table::get();
+
+    double lowest[hhn_gating_table::RATE_AMOUNT];
+    double highest[hhn_gating_table::RATE_AMOUNT];
+
+    table.interpolate(hhn_gating_table::MINIMUM_POTENTIAL, lowest);
+    table.interpolate(hhn_gating_table::MAXIMUM_POTENTIAL, highest);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    for (const double potential : { nan, -inf, hhn_gating_table::MINIMUM_POTENTIAL - 1.0 }) {
+        double rates[hhn_gating_table::RATE_AMOUNT];
+        table.interpolate(potential, rates);
+
+        for (std::size_t i = 0; i < hhn_gating_table::RATE_AMOUNT; i++) {
+            ASSERT_EQ(lowest[i], rates[i]);
+        }
+    }
+
+    for (const double potential : { inf, hhn_gating_table::MAXIMUM_POTENTIAL + 1.0 }) {
+        double rates[hhn_gating_table::RATE_AMOUNT];
+        table.interpolate(potential, rates);
+
+        for (std::size_t i = 0; i < hhn_gating_table::RATE_AMOUNT; i++) {
+            ASSERT_NEAR(highest[i], rates[i], 1e-12 * std::max(1.0, std::abs(highest[i])));
+        }
+    }
+
+    ASSERT_FALSE(table.contains(nan));
+}
+
+TEST(utest_hhn, big_network_stability) {
+    const std::size_t size = 1000;
+
+    hhn_stimulus stimulus(size);
+    for (std::size_t i = 0; i < size; i++) {
+        stimulus[i] = static_cast<double>(i % 50);
+    }
+
+    hnn_parameters parameters;
+    hhn_network network(size, parameters);
+
+    hhn_dynamic output_dynamic;
+    output_dynamic.disable_all();
+    output_dynamic.enable(hhn_dynamic::collect::MEMBRANE_POTENTIAL);
+
+    network.simulate(50, 10.0, solve_type::RUNGE_KUTTA_4, stimulus, output_dynamic);
+
+    hhn_dynamic::evolution_dynamic & membrane_dynamic = output_dynamic.get_peripheral_dynamic(hhn_dynamic::collect::MEMBRANE_POTENTIAL);
+    for (auto & neurons : membrane_dynamic) {
+        ASSERT_EQ(size, neurons.size());
+        for (const double potential : neurons) {
+            ASSERT_TRUE(std::isfinite(potential));
+        }
+    }
+}
+
+
+TEST(utest_hhn, dynamic_sink_last_policy) {
+    const std::string filename = "utest_hhn_dynamic_last.bin";
+
+    hnn_parameters parameters;
+    hhn_network network(3, parameters);
+
+    hhn_dynamic output_dynamic;
+    output_dynamic.set_sink(std::make_shared<container::dynamic_file_sink>(filename));
+
+    ASSERT_THROW(network.simulate(50, 10.0, solve_type::RUNGE_KUTTA_4, { 10, 10, 25 }, collection_policy::last(), output_dynamic), std::invalid_argument);
+
+    output_dynamic.get_sink()->close();
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_hhn, dynamic_sink) {
+    const std::string filename = "utest_hhn_dynamic.bin";
+
+    hnn_parameters parameters;
+    hhn_network network(3, parameters);
+
+    hhn_dynamic output_dynamic;
+    output_dynamic.disable_all();
+    output_dynamic.enable(hhn_dynamic::collect::MEMBRANE_POTENTIAL);
+    output_dynamic.enable(hhn_dynamic::collect::ACTIVE_COND_SODIUM);
+    output_dynamic.set_sink(std::make_shared<container::dynamic_file_sink>(filename, container::dynamic_compression::DELTA, 16));
+
+    network.simulate(50, 10.0, solve_type::RUNGE_KUTTA_4, { 10, 10, 25 }, output_dynamic);
+    output_dynamic.get_sink()->close();
+
+    ASSERT_EQ(51U, output_dynamic.size_dynamic());
+    ASSERT_TRUE(output_dynamic.get_time()->empty());
+    ASSERT_TRUE(output_dynamic.get_peripheral_dynamic(hhn_dynamic::collect::MEMBRANE_POTENTIAL).empty());
+
+    {
+        container::dynamic_file_reader reader(filename);
+        ASSERT_EQ(51U, reader.size());
+
+        const container::dynamic_layout expected_layout = {
+            { "peripheral.membrane_potential", 3 }, { "central.membrane_potential", 2 },
+            { "peripheral.active_cond_sodium", 3 }, { "central.active_cond_sodium", 2 } };
+        ASSERT_EQ(expected_layout, reader.layout());
+
+        std::vector<double> time;
+        std::vector<std::vector<double>> potentials;
+        reader.read("peripheral.membrane_potential", 0.0, 100.0, 0, 3, time, potentials);
+        ASSERT_EQ(51U, potentials.size());
+
+        for (const auto & neurons : potentials) {
+            for (const auto potential : neurons) {
+                ASSERT_TRUE(std::isfinite(potential));
+            }
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_hhn, collection_policy_window) {
+    hnn_parameters parameters;
+    hhn_network network(3, parameters);
+
+    hhn_dynamic output_dynamic;
+    output_dynamic.disable_all();
+    output_dynamic.enable(hhn_dynamic::collect::MEMBRANE_POTENTIAL);
+
+    network.simulate(10, 2.0, solve_type::RUNGE_KUTTA_4, { 10, 10, 25 }, output_dynamic);
+    const hhn_dynamic::value_dynamic first_time = *output_dynamic.get_time();
+
+    auto spikes = std::make_shared<spike_count_reduction>(0.0);
+    network.simulate(50, 10.0, solve_type::RUNGE_KUTTA_4, { 10, 10, 25 }, collection_policy::window(5).add_reduction(spikes), output_dynamic);
+
+    ASSERT_EQ(first_time.size() + 5, output_dynamic.size_dynamic());
+    ASSERT_EQ(first_time.size() + 5, output_dynamic.get_peripheral_dynamic(hhn_dynamic::collect::MEMBRANE_POTENTIAL).size());
+    ASSERT_EQ(first_time.size() + 5, output_dynamic.get_central_dynamic(hhn_dynamic::collect::MEMBRANE_POTENTIAL).size());
+
+    const auto & time = *output_dynamic.get_time();
+    for (std::size_t index = 0; index < first_time.size(); index++) {
+        ASSERT_EQ(first_time[index], time[index]);
+    }
+
+    for (std::size_t index = 0; index < 5; index++) {
+        ASSERT_DOUBLE_EQ(0.2 * static_cast<double>(47 + index), time[first_time.size() + index]);
+    }
+
+    ASSERT_EQ(3U, spikes->get_counts().size());
+}
+
+
+TEST(utest_hhn, collection_policy_every) {
+    hnn_parameters parameters;
+    hhn_network network(3, parameters);
+
+    hhn_dynamic output_dynamic;
+    network.simulate(50, 10.0, solve_type::RUNGE_KUTTA_4, { 10, 10, 25 }, collection_policy::every(10), output_dynamic);
+
+    ASSERT_EQ(6U, output_dynamic.size_dynamic());
+    ASSERT_EQ(6U, output_dynamic.get_peripheral_dynamic(hhn_dynamic::collect::MEMBRANE_POTENTIAL).size());
+    for (std::size_t index = 1; index < output_dynamic.size_dynamic(); index++) {
+        ASSERT_DOUBLE_EQ(0.2 * static_cast<double>(index * 10 + 1), (*output_dynamic.get_time())[index]);
+    }
+}
+
+
 static void template_write_read_dynamic(const std::size_t p_num_osc,
                                         const std::size_t p_steps,
                                         const std::size_t p_time,
@@ -9,6 +9,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
+#include "samples.hpp"
+
 #include <pyclustering/cluster/hsyncnet.hpp>
 
 
@@ -57,4 +61,34 @@ TEST(utest_hsyncnet, allocation_1_clusters) {
     template_cluster_allocation(1);
 }
 
+
+static void template_sample_allocation(const std::shared_ptr<dataset> & p_sample, const std::vector<std::size_t> & p_expected_lengths) {
+    /* initial phases are not random, so the result is the same on each run */
+    hsyncnet network(p_sample.get(), p_expected_lengths.size(), initial_type::EQUIPARTITION);
+
+    hsyncnet_analyser analyser;
+    network.process(0.998, solve_type::FORWARD_EULER, false, analyser);
+
+    /* the same tolerance as it is used to stop the process */
+    hsyncnet_cluster_data ensembles;
+    analyser.allocate_clusters(0.05, ensembles);
+
+    std::vector<std::size_t> lengths;
+    for (const auto & cluster : ensembles) {
+        lengths.push_back(cluster.size());
+    }
+
+    std::sort(lengths.begin(), lengths.end());
+
+    ASSERT_EQ(p_expected_lengths, lengths);
+}
+
+TEST(utest_hsyncnet, allocation_sample_simple_01) {
+    template_sample_allocation(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), { 5, 5 });
+}
+
+TEST(utest_hsyncnet, allocation_sample_simple_02) {
+    template_sample_allocation(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), { 5, 8, 10 });
+}
+
 #endif
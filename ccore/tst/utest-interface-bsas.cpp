@@ -31,4 +31,38 @@ TEST(utest_interface_bsas, bsas_api) {
     ASSERT_NE(nullptr, bsas_result);
 
     delete bsas_result;
-}
\ No newline at end of file
+}
+
+
+TEST(utest_interface_bsas, bsas_stream_api) {
+    std::shared_ptr<pyclustering_package> sample = pack(dataset({ { 1 }, { 2 }, { 3 }, { 10 }, { 11 }, { 12 } }));
+
+    distance_metric<point> metric = distance_metric_factory<point>::euclidean();
+
+    void * stream = bsas_stream_create(2, 1.0, &metric);
+    ASSERT_NE(nullptr, stream);
+
+    std::shared_ptr<pyclustering_package> labels(bsas_stream_push(stream, sample.get()));
+    ASSERT_EQ(6U, labels->size);
+
+    std::shared_ptr<pyclustering_package> wrong_sample = pack(dataset({ { 1, 2 } }));
+    ASSERT_EQ(nullptr, bsas_stream_push(stream, wrong_sample.get()));
+
+    std::shared_ptr<pyclustering_package> representatives(bsas_stream_get_representatives(stream));
+    ASSERT_EQ(2U, representatives->size);
+
+    std::shared_ptr<pyclustering_package> sizes(bsas_stream_get_sizes(stream));
+    ASSERT_EQ(2U, sizes->size);
+
+    std::shared_ptr<pyclustering_package> state(bsas_stream_save(stream));
+    ASSERT_NE(nullptr, state);
+
+    void * restored = bsas_stream_create(2, 1.0, &metric);
+    ASSERT_TRUE(bsas_stream_load(restored, state.get()));
+
+    std::shared_ptr<pyclustering_package> wrong_state = pack(dataset({ { 1 } }));
+    ASSERT_FALSE(bsas_stream_load(restored, wrong_state.get()));
+
+    bsas_stream_destroy(restored);
+    bsas_stream_destroy(stream);
+}
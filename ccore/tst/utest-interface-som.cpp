@@ -14,6 +14,7 @@
 
 #include "utenv_utils.hpp"
 
+#include <cstdio>
 #include <memory>
 
 
@@ -42,6 +43,9 @@ TEST(utest_interface_som, som_api) {
     pyclustering_package * package_dataset = create_package(&input_data);
     size_t iterations = som_train(network, package_dataset, 100, true);
     ASSERT_LT(0U, iterations);
+
+    iterations = som_train_with_mode(network, package_dataset, 100, true, static_cast<size_t>(som_train_mode::SOM_BATCH));
+    ASSERT_LT(0U, iterations);
     free_pyclustering_package(package_dataset);
 
     pattern input_pattern = {2.3};
@@ -51,6 +55,19 @@ TEST(utest_interface_som, som_api) {
     ASSERT_GT(3U, index_winner);
     free_pyclustering_package(package_pattern);
 
+    pyclustering_package * package_patterns = create_package(&input_data);
+    pyclustering_package * package_winners = som_simulate_batch(network, package_patterns);
+    ASSERT_NE(nullptr, package_winners);
+    ASSERT_EQ(input_data.size(), package_winners->size);
+    for (std::size_t i = 0; i < input_data.size(); i++) {
+        pyclustering_package * package_single = create_package(&input_data[i]);
+        ASSERT_EQ(som_simulate(network, package_single), ((std::size_t *) package_winners->data)[i]);
+        free_pyclustering_package(package_single);
+    }
+
+    free_pyclustering_package(package_patterns);
+    free_pyclustering_package(package_winners);
+
     size_t amount_winners = som_get_winner_number(network);
     ASSERT_LE(0U, amount_winners);
 
@@ -80,6 +97,18 @@ TEST(utest_interface_som, som_api) {
     CHECK_FREE_PACKAGE(awards, 3);
     CHECK_FREE_PACKAGE(objects, 3);
 
+    /* store network to binary file and load it again */
+    ASSERT_TRUE(som_save(network, "utest_interface_som.bin"));
+
+    void * loaded_network = som_load_file("utest_interface_som.bin");
+    ASSERT_NE(nullptr, loaded_network);
+    ASSERT_EQ(3U, som_get_size(loaded_network));
+    ASSERT_EQ(((som *) network)->get_weights(), ((som *) loaded_network)->get_weights());
+    som_destroy(loaded_network);
+
+    std::remove("utest_interface_som.bin");
+    ASSERT_EQ(nullptr, som_load_file("utest_interface_som.bin"));
+
     /* destroy network */
     som_destroy(network);
 }
\ No newline at end of file
@@ -17,6 +17,8 @@
 
 #include "utenv_check.hpp"
 
+#include <numeric>
+
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
@@ -73,6 +75,10 @@ template_kmeans_length_process_data_common(
         }
     }
 
+    ASSERT_EQ(actual_clusters.size(), output_result.cluster_wce().size());
+    const double total_cluster_wce = std::accumulate(output_result.cluster_wce().begin(), output_result.cluster_wce().end(), 0.0);
+    ASSERT_NEAR(output_result.wce(), total_cluster_wce, 0.000001);
+
     ASSERT_GT(output_result.wce(), 0.0);
 }
 
@@ -176,4 +176,26 @@ TEST(utest_kmedians, itermax_10_simple02) {
     dataset start_medians = { { 3.5, 4.8 }, { 6.9, 7.0 }, { 7.5, 0.5 } };
     std::vector<size_t> expected_clusters_length = { 10, 5, 8 };
     template_kmedians_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), start_medians, expected_clusters_length, 20);
-}
\ No newline at end of file
+}
+
+TEST(utest_kmedians, median_per_dimension_odd) {
+    dataset data = { { 1.0, 9.0 }, { 2.0, 7.0 }, { 3.0, 8.0 } };
+    dataset start_medians = { { 2.0, 8.0 } };
+
+    kmedians_data output_result;
+    kmedians(start_medians, kmedians::DEFAULT_TOLERANCE, 1).process(data, output_result);
+
+    const dataset expected_medians = { { 2.0, 8.0 } };
+    ASSERT_EQ(expected_medians, output_result.medians());
+}
+
+TEST(utest_kmedians, median_per_dimension_even) {
+    dataset data = { { 1.0, 4.0 }, { 2.0, 1.0 }, { 3.0, 3.0 }, { 4.0, 2.0 } };
+    dataset start_medians = { { 2.0, 2.0 } };
+
+    kmedians_data output_result;
+    kmedians(start_medians, kmedians::DEFAULT_TOLERANCE, 1).process(data, output_result);
+
+    const dataset expected_medians = { { 2.5, 2.5 } };
+    ASSERT_EQ(expected_medians, output_result.medians());
+}
@@ -11,6 +11,8 @@
 
 #include <pyclustering/nnet/legion.hpp>
 
+#include <cstdio>
+
 
 using namespace pyclustering::nnet;
 
@@ -75,3 +77,77 @@ TEST(utest_legion, dynamic_simulation_grid_eight_rk4) {
 }
 
 #endif
+
+
+TEST(utest_legion, dynamic_sink) {
+    const std::string filename = "utest_legion_dynamic.bin";
+
+    legion_stimulus stimulus = { 1, 1, 1, 0, 0, 0, 1, 1, 1 };
+    legion_parameters parameters;
+    legion_network network(stimulus.size(), connection_t::CONNECTION_GRID_FOUR, parameters);
+
+    legion_dynamic output_dynamic;
+    output_dynamic.set_sink(std::make_shared<dynamic_file_sink>(filename));
+    network.simulate(100, 10, solve_type::RUNGE_KUTTA_4, true, stimulus, output_dynamic);
+    output_dynamic.get_sink()->close();
+
+    ASSERT_EQ(1U, output_dynamic.size());
+
+    {
+        dynamic_file_reader reader(filename);
+        ASSERT_LT(1U, reader.size());
+
+        std::vector<double> time;
+        reader.read_time(time);
+        ASSERT_EQ(output_dynamic[0].m_time, time.back());
+
+        std::vector<std::vector<double>> outputs;
+        reader.read("output", output_dynamic[0].m_time, output_dynamic[0].m_time, 0, stimulus.size(), time, outputs);
+
+        ASSERT_EQ(1U, outputs.size());
+        for (std::size_t index = 0; index < stimulus.size(); index++) {
+            ASSERT_EQ(static_cast<float>(output_dynamic[0].m_output[index]), outputs[0][index]);
+        }
+
+        std::vector<double> inhibitor;
+        reader.read_neuron("inhibitor", 0, time, inhibitor);
+        ASSERT_EQ(static_cast<float>(output_dynamic[0].m_inhibitor), inhibitor.back());
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_legion, collection_policy_every) {
+    legion_stimulus stimulus = { 1, 1, 1, 0, 0, 0, 1, 1, 1 };
+    legion_parameters parameters;
+    legion_network network(stimulus.size(), connection_t::CONNECTION_GRID_FOUR, parameters);
+
+    auto spikes = std::make_shared<spike_count_reduction>();
+
+    legion_dynamic output_dynamic;
+    network.simulate(100, 10, solve_type::RUNGE_KUTTA_4, collection_policy::every(10).add_reduction(spikes), stimulus, output_dynamic);
+
+    ASSERT_EQ(11U, output_dynamic.size());
+    for (std::size_t index = 1; index < output_dynamic.size(); index++) {
+        ASSERT_LT(output_dynamic[index - 1].m_time, output_dynamic[index].m_time);
+        ASSERT_EQ(stimulus.size(), output_dynamic[index].m_output.size());
+    }
+
+    ASSERT_EQ(stimulus.size(), spikes->get_counts().size());
+}
+
+
+TEST(utest_legion, collection_policy_window) {
+    legion_stimulus stimulus = { 1, 1, 1, 0, 0, 0, 1, 1, 1 };
+    legion_parameters parameters;
+    legion_network network(stimulus.size(), connection_t::CONNECTION_GRID_FOUR, parameters);
+
+    legion_dynamic output_dynamic;
+    network.simulate(100, 10, solve_type::RUNGE_KUTTA_4, collection_policy::window(15), stimulus, output_dynamic);
+
+    ASSERT_EQ(15U, output_dynamic.size());
+    for (std::size_t index = 1; index < output_dynamic.size(); index++) {
+        ASSERT_LT(output_dynamic[index - 1].m_time, output_dynamic[index].m_time);
+    }
+}
@@ -26,10 +26,12 @@ template_mbsas_length_process_data(const dataset_ptr p_data,
         const std::size_t & p_amount,
         const double & p_threshold,
         const std::vector<size_t> & p_expected_cluster_length,
-        const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean()) {
+        const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean(),
+        const bool p_parallel_assignment = false) {
 
     mbsas_data output_result;
     mbsas solver(p_amount, p_threshold, p_metric);
+    solver.set_parallel_assignment(p_parallel_assignment);
     solver.process(*p_data, output_result);
 
     const dataset & data = *p_data;
@@ -140,4 +142,22 @@ TEST(utest_mbsas, allocation_three_dimension_points_2) {
 TEST(utest_mbsas, allocation_three_allocation_one_dimension_points_2) {
     const std::vector<size_t> expected_clusters_length = { 20 };
     template_mbsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_11), 2, 10.0, expected_clusters_length);
-}
\ No newline at end of file
+}
+
+
+TEST(utest_mbsas, parallel_assignment_sample_simple_01) {
+    const std::vector<size_t> expected_clusters_length = { 5, 5 };
+    template_mbsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 2, 1.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
+
+
+TEST(utest_mbsas, parallel_assignment_sample_simple_02) {
+    const std::vector<size_t> expected_clusters_length = { 5, 8, 10 };
+    template_mbsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 3, 1.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
+
+
+TEST(utest_mbsas, parallel_assignment_three_dimension_points_2) {
+    const std::vector<size_t> expected_clusters_length = { 10, 10 };
+    template_mbsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_11), 2, 1.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
@@ -208,6 +208,35 @@ TEST(utest_parallel_for, sum_1000000_elements) {
 }
 
 
+static void template_parallel_for_nested(const std::size_t p_outer, const std::size_t p_inner) {
+    std::vector<std::vector<std::size_t>> values(p_outer, std::vector<std::size_t>(p_inner, 0));
+
+    parallel_for(std::size_t(0), p_outer, [&values, p_inner](const std::size_t p_index_outer) {
+        ASSERT_TRUE(is_parallel_region());
+
+        parallel_for(std::size_t(0), p_inner, [&values, p_index_outer](const std::size_t p_index_inner) {
+            values[p_index_outer][p_index_inner] = p_index_outer * p_index_inner;
+        });
+    });
+
+    ASSERT_FALSE(is_parallel_region());
+
+    for (std::size_t i = 0; i < p_outer; i++) {
+        for (std::size_t j = 0; j < p_inner; j++) {
+            ASSERT_EQ(i * j, values[i][j]);
+        }
+    }
+}
+
+TEST(utest_parallel_for, nested_loops_10x100) {
+    template_parallel_for_nested(10, 100);
+}
+
+TEST(utest_parallel_for, nested_loops_100x10) {
+    template_parallel_for_nested(100, 10);
+}
+
+
 
 static void template_parallel_foreach_square(const std::size_t p_length, const std::size_t p_thread = -1) {
     std::vector<double> values(p_length);
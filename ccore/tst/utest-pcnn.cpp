@@ -10,9 +10,13 @@
 
 #include <gtest/gtest.h>
 
+#include <pyclustering/container/adjacency_list.hpp>
+
 #include <pyclustering/nnet/pcnn.hpp>
 
 #include <algorithm>
+#include <cstdio>
+#include <random>
 #include <unordered_set>
 
 
@@ -305,3 +309,242 @@ TEST(utest_pcnn, ensemble_allocation_fast_linking) {
     template_ensemble_allocation(partial_stimulus.size(), 50, connection_t::CONNECTION_ALL_TO_ALL, partial_stimulus, &params);
     template_ensemble_allocation(no_stimulus.size(), 50, connection_t::CONNECTION_ALL_TO_ALL, no_stimulus, &params);
 }
+
+
+TEST(utest_pcnn, dynamic_sink) {
+    const std::string filename = "utest_pcnn_dynamic.bin";
+    pcnn_stimulus stimulus { 1, 0, 0, 1, 1, 1, 0, 0, 1, 1 };
+
+    pcnn_parameters parameters;
+    pcnn network(stimulus.size(), connection_t::CONNECTION_ALL_TO_ALL, parameters);
+    pcnn_dynamic expected_dynamic;
+    network.simulate(20, stimulus, expected_dynamic);
+
+    pcnn sink_network(stimulus.size(), connection_t::CONNECTION_ALL_TO_ALL, parameters);
+    pcnn_dynamic output_dynamic;
+    output_dynamic.set_sink(std::make_shared<dynamic_file_sink>(filename, dynamic_compression::DELTA));
+    sink_network.simulate(20, stimulus, output_dynamic);
+    output_dynamic.get_sink()->close();
+
+    ASSERT_EQ(1U, output_dynamic.size());
+    ASSERT_EQ(expected_dynamic.back().m_output, output_dynamic.back().m_output);
+
+    {
+        dynamic_file_reader reader(filename);
+        ASSERT_EQ(20U, reader.size());
+
+        for (std::size_t index = 0; index < stimulus.size(); index++) {
+            std::vector<double> time, outputs;
+            reader.read_neuron("output", index, time, outputs);
+
+            for (std::size_t step = 0; step < outputs.size(); step++) {
+                ASSERT_EQ(expected_dynamic[step].m_output[index], outputs[step]);
+            }
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_pcnn, collection_policy_spike_counts) {
+    pcnn_stimulus stimulus { 1, 0, 0, 1, 1, 1, 0, 0, 1, 1 };
+
+    pcnn_parameters parameters;
+    pcnn network(stimulus.size(), connection_t::CONNECTION_ALL_TO_ALL, parameters);
+    pcnn_dynamic expected_dynamic;
+    network.simulate(30, stimulus, expected_dynamic);
+
+    std::vector<std::size_t> expected_counts(stimulus.size(), 0);
+    for (std::size_t step = 0; step < expected_dynamic.size(); step++) {
+        for (std::size_t index = 0; index < stimulus.size(); index++) {
+            const bool previous = (step > 0) && (expected_dynamic[step - 1].m_output[index] > 0.5);
+            if ((expected_dynamic[step].m_output[index] > 0.5) && !previous) {
+                expected_counts[index]++;
+            }
+        }
+    }
+
+    auto spikes = std::make_shared<spike_count_reduction>();
+
+    pcnn policy_network(stimulus.size(), connection_t::CONNECTION_ALL_TO_ALL, parameters);
+    pcnn_dynamic output_dynamic;
+    policy_network.simulate(30, stimulus, collection_policy::every(4).add_reduction(spikes), output_dynamic);
+
+    ASSERT_EQ(8U, output_dynamic.size());
+    for (std::size_t index = 0; index < output_dynamic.size(); index++) {
+        ASSERT_EQ(expected_dynamic[index * 4].m_time, output_dynamic[index].m_time);
+        ASSERT_EQ(expected_dynamic[index * 4].m_output, output_dynamic[index].m_output);
+    }
+
+    ASSERT_EQ(expected_counts, spikes->get_counts());
+}
+
+
+TEST(utest_pcnn, collection_policy_window) {
+    pcnn_stimulus stimulus { 1, 0, 0, 1, 1, 1, 0, 0, 1, 1 };
+
+    pcnn_parameters parameters;
+    pcnn network(stimulus.size(), connection_t::CONNECTION_ALL_TO_ALL, parameters);
+    pcnn_dynamic expected_dynamic;
+    network.simulate(30, stimulus, expected_dynamic);
+
+    pcnn policy_network(stimulus.size(), connection_t::CONNECTION_ALL_TO_ALL, parameters);
+    pcnn_dynamic output_dynamic;
+    policy_network.simulate(30, stimulus, collection_policy::window(12), output_dynamic);
+
+    ASSERT_EQ(12U, output_dynamic.size());
+    for (std::size_t index = 0; index < output_dynamic.size(); index++) {
+        ASSERT_EQ(expected_dynamic[18 + index].m_time, output_dynamic[index].m_time);
+        ASSERT_EQ(expected_dynamic[18 + index].m_output, output_dynamic[index].m_output);
+    }
+}
+
+
+static std::vector<std::vector<double>> reference_grid_simulation(
+    const std::size_t width,
+    const std::size_t height,
+    const connection_t type_conn,
+    const pcnn_parameters & params,
+    const pcnn_stimulus & stimulus,
+    const std::size_t steps)
+{
+    adjacency_list connections(width * height);
+    adjacency_connector<adjacency_collection>().create_grid_structure(type_conn, width, height, connections);
+
+    std::vector<pcnn_oscillator> oscillators(width * height);
+    std::vector<std::vector<double>> dynamic;
+
+    for (std::size_t step = 0; step < steps; step++) {
+        std::vector<double> feeding(oscillators.size()), linking(oscillators.size()), outputs(oscillators.size());
+
+        for (std::size_t index = 0; index < oscillators.size(); index++) {
+            std::vector<std::size_t> neighbors;
+            connections.get_neighbors(index, neighbors);
+
+            double feeding_influence = 0.0, linking_influence = 0.0;
+            for (const auto neighbor : neighbors) {
+                feeding_influence += oscillators[neighbor].output * params.M;
+                linking_influence += oscillators[neighbor].output * params.W;
+            }
+
+            feeding[index] = params.AF * oscillators[index].feeding + stimulus[index] + feeding_influence * params.VF;
+            linking[index] = params.AL * oscillators[index].linking + linking_influence * params.VL;
+            outputs[index] = (feeding[index] * (1.0 + params.B * linking[index]) > oscillators[index].threshold) ? 1.0 : 0.0;
+        }
+
+        for (bool changed = params.FAST_LINKING; changed; ) {
+            const std::vector<double> previous = outputs;
+
+            changed = false;
+            for (std::size_t index = 0; index < oscillators.size(); index++) {
+                std::vector<std::size_t> neighbors;
+                connections.get_neighbors(index, neighbors);
+
+                double linking_influence = 0.0;
+                for (const auto neighbor : neighbors) {
+                    linking_influence += previous[neighbor] * params.W;
+                }
+
+                linking[index] = linking_influence * params.VL;
+                outputs[index] = (feeding[index] * (1.0 + params.B * linking[index]) > oscillators[index].threshold) ? 1.0 : 0.0;
+                changed |= (outputs[index] != previous[index]);
+            }
+        }
+
+        for (std::size_t index = 0; index < oscillators.size(); index++) {
+            oscillators[index].feeding = feeding[index];
+            oscillators[index].linking = linking[index];
+            oscillators[index].output = outputs[index];
+            oscillators[index].threshold = params.AT * oscillators[index].threshold + params.VT * outputs[index];
+        }
+
+        dynamic.push_back(outputs);
+    }
+
+    return dynamic;
+}
+
+
+static void template_grid_kernel(const std::size_t width, const std::size_t height, const connection_t type_conn, const bool fast_linking) {
+    /* image-like stimulus: areas of the same intensity */
+    pcnn_stimulus stimulus(width * height);
+    for (std::size_t row = 0; row < height; row++) {
+        for (std::size_t column = 0; column < width; column++) {
+            stimulus[row * width + column] = static_cast<double>((row / 3 + column / 7) % 4) * 0.25;
+        }
+    }
+
+    pcnn_parameters params;
+    params.FAST_LINKING = fast_linking;
+
+    const std::size_t steps = 15;
+    const auto expected = reference_grid_simulation(width, height, type_conn, params, stimulus, steps);
+
+    pcnn network(stimulus.size(), type_conn, height, width, params);
+    pcnn_dynamic dynamic;
+    network.simulate(steps, stimulus, dynamic);
+
+    ASSERT_EQ(steps, dynamic.size());
+    for (std::size_t step = 0; step < steps; step++) {
+        ASSERT_EQ(expected[step], dynamic[step].m_output);
+    }
+}
+
+
+TEST(utest_pcnn, grid_kernel_four) {
+    template_grid_kernel(70, 9, connection_t::CONNECTION_GRID_FOUR, false);
+}
+
+TEST(utest_pcnn, grid_kernel_eight) {
+    template_grid_kernel(70, 9, connection_t::CONNECTION_GRID_EIGHT, false);
+}
+
+TEST(utest_pcnn, grid_kernel_four_fast_linking) {
+    template_grid_kernel(130, 7, connection_t::CONNECTION_GRID_FOUR, true);
+}
+
+TEST(utest_pcnn, grid_kernel_eight_fast_linking) {
+    template_grid_kernel(130, 7, connection_t::CONNECTION_GRID_EIGHT, true);
+}
+
+TEST(utest_pcnn, grid_kernel_band_boundaries) {
+    template_grid_kernel(64, 260, connection_t::CONNECTION_GRID_FOUR, true);
+}
+
+TEST(utest_pcnn, grid_kernel_copy) {
+    pcnn_stimulus stimulus(64 * 8);
+    for (std::size_t index = 0; index < stimulus.size(); index++) {
+        stimulus[index] = static_cast<double>((index / 3) % 4) * 0.25;
+    }
+
+    pcnn_parameters params;
+    pcnn network(stimulus.size(), connection_t::CONNECTION_GRID_FOUR, 8, 64, params);
+
+    pcnn_dynamic dynamic;
+    network.simulate(5, stimulus, dynamic);
+
+    /* copies continue simulation from the same state independently */
+    pcnn copy_network(network);
+    pcnn assigned_network;
+    assigned_network = network;
+
+    pcnn_dynamic expected_dynamic, copy_dynamic, assigned_dynamic;
+    network.simulate(10, stimulus, expected_dynamic);
+    copy_network.simulate(10, stimulus, copy_dynamic);
+    assigned_network.simulate(10, stimulus, assigned_dynamic);
+
+    ASSERT_EQ(network.size(), copy_network.size());
+    ASSERT_EQ(network.size(), assigned_network.size());
+
+    for (std::size_t step = 0; step < expected_dynamic.size(); step++) {
+        ASSERT_EQ(expected_dynamic[step].m_output, copy_dynamic[step].m_output);
+        ASSERT_EQ(expected_dynamic[step].m_output, assigned_dynamic[step].m_output);
+    }
+}
+
+TEST(utest_pcnn, grid_kernel_invalid_size) {
+    pcnn_parameters params;
+    ASSERT_THROW(pcnn(99, connection_t::CONNECTION_GRID_FOUR, 10, 10, params), std::runtime_error);
+    ASSERT_THROW(pcnn(99, connection_t::CONNECTION_GRID_EIGHT, params), std::runtime_error);
+}
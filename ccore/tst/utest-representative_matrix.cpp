@@ -0,0 +1,105 @@
+/*!
+
+@authors Andrei Novikov (pyclustering@yandex.ru)
+@date 2014-2020
+@copyright BSD-3-Clause
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <pyclustering/cluster/representative_matrix.hpp>
+
+#include "samples.hpp"
+
+
+using namespace pyclustering;
+using namespace pyclustering::clst;
+
+
+static void template_find_nearest(const distance_metric<point> & p_metric) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::HEPTA);
+
+    /* every 7th point becomes representative - capacity of the storage is increased several times */
+    representative_matrix representatives(data->at(0).size(), p_metric);
+    dataset expected_representatives;
+    for (std::size_t i = 0; i < data->size(); i += 7) {
+        representatives.append(data->at(i));
+        expected_representatives.push_back(data->at(i));
+    }
+
+    ASSERT_EQ(expected_representatives.size(), representatives.size());
+
+    representative_sequence actual_representatives;
+    representatives.extract(actual_representatives);
+    ASSERT_EQ(expected_representatives, actual_representatives);
+
+    for (const auto & p : *data) {
+        std::size_t expected_index = (std::size_t) -1;
+        double expected_distance = std::numeric_limits<double>::max();
+
+        for (std::size_t i = 0; i < expected_representatives.size(); i++) {
+            const double distance = p_metric(p, expected_representatives[i]);
+            if (distance < expected_distance) {
+                expected_distance = distance;
+                expected_index = i;
+            }
+        }
+
+        double actual_distance = 0.0;
+        const std::size_t actual_index = representatives.find_nearest(p, actual_distance);
+
+        ASSERT_EQ(expected_index, actual_index);
+        ASSERT_EQ(expected_distance, actual_distance);
+    }
+}
+
+
+TEST(utest_representative_matrix, find_nearest_euclidean) {
+    template_find_nearest(distance_metric_factory<point>::euclidean());
+}
+
+TEST(utest_representative_matrix, find_nearest_euclidean_square) {
+    template_find_nearest(distance_metric_factory<point>::euclidean_square());
+}
+
+TEST(utest_representative_matrix, find_nearest_manhattan) {
+    template_find_nearest(distance_metric_factory<point>::manhattan());
+}
+
+TEST(utest_representative_matrix, find_nearest_chebyshev) {
+    template_find_nearest(distance_metric_factory<point>::chebyshev());
+}
+
+TEST(utest_representative_matrix, find_nearest_minkowski) {
+    template_find_nearest(distance_metric_factory<point>::minkowski(3.0));
+}
+
+TEST(utest_representative_matrix, find_nearest_user_defined) {
+    auto user_metric = [](const point & p1, const point & p2) { return manhattan_distance(p1, p2); };
+    template_find_nearest(distance_metric_factory<point>::user_defined(user_metric));
+}
+
+TEST(utest_representative_matrix, find_nearest_empty) {
+    representative_matrix representatives(2, distance_metric_factory<point>::euclidean());
+
+    double distance = 0.0;
+    ASSERT_EQ((std::size_t) -1, representatives.find_nearest({ 1.0, 2.0 }, distance));
+    ASSERT_TRUE(representatives.empty());
+}
+
+TEST(utest_representative_matrix, update_coordinates) {
+    representative_matrix representatives(2, distance_metric_factory<point>::euclidean());
+    for (std::size_t i = 0; i < 10; i++) {
+        representatives.append({ static_cast<double>(i), -static_cast<double>(i) });
+    }
+
+    representatives.at(3, 1) = 100.0;
+
+    point representative;
+    representatives.get(3, representative);
+
+    const point expected = { 3.0, 100.0 };
+    ASSERT_EQ(expected, representative);
+}
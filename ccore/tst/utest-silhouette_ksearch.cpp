@@ -27,14 +27,19 @@ static void template_correct_ksearch(
     const answer & p_answer, 
     const std::size_t p_kmin, 
     const std::size_t p_kmax, 
-    const silhouette_ksearch_allocator::ptr & p_allocator = std::make_shared<kmeans_allocator>())
+    const silhouette_ksearch_allocator::ptr & p_allocator = std::make_shared<kmeans_allocator>(),
+    const bool p_warm_start = false,
+    const bool p_distance_cache = false)
 {
     const std::size_t attempts = 5;
     bool testing_result = false;
 
     for (std::size_t i = 0; i < attempts; i++) {
         silhouette_ksearch_data result;
-        silhouette_ksearch(p_kmin, p_kmax, p_allocator).process(*p_data, result);
+        silhouette_ksearch instance(p_kmin, p_kmax, p_allocator);
+        instance.set_warm_start(p_warm_start);
+        instance.set_distance_cache(p_distance_cache);
+        instance.process(*p_data, result);
 
         ASSERT_LE(-1.0, result.get_score());
         ASSERT_GE(1.0, result.get_score());
@@ -197,3 +202,111 @@ TEST(utest_silhouette_ksearch, random_state_10000_kmedoids) {
     template_random_state(2, 10, std::make_shared<kmedoids_allocator>(), 10000);
 }
 #endif
+
+
+TEST(utest_silhouette_ksearch, correct_ksearch_simple01_warm_start_kmeans) {
+    template_correct_ksearch(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), answer_reader::read(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01),
+        2, 10, std::make_shared<kmeans_allocator>(), true);
+}
+
+TEST(utest_silhouette_ksearch, correct_ksearch_simple03_warm_start_kmeans) {
+    template_correct_ksearch(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), answer_reader::read(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03),
+        2, 10, std::make_shared<kmeans_allocator>(), true);
+}
+
+TEST(utest_silhouette_ksearch, correct_ksearch_simple03_warm_start_kmedians) {
+    template_correct_ksearch(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), answer_reader::read(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03),
+        2, 10, std::make_shared<kmedians_allocator>(), true);
+}
+
+TEST(utest_silhouette_ksearch, correct_ksearch_simple03_warm_start_kmedoids) {
+    template_correct_ksearch(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), answer_reader::read(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03),
+        2, 10, std::make_shared<kmedoids_allocator>(), true);
+}
+
+TEST(utest_silhouette_ksearch, correct_ksearch_simple03_distance_cache) {
+    template_correct_ksearch(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), answer_reader::read(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03),
+        2, 10, std::make_shared<kmeans_allocator>(), false, true);
+}
+
+TEST(utest_silhouette_ksearch, correct_ksearch_simple03_warm_start_distance_cache) {
+    template_correct_ksearch(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), answer_reader::read(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03),
+        2, 10, std::make_shared<kmeans_allocator>(), true, true);
+}
+
+
+static void template_distance_cache(const silhouette_ksearch_allocator::ptr & p_allocator) {
+    dataset_ptr data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_04);
+
+    silhouette_ksearch_data result_1, result_2;
+    silhouette_ksearch(2, 10, p_allocator, 1000).process(*data, result_1);
+
+    silhouette_ksearch instance(2, 10, p_allocator, 1000);
+    instance.set_distance_cache(true);
+    instance.process(*data, result_2);
+
+    ASSERT_EQ(result_1, result_2);
+}
+
+
+TEST(utest_silhouette_ksearch, distance_cache_kmeans) {
+    template_distance_cache(std::make_shared<kmeans_allocator>());
+}
+
+TEST(utest_silhouette_ksearch, distance_cache_kmedians) {
+    template_distance_cache(std::make_shared<kmedians_allocator>());
+}
+
+TEST(utest_silhouette_ksearch, distance_cache_kmedoids) {
+    template_distance_cache(std::make_shared<kmedoids_allocator>());
+}
+
+
+static void template_early_stop(const std::size_t p_patience, const bool p_warm_start) {
+    dataset_ptr data = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    silhouette_ksearch_data full_result;
+    silhouette_ksearch full_instance(2, 15, std::make_shared<kmeans_allocator>(), 1000);
+    full_instance.set_warm_start(p_warm_start);
+    full_instance.process(*data, full_result);
+
+    silhouette_ksearch_data result;
+    silhouette_ksearch instance(2, 15, std::make_shared<kmeans_allocator>(), 1000);
+    instance.set_warm_start(p_warm_start);
+    instance.set_early_stop(p_patience);
+    instance.process(*data, result);
+
+    const std::size_t index_best = result.get_amount() - 2;
+
+    ASSERT_LE(result.scores().size(), full_result.scores().size());
+    ASSERT_LE(result.scores().size(), index_best + p_patience + 1);
+
+    for (std::size_t i = 0; i < result.scores().size(); i++) {
+        ASSERT_EQ(full_result.scores()[i], result.scores()[i]);
+    }
+
+    for (std::size_t i = index_best + 1; i < result.scores().size(); i++) {
+        ASSERT_GE(result.get_score(), result.scores()[i]);
+    }
+}
+
+
+TEST(utest_silhouette_ksearch, early_stop_patience_1) {
+    template_early_stop(1, false);
+}
+
+TEST(utest_silhouette_ksearch, early_stop_patience_2) {
+    template_early_stop(2, false);
+}
+
+TEST(utest_silhouette_ksearch, early_stop_patience_3) {
+    template_early_stop(3, false);
+}
+
+TEST(utest_silhouette_ksearch, early_stop_patience_1_warm_start) {
+    template_early_stop(1, true);
+}
+
+TEST(utest_silhouette_ksearch, early_stop_patience_3_warm_start) {
+    template_early_stop(3, true);
+}
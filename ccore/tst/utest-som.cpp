@@ -14,7 +14,10 @@
 #include <pyclustering/nnet/som.hpp>
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <numeric>
+#include <thread>
 
 
 using namespace pyclustering;
@@ -67,11 +70,12 @@ static void template_award_neurons(const std::shared_ptr<dataset> & data,
                                    const unsigned int rows, 
                                    const unsigned int cols, 
                                    const som_conn_type conn_type, 
-                                   const std::vector<unsigned int> & expected_result) {
+                                   const std::vector<unsigned int> & expected_result,
+                                   const som_train_mode mode = som_train_mode::SOM_ONLINE) {
 
     som_parameters params;
     som som_map(rows, cols, conn_type, params);
-    som_map.train(*data.get(), epouchs, autostop);
+    som_map.train(*data.get(), epouchs, autostop, mode);
 
     size_t winners = som_map.get_winner_number();
     ASSERT_EQ(expected_result.size(), winners);
@@ -209,6 +213,80 @@ TEST(utest_som, awards_clusters_honeycomb_simple_sample_03) {
     template_award_neurons(sample_simple_03, 100, false, 2, 2, som_conn_type::SOM_HONEYCOMB, expected_awards);
 }
 
+TEST(utest_som, batch_awards_two_clusters_func_neighbor) {
+    std::vector<unsigned int> expected_awards = { 5, 5 };
+    std::shared_ptr<dataset> sample_simple_01 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_award_neurons(sample_simple_01, 100, false, 1, 2, som_conn_type::SOM_FUNC_NEIGHBOR, expected_awards, som_train_mode::SOM_BATCH);
+    template_award_neurons(sample_simple_01, 100, true, 2, 1, som_conn_type::SOM_FUNC_NEIGHBOR, expected_awards, som_train_mode::SOM_BATCH);
+}
+
+TEST(utest_som, batch_awards_two_clusters_grid_four) {
+    std::vector<unsigned int> expected_awards = { 5, 5 };
+    std::shared_ptr<dataset> sample_simple_01 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+    template_award_neurons(sample_simple_01, 100, false, 1, 2, som_conn_type::SOM_GRID_FOUR, expected_awards, som_train_mode::SOM_BATCH);
+    template_award_neurons(sample_simple_01, 100, true, 2, 1, som_conn_type::SOM_GRID_FOUR, expected_awards, som_train_mode::SOM_BATCH);
+}
+
+TEST(utest_som, batch_awards_clusters_grid_eight_simple_sample_02) {
+    std::vector<unsigned int> expected_awards = { 5, 8, 10 };
+    std::shared_ptr<dataset> sample_simple_02 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02);
+    template_award_neurons(sample_simple_02, 100, false, 1, 3, som_conn_type::SOM_GRID_EIGHT, expected_awards, som_train_mode::SOM_BATCH);
+    template_award_neurons(sample_simple_02, 100, false, 3, 1, som_conn_type::SOM_GRID_EIGHT, expected_awards, som_train_mode::SOM_BATCH);
+}
+
+TEST(utest_som, batch_awards_clusters_honeycomb_simple_sample_03) {
+    std::vector<unsigned int> expected_awards = { 10, 10, 10, 30 };
+    std::shared_ptr<dataset> sample_simple_03 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    template_award_neurons(sample_simple_03, 100, false, 1, 4, som_conn_type::SOM_HONEYCOMB, expected_awards, som_train_mode::SOM_BATCH);
+    template_award_neurons(sample_simple_03, 100, false, 2, 2, som_conn_type::SOM_HONEYCOMB, expected_awards, som_train_mode::SOM_BATCH);
+}
+
+TEST(utest_som, batch_awards_clusters_func_neighbor_simple_sample_03) {
+    std::vector<unsigned int> expected_awards = { 10, 10, 10, 30 };
+    std::shared_ptr<dataset> sample_simple_03 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+    template_award_neurons(sample_simple_03, 100, false, 1, 4, som_conn_type::SOM_FUNC_NEIGHBOR, expected_awards, som_train_mode::SOM_BATCH);
+    template_award_neurons(sample_simple_03, 100, false, 2, 2, som_conn_type::SOM_FUNC_NEIGHBOR, expected_awards, som_train_mode::SOM_BATCH);
+}
+
+TEST(utest_som, batch_weights_are_means_of_captured_patterns) {
+    som_parameters params;
+    std::shared_ptr<dataset> sample_simple_01 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    som som_map(1, 2, som_conn_type::SOM_GRID_FOUR, params);
+    som_map.train(*sample_simple_01.get(), 100, false, som_train_mode::SOM_BATCH);
+
+    const dataset & weights = som_map.get_weights();
+    const som_gain_sequence & captured_objects = som_map.get_capture_objects();
+
+    /* at the end of training neighbors are out of radius, so weights are means of captured patterns */
+    for (std::size_t i = 0; i < som_map.get_size(); i++) {
+        ASSERT_FALSE(captured_objects[i].empty());
+
+        for (std::size_t dim = 0; dim < weights[i].size(); dim++) {
+            double mean = 0.0;
+            for (const std::size_t index_object : captured_objects[i]) {
+                mean += sample_simple_01->at(index_object)[dim];
+            }
+
+            mean /= static_cast<double>(captured_objects[i].size());
+            ASSERT_NEAR(mean, weights[i][dim], 0.000001);
+        }
+    }
+}
+
+TEST(utest_som, big_map_func_neighbor) {
+    som_parameters params;
+    std::shared_ptr<dataset> sample_simple_01 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01);
+
+    /* neighborhood is described by grid offsets, so memory is linear to the map size */
+    som som_map(200, 200, som_conn_type::SOM_FUNC_NEIGHBOR, params);
+    som_map.train(*sample_simple_01.get(), 2, false);
+
+    const som_award_sequence & awards = som_map.get_awards();
+    ASSERT_EQ(sample_simple_01->size(), std::accumulate(awards.cbegin(), awards.cend(), (std::size_t) 0));
+    ASSERT_GE(sample_simple_01->size(), som_map.get_winner_number());
+}
+
 TEST(utest_som, double_training) {
     som_parameters params;
     som som_map(2, 2, som_conn_type::SOM_GRID_EIGHT, params);
@@ -331,6 +409,234 @@ TEST(utest_som, simulate_honeycomb_without_autostop_reload) {
 }
 
 
+static std::size_t find_winner_by_scan(const dataset & p_weights, const pattern & p_pattern) {
+    std::size_t index_winner = 0;
+    for (std::size_t i = 1; i < p_weights.size(); i++) {
+        double distance = 0.0, distance_winner = 0.0;
+        for (std::size_t dim = 0; dim < p_pattern.size(); dim++) {
+            distance += (p_weights[i][dim] - p_pattern[dim]) * (p_weights[i][dim] - p_pattern[dim]);
+            distance_winner += (p_weights[index_winner][dim] - p_pattern[dim]) * (p_weights[index_winner][dim] - p_pattern[dim]);
+        }
+
+        if (distance < distance_winner) {
+            index_winner = i;
+        }
+    }
+
+    return index_winner;
+}
+
+
+static void template_simulate_index(const som_conn_type conn_type, const bool p_reload) {
+    som_parameters params;
+    params.random_state = 1;
+    std::shared_ptr<dataset> sample_simple_03 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    som som_map(10, 10, conn_type, params);
+    som_map.train(*sample_simple_03.get(), 20, false);
+
+    if (p_reload) {
+        auto weights = som_map.get_weights();
+        som_map = som(10, 10, conn_type, params);
+        som_map.load(weights, { }, { });
+    }
+
+    dataset patterns = *sample_simple_03;
+    for (double x = -1.0; x < 7.0; x += 0.25) {
+        for (double y = -1.0; y < 7.0; y += 0.25) {
+            patterns.push_back({ x, y });
+        }
+    }
+
+    std::vector<std::size_t> winners;
+    som_map.simulate(patterns, winners);
+    ASSERT_EQ(patterns.size(), winners.size());
+
+    for (std::size_t i = 0; i < patterns.size(); i++) {
+        const std::size_t expected_winner = find_winner_by_scan(som_map.get_weights(), patterns[i]);
+        ASSERT_EQ(expected_winner, som_map.simulate(patterns[i]));
+        ASSERT_EQ(expected_winner, winners[i]);
+    }
+}
+
+TEST(utest_som, simulate_index_grid_four) {
+    template_simulate_index(som_conn_type::SOM_GRID_FOUR, false);
+}
+
+TEST(utest_som, simulate_index_func_neighbor_reload) {
+    template_simulate_index(som_conn_type::SOM_FUNC_NEIGHBOR, true);
+}
+
+TEST(utest_som, simulate_index_equal_weights) {
+    som_parameters params;
+    som som_map(8, 8, som_conn_type::SOM_GRID_EIGHT, params);
+
+    dataset weights(som_map.get_size(), { 1.0, 1.0 });
+    weights[10] = { 2.0, 2.0 };
+    weights[20] = { 2.0, 2.0 };
+    som_map.load(weights, { }, { });
+
+    ASSERT_EQ(0U, som_map.simulate({ 1.0, 1.0 }));
+    ASSERT_EQ(0U, som_map.simulate({ 0.0, 0.0 }));
+    ASSERT_EQ(10U, som_map.simulate({ 2.0, 2.0 }));
+    ASSERT_EQ(10U, som_map.simulate({ 3.0, 3.0 }));
+    ASSERT_EQ(0U, som_map.simulate({ 1.5, 1.5 }));
+}
+
+
+static void template_save_load_file(const som_conn_type conn_type, const std::size_t rows, const std::size_t cols) {
+    const std::string filename = "utest_som_network.bin";
+
+    som_parameters params;
+    params.random_state = 1;
+    std::shared_ptr<dataset> sample_simple_03 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    som som_map(rows, cols, conn_type, params);
+    som_map.train(*sample_simple_03.get(), 20, false);
+    som_map.save(filename);
+
+    som loaded_map(1, 1, som_conn_type::SOM_GRID_FOUR, params);
+    loaded_map.load(filename);
+    std::remove(filename.c_str());  /* mapping is kept after removing the file */
+
+    ASSERT_EQ(som_map.get_size(), loaded_map.get_size());
+    ASSERT_EQ(som_map.get_awards(), loaded_map.get_awards());
+    ASSERT_EQ(som_map.get_capture_objects(), loaded_map.get_capture_objects());
+    ASSERT_EQ(som_map.get_neighbors(), loaded_map.get_neighbors());
+
+    for (const auto & input_pattern : *sample_simple_03) {
+        ASSERT_EQ(som_map.simulate(input_pattern), loaded_map.simulate(input_pattern));
+    }
+
+    ASSERT_EQ(som_map.get_weights(), loaded_map.get_weights());
+
+    som copied_map = loaded_map;
+    ASSERT_EQ(som_map.get_weights(), copied_map.get_weights());
+
+    /* training replaces weights from the file */
+    copied_map.train(*sample_simple_03.get(), 20, false);
+    ASSERT_EQ(som_map.get_weights(), copied_map.get_weights());
+}
+
+TEST(utest_som, save_load_file_grid_four) {
+    template_save_load_file(som_conn_type::SOM_GRID_FOUR, 3, 3);
+}
+
+TEST(utest_som, save_load_file_func_neighbor) {
+    template_save_load_file(som_conn_type::SOM_FUNC_NEIGHBOR, 10, 10);
+}
+
+TEST(utest_som, save_load_file_simulate_mapped) {
+    const std::string filename = "utest_som_network.bin";
+
+    som_parameters params;
+    params.random_state = 1;
+    std::shared_ptr<dataset> sample_simple_03 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    som som_map(10, 10, som_conn_type::SOM_GRID_FOUR, params);     /* the map is big enough to be indexed if it is not mapped */
+
+    som_map.train(*sample_simple_03.get(), 20, false);
+    som_map.save(filename);
+
+    som loaded_map(1, 1, som_conn_type::SOM_GRID_FOUR, params);
+    loaded_map.load(filename);
+    std::remove(filename.c_str());
+
+    dataset patterns = *sample_simple_03;
+    for (double x = -1.0; x < 7.0; x += 0.25) {
+        for (double y = -1.0; y < 7.0; y += 0.25) {
+            patterns.push_back({ x, y });
+        }
+    }
+
+    /* weights of the loaded network are not requested to search winners using mapped file */
+    std::vector<std::size_t> winners;
+    loaded_map.simulate(patterns, winners);
+
+    const dataset & weights = som_map.get_weights();
+    for (std::size_t i = 0; i < patterns.size(); i++) {
+        const std::size_t expected_winner = find_winner_by_scan(weights, patterns[i]);
+        ASSERT_EQ(expected_winner, loaded_map.simulate(patterns[i]));
+        ASSERT_EQ(expected_winner, winners[i]);
+    }
+}
+
+TEST(utest_som, save_load_file_concurrent_weights) {
+    const std::string filename = "utest_som_network.bin";
+
+    som_parameters params;
+    params.random_state = 1;
+    std::shared_ptr<dataset> sample_simple_03 = simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03);
+
+    som som_map(5, 5, som_conn_type::SOM_GRID_EIGHT, params);
+    som_map.train(*sample_simple_03.get(), 10, false);
+    som_map.save(filename);
+
+    som loaded_map(1, 1, som_conn_type::SOM_GRID_FOUR, params);
+    loaded_map.load(filename);
+    std::remove(filename.c_str());
+
+    std::vector<std::thread> readers;
+    std::vector<dataset> results(4);
+    for (std::size_t i = 0; i < results.size(); i++) {
+        readers.emplace_back([&loaded_map, &results, i]() { results[i] = loaded_map.get_weights(); });
+    }
+
+    for (auto & reader : readers) {
+        reader.join();
+    }
+
+    for (const auto & weights : results) {
+        ASSERT_EQ(som_map.get_weights(), weights);
+    }
+}
+
+TEST(utest_som, save_load_file_not_trained) {
+    const std::string filename = "utest_som_network.bin";
+
+    som_parameters params;
+    som som_map(2, 3, som_conn_type::SOM_HONEYCOMB, params);
+    som_map.save(filename);
+
+    som loaded_map(1, 1, som_conn_type::SOM_GRID_FOUR, params);
+    loaded_map.load(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(6U, loaded_map.get_size());
+    ASSERT_TRUE(loaded_map.get_weights().empty());
+    ASSERT_EQ(som_map.get_neighbors(), loaded_map.get_neighbors());
+}
+
+TEST(utest_som, load_file_corrupted) {
+    const std::string filename = "utest_som_network.bin";
+
+    som_parameters params;
+    som som_map(2, 2, som_conn_type::SOM_GRID_EIGHT, params);
+    som_map.train({ { 1.0, 1.0 }, { 2.0, 2.0 }, { 3.0, 3.0 } }, 10, false);
+    som_map.save(filename);
+
+    std::ifstream input(filename, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+
+    som loaded_map(1, 1, som_conn_type::SOM_GRID_FOUR, params);
+
+    std::ofstream(filename, std::ios::binary | std::ios::trunc) << content.substr(0, content.size() - 1);
+    ASSERT_THROW(loaded_map.load(filename), std::invalid_argument);
+
+    std::ofstream(filename, std::ios::binary | std::ios::trunc) << "SOMA" << content.substr(4);
+    ASSERT_THROW(loaded_map.load(filename), std::invalid_argument);
+
+    std::ofstream(filename, std::ios::binary | std::ios::trunc) << content.substr(0, 20);
+    ASSERT_THROW(loaded_map.load(filename), std::invalid_argument);
+
+    std::remove(filename.c_str());
+    ASSERT_THROW(loaded_map.load(filename), std::invalid_argument);
+
+    ASSERT_EQ(1U, loaded_map.get_size());
+}
+
+
 static void template_random_state(const std::size_t rows, const std::size_t cols, const som_conn_type conn_type, const std::size_t random_state, const bool autostop) {
     som_parameters params;
     params.random_state = random_state;
@@ -75,6 +75,38 @@ TEST(utest_stats, anderson) {
 }
 
 
+TEST(utest_stats, quantiles_all) {
+    std::vector<double> data = { 5.0, 1.0, 4.0, 2.0, 3.0 };
+    std::vector<double> result = quantiles(data, 10);
+
+    std::vector<double> expected = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    ASSERT_EQ(expected, result);
+}
+
+
+TEST(utest_stats, quantiles_sketch) {
+    std::vector<double> data(1000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<double>((i * 7919) % data.size());
+    }
+
+    std::vector<double> result = quantiles(data, 10);
+
+    std::vector<double> expected = { 50.0, 150.0, 250.0, 350.0, 450.0, 550.0, 650.0, 750.0, 850.0, 950.0 };
+    ASSERT_EQ(expected, result);
+}
+
+
+TEST(utest_stats, quantiles_sketch_anderson) {
+    std::vector<double> data = { 1.20051687, -0.11498334, -0.06660842, 0.65981179, -0.8188606, -1.48766638, -0.76268192, 0.89156879, 0.5011937, 0.85737694 };
+    std::vector<double> sketch = quantiles(data, data.size() - 1);
+
+    ASSERT_EQ(data.size() - 1, sketch.size());
+    ASSERT_TRUE(std::is_sorted(sketch.begin(), sketch.end()));
+    ASSERT_GT(1.0, anderson(sketch));
+}
+
+
 TEST(utest_stats, critical_values) {
     std::vector<double> expected = { 0.50086957, 0.57043478, 0.68434783, 0.79826087, 0.94956522 };
     std::vector<double> actual = critical_values(10);
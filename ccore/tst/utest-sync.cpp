@@ -12,6 +12,8 @@
 #include <pyclustering/nnet/sync.hpp>
 
 #include <cmath>
+#include <cstdio>
+#include <functional>
 
 
 using namespace pyclustering::nnet;
@@ -149,6 +151,73 @@ TEST(utest_sync, dynamic_simulation_runge_kutta_fehlberg_45) {
 }
 
 
+/* Network that integrates each oscillator separately by the generic solver. */
+class sync_network_generic_solver : public sync_network {
+public:
+    sync_network_generic_solver(const std::size_t p_size, const connection_t p_type) :
+        sync_network(p_size, 1.0, 0.0, p_type, initial_type::EQUIPARTITION)
+    {
+        set_equation(std::bind(&sync_network_generic_solver::phase_kuramoto_equation, this,
+            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+    }
+};
+
+
+static void template_network_integrator(const std::size_t p_size, const connection_t p_type, const solve_type p_solver = solve_type::RUNGE_KUTTA_4) {
+    sync_network network(p_size, 1.0, 0.0, p_type, initial_type::EQUIPARTITION);
+    sync_network_generic_solver network_generic(p_size, p_type);
+
+    sync_dynamic output_dynamic, output_dynamic_generic;
+    network.simulate_static(20, 2.0, p_solver, true, output_dynamic);
+    network_generic.simulate_static(20, 2.0, p_solver, true, output_dynamic_generic);
+
+    ASSERT_EQ(output_dynamic_generic.size(), output_dynamic.size());
+    for (std::size_t i = 0; i < output_dynamic.size(); i++) {
+        if (p_type == connection_t::CONNECTION_ALL_TO_ALL) {
+            /* mean field is used instead of sum over neighbors, so the result is the same up to rounding errors */
+            for (std::size_t j = 0; j < p_size; j++) {
+                ASSERT_NEAR(output_dynamic_generic[i].m_phase[j], output_dynamic[i].m_phase[j], 1e-9);
+            }
+        }
+        else {
+            ASSERT_EQ(output_dynamic_generic[i].m_phase, output_dynamic[i].m_phase);
+        }
+    }
+}
+
+TEST(utest_sync, network_integrator_all_to_all) {
+    template_network_integrator(20, connection_t::CONNECTION_ALL_TO_ALL);
+}
+
+TEST(utest_sync, network_integrator_all_to_all_parallel) {
+    template_network_integrator(200, connection_t::CONNECTION_ALL_TO_ALL);
+}
+
+TEST(utest_sync, mean_field_all_to_all_euler) {
+    template_network_integrator(50, connection_t::CONNECTION_ALL_TO_ALL, solve_type::FORWARD_EULER);
+}
+
+TEST(utest_sync, mean_field_all_to_all_rkf45) {
+    template_network_integrator(30, connection_t::CONNECTION_ALL_TO_ALL, solve_type::RUNGE_KUTTA_FEHLBERG_45);
+}
+
+TEST(utest_sync, network_integrator_grid_four) {
+    template_network_integrator(25, connection_t::CONNECTION_GRID_FOUR);
+}
+
+TEST(utest_sync, network_integrator_grid_eight_parallel) {
+    template_network_integrator(100, connection_t::CONNECTION_GRID_EIGHT);
+}
+
+TEST(utest_sync, network_integrator_list_bidir) {
+    template_network_integrator(10, connection_t::CONNECTION_LIST_BIDIRECTIONAL);
+}
+
+TEST(utest_sync, network_integrator_none) {
+    template_network_integrator(10, connection_t::CONNECTION_NONE);
+}
+
+
 static void template_static_collecting_dynamic(const unsigned int steps) {
     sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
 
@@ -263,6 +332,40 @@ TEST(utest_sync, sync_ordering_50_steps) {
 }
 
 
+static void template_local_order_all_to_all(const std::vector<double> & p_phases) {
+    double expected = 0.0;
+    for (std::size_t i = 0; i < p_phases.size(); i++) {
+        for (std::size_t j = 0; j < p_phases.size(); j++) {
+            if (i != j) {
+                expected += std::exp(-std::abs(p_phases[j] - p_phases[i]));
+            }
+        }
+    }
+
+    const double number_neighbors = static_cast<double>(p_phases.size() * (p_phases.size() - 1));
+    if (number_neighbors > 0.0) {
+        expected /= number_neighbors;
+    }
+
+    sync_network network(p_phases.size(), 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+
+    ASSERT_NEAR(expected, sync_ordering::calculate_local_sync_order_all_to_all(p_phases), 1e-12);
+    ASSERT_NEAR(expected, sync_ordering::calculate_local_sync_order(network.connections(), p_phases), 1e-12);
+}
+
+TEST(utest_sync, local_order_all_to_all) {
+    template_local_order_all_to_all({ 0.1, 5.9, 3.0, 3.0, 1.2, 0.0, 6.2, 4.4 });
+}
+
+TEST(utest_sync, local_order_all_to_all_synchronous) {
+    template_local_order_all_to_all({ 2.0, 2.0, 2.0, 2.0 });
+}
+
+TEST(utest_sync, local_order_all_to_all_one_oscillator) {
+    template_local_order_all_to_all({ 1.0 });
+}
+
+
 static void template_sync_order_sequence(
         const std::size_t p_size,
         const std::size_t p_steps,
@@ -348,3 +451,121 @@ TEST(utest_sync, sync_sequence_ordering_one_front) {
 TEST(utest_sync, sync_sequence_ordering_one_middle) {
     template_sync_order_sequence(10, 20, 5.0, 5, 6, false);
 }
+
+
+TEST(utest_sync, dynamic_sink) {
+    const std::string filename = "utest_sync_dynamic.bin";
+
+    sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic expected_dynamic;
+    network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, true, expected_dynamic);
+
+    sync_network sink_network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic output_dynamic;
+    output_dynamic.set_sink(std::make_shared<dynamic_file_sink>(filename, dynamic_compression::DELTA, 8));
+    sink_network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, true, output_dynamic);
+    output_dynamic.get_sink()->close();
+
+    ASSERT_EQ(1U, output_dynamic.size());   /* only the last state is kept in memory */
+    ASSERT_EQ(expected_dynamic.back().m_time, output_dynamic.back().m_time);
+
+    {
+        dynamic_file_reader reader(filename);
+        ASSERT_EQ(expected_dynamic.size(), reader.size());
+
+        std::vector<double> time;
+        std::vector<std::vector<double>> phases;
+        reader.read("phase", 0.0, 3.0, 0, 10, time, phases);
+
+        ASSERT_EQ(expected_dynamic.size(), phases.size());
+        for (std::size_t step = 0; step < expected_dynamic.size(); step++) {
+            ASSERT_EQ(static_cast<float>(expected_dynamic[step].m_time), static_cast<float>(time[step]));
+            for (std::size_t index = 0; index < 10; index++) {
+                ASSERT_EQ(static_cast<float>(expected_dynamic[step].m_phase[index]), phases[step][index]);
+            }
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_sync, dynamic_sink_last_policy) {
+    const std::string filename = "utest_sync_dynamic_last.bin";
+
+    sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic output_dynamic;
+    output_dynamic.set_sink(std::make_shared<dynamic_file_sink>(filename));
+
+    ASSERT_THROW(network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, collection_policy::last(), output_dynamic), std::invalid_argument);
+    ASSERT_THROW(network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, false, output_dynamic), std::invalid_argument);
+    ASSERT_THROW(network.simulate_dynamic(0.998, 0.1, solve_type::FORWARD_EULER, collection_policy::last(), output_dynamic), std::invalid_argument);
+
+    output_dynamic.get_sink()->close();
+    std::remove(filename.c_str());
+}
+
+
+TEST(utest_sync, collection_policy_every) {
+    sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic expected_dynamic;
+    network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, true, expected_dynamic);
+
+    sync_network policy_network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic output_dynamic;
+    policy_network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, collection_policy::every(5), output_dynamic);
+
+    ASSERT_EQ((expected_dynamic.size() + 4) / 5, output_dynamic.size());
+    for (std::size_t index = 0; index < output_dynamic.size(); index++) {
+        ASSERT_EQ(expected_dynamic[index * 5].m_time, output_dynamic[index].m_time);
+        ASSERT_EQ(expected_dynamic[index * 5].m_phase, output_dynamic[index].m_phase);
+    }
+}
+
+
+TEST(utest_sync, collection_policy_window) {
+    sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic expected_dynamic;
+    network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, true, expected_dynamic);
+
+    sync_network policy_network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic output_dynamic;
+    policy_network.simulate_static(20, 2.0, solve_type::FORWARD_EULER, collection_policy::window(7), output_dynamic);
+
+    ASSERT_EQ(7U, output_dynamic.size());
+
+    const std::size_t offset = expected_dynamic.size() - output_dynamic.size();
+    for (std::size_t index = 0; index < output_dynamic.size(); index++) {
+        ASSERT_EQ(expected_dynamic[offset + index].m_time, output_dynamic[index].m_time);
+        ASSERT_EQ(expected_dynamic[offset + index].m_phase, output_dynamic[index].m_phase);
+    }
+}
+
+
+TEST(utest_sync, collection_policy_sync_order_reduction) {
+    sync_network network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic expected_dynamic;
+    network.simulate_dynamic(0.998, 0.1, solve_type::RUNGE_KUTTA_4, true, expected_dynamic);
+
+    auto order = std::make_shared<sync_order_reduction>();
+
+    sync_network policy_network(10, 1, 0, connection_t::CONNECTION_ALL_TO_ALL, initial_type::EQUIPARTITION);
+    sync_dynamic output_dynamic;
+    policy_network.simulate_dynamic(0.998, 0.1, solve_type::RUNGE_KUTTA_4, collection_policy::last().add_reduction(order), output_dynamic);
+
+    ASSERT_EQ(1U, output_dynamic.size());
+    ASSERT_EQ(expected_dynamic.back().m_phase, output_dynamic.back().m_phase);
+
+    ASSERT_EQ(expected_dynamic.size(), order->get_order().size());
+    ASSERT_EQ(expected_dynamic.size(), order->get_time().size());
+    for (std::size_t index = 0; index < expected_dynamic.size(); index++) {
+        ASSERT_EQ(expected_dynamic[index].m_time, order->get_time()[index]);
+        ASSERT_DOUBLE_EQ(sync_ordering::calculate_sync_order(expected_dynamic[index].m_phase), order->get_order()[index]);
+    }
+}
+
+
+TEST(utest_sync, collection_policy_invalid_parameter) {
+    ASSERT_THROW(collection_policy::every(0), std::invalid_argument);
+    ASSERT_THROW(collection_policy::window(0), std::invalid_argument);
+}
@@ -13,6 +13,11 @@
 
 #include <pyclustering/cluster/syncnet.hpp>
 
+#include <pyclustering/utils/metric.hpp>
+
+
+using namespace pyclustering::utils::metric;
+
 
 using namespace pyclustering::clst;
 
@@ -42,6 +47,35 @@ TEST(utest_syncnet, create_delete_network_100) {
     template_create_delete(100);
 }
 
+static void template_connections(const std::shared_ptr<dataset> & p_sample, const double p_radius) {
+    syncnet network(p_sample.get(), p_radius, false, initial_type::EQUIPARTITION);
+
+    std::shared_ptr<adjacency_collection> connections = network.connections();
+    for (std::size_t i = 0; i < p_sample->size(); i++) {
+        for (std::size_t j = 0; j < p_sample->size(); j++) {
+            const bool expected = (i != j) && (euclidean_distance_square(p_sample->at(i), p_sample->at(j)) <= p_radius * p_radius);
+            ASSERT_EQ(expected, connections->has_connection(i, j));
+        }
+    }
+}
+
+TEST(utest_syncnet, connections_sample_simple_01) {
+    template_connections(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 0.5);
+}
+
+TEST(utest_syncnet, connections_sample_simple_03) {
+    template_connections(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 0.7);
+}
+
+TEST(utest_syncnet, connections_sample_simple_07) {
+    template_connections(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_07), 1.0);
+}
+
+TEST(utest_syncnet, connections_all_to_all) {
+    template_connections(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 100.0);
+}
+
+
 TEST(utest_syncnet, one_cluster) {
     bool result_testing = false;
 
@@ -16,6 +16,8 @@
 
 #include "utenv_check.hpp"
 
+#include <numeric>
+
 
 using namespace pyclustering;
 using namespace pyclustering::clst;
@@ -26,10 +28,12 @@ template_ttsas_length_process_data(const dataset_ptr p_data,
         const double & p_threshold1,
         const double & p_threshold2,
         const std::vector<size_t> & p_expected_cluster_length,
-        const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean()) {
+        const distance_metric<point> & p_metric = distance_metric_factory<point>::euclidean(),
+        const bool p_parallel_classification = false) {
 
     ttsas_data output_result;
     ttsas solver(p_threshold1, p_threshold2, p_metric);
+    solver.set_parallel_classification(p_parallel_classification);
     solver.process(*p_data, output_result);
 
     const dataset & data = *p_data;
@@ -146,4 +150,44 @@ TEST(utest_ttsas, allocation_three_dimension_points_2) {
 TEST(utest_ttsas, allocation_three_allocation_one_dimension_points_2) {
     const std::vector<size_t> expected_clusters_length = { 20 };
     template_ttsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_11), 10.0, 20.0, expected_clusters_length);
-}
\ No newline at end of file
+}
+
+
+TEST(utest_ttsas, parallel_classification_sample_simple_01) {
+    const std::vector<size_t> expected_clusters_length = { 5, 5 };
+    template_ttsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_01), 1.0, 2.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
+
+
+TEST(utest_ttsas, parallel_classification_sample_simple_02) {
+    const std::vector<size_t> expected_clusters_length = { 5, 8, 10 };
+    template_ttsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_02), 1.0, 2.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
+
+
+TEST(utest_ttsas, parallel_classification_sample_simple_03) {
+    const std::vector<size_t> expected_clusters_length = { 10, 10, 10, 30 };
+    template_ttsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_03), 1.0, 2.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
+
+
+TEST(utest_ttsas, parallel_classification_one_cluster) {
+    const std::vector<size_t> expected_clusters_length = { 20 };
+    template_ttsas_length_process_data(simple_sample_factory::create_sample(SAMPLE_SIMPLE::SAMPLE_SIMPLE_07), 10.0, 20.0, expected_clusters_length, distance_metric_factory<point>::euclidean(), true);
+}
+
+
+TEST(utest_ttsas, parallel_classification_is_reproducible) {
+    auto data = fcps_sample_factory::create_sample(FCPS_SAMPLE::LSUN);
+
+    ttsas_data first_result, second_result;
+
+    ttsas solver(0.5, 1.0);
+    solver.set_parallel_classification(true);
+    solver.process(*data, first_result);
+    solver.process(*data, second_result);
+
+    ASSERT_EQ(first_result.clusters(), second_result.clusters());
+    ASSERT_EQ(data->size(), std::accumulate(first_result.clusters().begin(), first_result.clusters().end(), std::size_t(0),
+        [](const std::size_t p_total, const cluster & p_cluster) { return p_total + p_cluster.size(); }));
+}
@@ -8,7 +8,7 @@
 
 """
 
-from ctypes import Structure, c_longlong, c_uint, c_size_t, c_double, c_void_p, pointer, POINTER
+from ctypes import Structure, c_bool, c_char_p, c_longlong, c_uint, c_size_t, c_double, c_void_p, pointer, POINTER
 
 from pyclustering.core.wrapper import ccore_library
 from pyclustering.core.pyclustering_package import pyclustering_package, package_builder, package_extractor
@@ -103,13 +103,47 @@ def som_destroy(som_pointer):
     ccore.som_destroy(som_pointer)
 
 
-def som_train(som_pointer, data, epochs, autostop):
+def som_save(som_pointer, filename):
+    """!
+    @brief Stores self-organized map (parameters, weights, awards and captured objects) to binary file.
+    
+    @param[in] som_pointer (c_pointer): pointer to object of self-organized map.
+    @param[in] filename (string): path to the file where the network should be stored.
+    
+    @return (bool) True if the network is stored.
+    
+    """
+    
+    ccore = ccore_library.get()
+    ccore.som_save.restype = c_bool
+    return ccore.som_save(som_pointer, c_char_p(filename.encode('utf-8')))
+
+
+def som_load_file(filename):
+    """!
+    @brief Creates self-organized map from binary file that has been created by 'som_save'.
+    @details The file is mapped to memory, so processes that load the same file share one read-only weight matrix.
+    
+    @param[in] filename (string): path to the file with the network.
+    
+    @return (POINTER) Pointer to object of self-organized map or None if the file cannot be loaded.
+    
+    """
+    
+    ccore = ccore_library.get()
+    ccore.som_load_file.restype = POINTER(c_void_p)
+    pointer = ccore.som_load_file(c_char_p(filename.encode('utf-8')))
+    return pointer if pointer else None
+
+
+def som_train(som_pointer, data, epochs, autostop, mode=0):
     """!
     @brief Trains self-organized feature map (SOM) using CCORE pyclustering library.
 
     @param[in] data (list): Input data - list of points where each point is represented by list of features, for example coordinates.
     @param[in] epochs (uint): Number of epochs for training.        
     @param[in] autostop (bool): Automatic termination of learining process when adaptation is not occurred.
+    @param[in] mode (uint): Training mode: `0` - online, `1` - batch.
     
     @return (uint) Number of learining iterations.
     
@@ -118,8 +152,8 @@ def som_train(som_pointer, data, epochs, autostop):
     pointer_data = package_builder(data, c_double).create()
     
     ccore = ccore_library.get()
-    ccore.som_train.restype = c_size_t
-    return ccore.som_train(som_pointer, pointer_data, c_uint(epochs), autostop)
+    ccore.som_train_with_mode.restype = c_size_t
+    return ccore.som_train_with_mode(som_pointer, pointer_data, c_uint(epochs), autostop, c_size_t(mode))
 
 
 def som_simulate(som_pointer, pattern):
@@ -141,6 +175,28 @@ def som_simulate(som_pointer, pattern):
     return ccore.som_simulate(som_pointer, pointer_data)
 
 
+def som_simulate_batch(som_pointer, patterns):
+    """!
+    @brief Processes input patterns (no learining) and returns indexes of neurons-winners.
+    
+    @param[in] som_pointer (c_pointer): pointer to object of self-organized map.
+    @param[in] patterns (list): input patterns.
+    
+    @return Returns list of indexes of neurons-winners for each input pattern.
+    
+    """
+    
+    pointer_data = package_builder(patterns, c_double).create()
+    
+    ccore = ccore_library.get()
+    ccore.som_simulate_batch.restype = POINTER(pyclustering_package)
+    package = ccore.som_simulate_batch(som_pointer, pointer_data)
+    
+    result = package_extractor(package).extract()
+    ccore.free_pyclustering_package(package)
+    return result
+
+
 def som_get_winner_number(som_pointer):
     """!
     @brief Returns of number of winner at the last step of learning process.